@@ -29,6 +29,7 @@ DUK_LOCAL const duk_uint8_t *duk__load_string_raw(duk_hthread *thr, const duk_ui
 
 	len = DUK_RAW_READINC_U32_BE(p);
 	duk_push_lstring(thr, (const char *) p, len);
+	(void) duk_to_interned_hstring(thr, -1);  /* constants and varmap keys */
 	p += len;
 	return p;
 }
@@ -405,6 +406,9 @@ static const duk_uint8_t *duk__load_func(duk_hthread *thr, const duk_uint8_t *p,
 	data_size = sizeof(duk_tval) * count_const +
 	            sizeof(duk_hobject *) * count_funcs +
 	            sizeof(duk_instr_t) * count_instr;
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+	data_size += DUK_HCOMPFUNC_ICACHE_SIZE(count_instr);
+#endif
 
 	DUK_DD(DUK_DDPRINT("instr=%ld, const=%ld, funcs=%ld, data_size=%ld",
 	                   (long) count_instr, (long) count_const,
@@ -554,6 +558,11 @@ static const duk_uint8_t *duk__load_func(duk_hthread *thr, const duk_uint8_t *p,
 	}
 
 	DUK_HCOMPFUNC_SET_BYTECODE(thr->heap, h_fun, (duk_instr_t *) (void *) q);
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+	q += sizeof(duk_instr_t) * count_instr;
+	DUK_HCOMPFUNC_SET_ICACHE(thr->heap, h_fun, q);
+	duk_memset((void *) q, (int) DUK_HCOMPFUNC_ICACHE_NONE, DUK_HCOMPFUNC_ICACHE_SIZE(count_instr));
+#endif
 
 	/* The function object is now reachable and refcounts are fine,
 	 * so we can pop off all the temporaries.
@@ -1029,6 +1029,9 @@ DUK_EXTERNAL void duk_set_finalizer(duk_hthread *thr, duk_idx_t idx) {
 	 */
 	if (callable) {
 		DUK_HOBJECT_SET_HAVE_FINALIZER(h);
+#if defined(DUK_USE_ALLOC_ARENA)
+		thr->heap->arena.have_finalizers = 1;
+#endif
 	} else {
 		DUK_HOBJECT_CLEAR_HAVE_FINALIZER(h);
 	}
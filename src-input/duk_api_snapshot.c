@@ -0,0 +1,1423 @@
+/*
+ *  Heap dump/load
+ *
+ *  duk_dump_heap() serializes everything reachable from the built-in
+ *  objects, the heap stash object and the heap thread into a heap image.
+ *  duk_load_heap() restores the image into a freshly created heap so that
+ *  an application can skip compiling and initializing its scripts for every
+ *  new heap.
+ *
+ *  The image is a relocatable record stream: each string, object, buffer
+ *  and function data area gets an index, and all references are index
+ *  based.  Loading interns the strings, allocates empty shells for all
+ *  objects and buffers, and then fills in properties and internal fields.
+ *  The built-in objects, the heap stash object and the heap thread already
+ *  exist in the target heap; their properties are replaced.
+ *
+ *  Native function pointers, lightfuncs, pointer values, ROM object
+ *  pointers and bytecode are stored as is, so an image must be loaded by
+ *  the same binary (same build, same config) that dumped it.  Like bytecode
+ *  load, heap load is not memory safe for invalid input - caller beware!
+ *
+ *  Threads other than the heap thread, open declarative environments
+ *  (functions still running) and external buffers cannot be dumped.
+ */
+
+#include "duk_internal.h"
+
+#if defined(DUK_USE_HEAP_DUMP_SUPPORT)
+
+#define DUK__SNAP_MARKER              0xbe
+
+/* Item kinds.  Items are objects, buffers, and compiled function data
+ * areas (which are fixed buffers containing tvals and object pointers).
+ */
+#define DUK__SNAP_KIND_OBJECT         0   /* object created on load */
+#define DUK__SNAP_KIND_BUILTIN        1   /* thr->builtins[] entry, patched on load */
+#define DUK__SNAP_KIND_HEAP_OBJECT    2   /* heap->heap_object, patched on load */
+#define DUK__SNAP_KIND_HEAP_THREAD    3   /* heap->heap_thread, patched on load */
+#define DUK__SNAP_KIND_ROMOBJ         4   /* ROM object, raw pointer */
+#define DUK__SNAP_KIND_BUFFER         5   /* plain buffer */
+#define DUK__SNAP_KIND_FUNCDATA       6   /* duk_hcompfunc 'data' buffer */
+
+/* Value tags. */
+#define DUK__SNAP_TAG_UNDEFINED       0
+#define DUK__SNAP_TAG_NULL            1
+#define DUK__SNAP_TAG_FALSE           2
+#define DUK__SNAP_TAG_TRUE            3
+#define DUK__SNAP_TAG_NUMBER          4
+#define DUK__SNAP_TAG_STRING          5
+#define DUK__SNAP_TAG_OBJECT          6
+#define DUK__SNAP_TAG_BUFFER          7
+#define DUK__SNAP_TAG_POINTER         8
+#define DUK__SNAP_TAG_LIGHTFUNC       9
+#define DUK__SNAP_TAG_UNUSED          10  /* array part gap */
+
+#define DUK__SNAP_MAP_MIN_SIZE        1024
+#define DUK__SNAP_INITIAL_ALLOC       4096
+
+/* Object flags stored in the image: heap flags (GC state, read-only)
+ * belong to the heap the object lives in.
+ */
+#define DUK__SNAP_USER_FLAGS_MASK     ((duk_uint32_t) ~((1UL << DUK_HEAPHDR_FLAGS_USER_START) - 1UL))
+
+/* Object flags which only affect property lookups.  They're kept off while
+ * properties are being restored so that the restore sees the raw property
+ * table.
+ */
+#define DUK__SNAP_LOOKUP_FLAGS        (DUK_HOBJECT_FLAG_EXOTIC_STRINGOBJ | DUK_HOBJECT_FLAG_EXOTIC_ARGUMENTS)
+
+#define DUK__SNAP_COMPFUNC_DATA_SIZE(nconst,nfunc,ninstr) \
+	((duk_size_t) (nconst) * sizeof(duk_tval) + \
+	 (duk_size_t) (nfunc) * sizeof(duk_hobject *) + \
+	 (duk_size_t) (ninstr) * sizeof(duk_instr_t) + \
+	 DUK__SNAP_ICACHE_SIZE((ninstr)))
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+#define DUK__SNAP_ICACHE_SIZE(ninstr)  DUK_HCOMPFUNC_ICACHE_SIZE((ninstr))
+#else
+#define DUK__SNAP_ICACHE_SIZE(ninstr)  0
+#endif
+
+/*
+ *  Dump
+ */
+
+typedef struct {
+	void *ptr;           /* object or buffer; for FUNCDATA the duk_hcompfunc */
+	duk_small_uint_t kind;
+} duk__snap_item;
+
+typedef struct {
+	void *ptr;           /* NULL = free slot */
+	duk_uint32_t id;     /* string or item index */
+} duk__snap_mapent;
+
+typedef struct {
+	duk_hthread *thr;
+
+	/* Pointer to index map, open addressing in a fixed buffer. */
+	duk_idx_t idx_map;
+	duk__snap_mapent *map;
+	duk_uint32_t map_size;  /* power of two */
+	duk_uint32_t map_used;
+
+	duk_uint32_t nstrings;
+	duk_uint32_t nitems;
+
+	duk_bufwriter_ctx bw_items;  /* duk__snap_item[nitems] */
+	duk_bufwriter_ctx bw_str;    /* string records */
+	duk_bufwriter_ctx bw_hdr;    /* item headers */
+	duk_bufwriter_ctx bw_body;   /* item bodies */
+} duk__snap_dump_ctx;
+
+DUK_LOCAL duk_uint32_t duk__snap_hash_ptr(void *ptr) {
+	duk_uintptr_t v;
+
+	v = (duk_uintptr_t) ptr;
+	return ((duk_uint32_t) (v >> 3) ^ (duk_uint32_t) (v >> 19)) * 0x9e3779b1UL;
+}
+
+DUK_LOCAL duk__snap_mapent *duk__snap_map_lookup(duk__snap_mapent *map, duk_uint32_t map_size, void *ptr) {
+	duk_uint32_t mask;
+	duk_uint32_t i;
+
+	mask = map_size - 1U;
+	i = duk__snap_hash_ptr(ptr) & mask;
+	for (;;) {
+		if (map[i].ptr == ptr || map[i].ptr == NULL) {
+			return map + i;
+		}
+		i = (i + 1U) & mask;
+	}
+}
+
+DUK_LOCAL void duk__snap_map_init(duk__snap_dump_ctx *ctx, duk_uint32_t map_size) {
+	duk_hthread *thr = ctx->thr;
+	duk__snap_mapent *new_map;
+	duk_uint32_t i;
+
+	DUK_ASSERT((map_size & (map_size - 1U)) == 0U);
+
+	new_map = (duk__snap_mapent *) duk_push_fixed_buffer_zero(thr, (duk_size_t) map_size * sizeof(duk__snap_mapent));
+	if (ctx->map != NULL) {
+		for (i = 0; i < ctx->map_size; i++) {
+			if (ctx->map[i].ptr != NULL) {
+				*duk__snap_map_lookup(new_map, map_size, ctx->map[i].ptr) = ctx->map[i];
+			}
+		}
+		duk_replace(thr, ctx->idx_map);
+	} else {
+		ctx->idx_map = duk_get_top_index(thr);
+	}
+	ctx->map = new_map;
+	ctx->map_size = map_size;
+}
+
+/* Find the map slot for 'ptr': either the existing entry or a free slot
+ * which the caller must fill in.
+ */
+DUK_LOCAL duk__snap_mapent *duk__snap_map_find(duk__snap_dump_ctx *ctx, void *ptr) {
+	duk__snap_mapent *ent;
+
+	ent = duk__snap_map_lookup(ctx->map, ctx->map_size, ptr);
+	if (ent->ptr == NULL && ctx->map_used >= ctx->map_size / 2U) {
+		if (ctx->map_size >= 0x40000000UL) {
+			DUK_ERROR_RANGE(ctx->thr, DUK_STR_BUFFER_TOO_LONG);
+			DUK_WO_NORETURN(return NULL;);
+		}
+		duk__snap_map_init(ctx, ctx->map_size * 2U);
+		ent = duk__snap_map_lookup(ctx->map, ctx->map_size, ptr);
+	}
+	return ent;
+}
+
+DUK_LOCAL void duk__snap_write_u8(duk_hthread *thr, duk_bufwriter_ctx *bw, duk_uint8_t val) {
+	DUK_BW_WRITE_ENSURE_U8(thr, bw, val);
+}
+
+DUK_LOCAL void duk__snap_write_u16(duk_hthread *thr, duk_bufwriter_ctx *bw, duk_uint16_t val) {
+	duk_uint8_t *p;
+
+	p = DUK_BW_ENSURE_GETPTR(thr, bw, 2);
+	DUK_RAW_WRITEINC_U16_BE(p, val);
+	DUK_BW_SET_PTR(thr, bw, p);
+}
+
+DUK_LOCAL void duk__snap_write_u32(duk_hthread *thr, duk_bufwriter_ctx *bw, duk_uint32_t val) {
+	duk_uint8_t *p;
+
+	p = DUK_BW_ENSURE_GETPTR(thr, bw, 4);
+	DUK_RAW_WRITEINC_U32_BE(p, val);
+	DUK_BW_SET_PTR(thr, bw, p);
+}
+
+DUK_LOCAL void duk__snap_write_double(duk_hthread *thr, duk_bufwriter_ctx *bw, duk_double_t val) {
+	duk_uint8_t *p;
+
+	p = DUK_BW_ENSURE_GETPTR(thr, bw, 8);
+	DUK_RAW_WRITEINC_DOUBLE_BE(p, val);
+	DUK_BW_SET_PTR(thr, bw, p);
+}
+
+DUK_LOCAL duk_uint32_t duk__snap_string_id(duk__snap_dump_ctx *ctx, duk_hstring *h) {
+	duk_hthread *thr = ctx->thr;
+	duk__snap_mapent *ent;
+	duk_size_t len;
+
+	DUK_ASSERT(h != NULL);
+
+	ent = duk__snap_map_find(ctx, (void *) h);
+	if (ent->ptr != NULL) {
+		return ent->id;
+	}
+	ent->ptr = (void *) h;
+	ent->id = ctx->nstrings++;
+	ctx->map_used++;
+
+	len = DUK_HSTRING_GET_BYTELEN(h);
+	DUK_ASSERT(len <= 0xffffffffUL);  /* string limits */
+	duk__snap_write_u32(thr, &ctx->bw_str, (duk_uint32_t) len);
+	DUK_BW_WRITE_ENSURE_BYTES(thr, &ctx->bw_str, DUK_HSTRING_GET_DATA(h), len);
+	return ent->id;
+}
+
+DUK_LOCAL duk_uint32_t duk__snap_add_item(duk__snap_dump_ctx *ctx, duk__snap_mapent *ent, void *key, void *ptr, duk_small_uint_t kind) {
+	duk__snap_item item;
+
+	item.ptr = ptr;
+	item.kind = kind;
+	DUK_BW_WRITE_ENSURE_BYTES(ctx->thr, &ctx->bw_items, (const void *) &item, sizeof(item));
+
+	ent->ptr = key;
+	ent->id = ctx->nitems++;
+	ctx->map_used++;
+
+	duk__snap_write_u8(ctx->thr, &ctx->bw_hdr, (duk_uint8_t) kind);
+	return ent->id;
+}
+
+DUK_LOCAL duk_small_uint_t duk__snap_get_kind(duk__snap_dump_ctx *ctx, duk_uint32_t id) {
+	DUK_ASSERT(id < ctx->nitems);
+	return ((duk__snap_item *) (void *) DUK_BW_GET_BASEPTR(ctx->thr, &ctx->bw_items))[id].kind;
+}
+
+DUK_LOCAL duk_uint32_t duk__snap_item_id(duk__snap_dump_ctx *ctx, duk_heaphdr *h) {
+	duk_hthread *thr = ctx->thr;
+	duk__snap_mapent *ent;
+	duk_uint32_t id;
+
+	DUK_ASSERT(h != NULL);
+	DUK_ASSERT(DUK_HEAPHDR_GET_TYPE(h) != DUK_HTYPE_STRING);
+
+	ent = duk__snap_map_find(ctx, (void *) h);
+	if (ent->ptr != NULL) {
+		return ent->id;
+	}
+
+	if (DUK_HEAPHDR_IS_OBJECT(h)) {
+		duk_hobject *obj = (duk_hobject *) h;
+
+		if (DUK_HEAPHDR_HAS_READONLY(h)) {
+			id = duk__snap_add_item(ctx, ent, (void *) h, (void *) h, DUK__SNAP_KIND_ROMOBJ);
+			DUK_BW_WRITE_ENSURE_BYTES(thr, &ctx->bw_hdr, (const void *) &h, sizeof(h));
+			return id;
+		}
+		if (DUK_HOBJECT_IS_THREAD(obj) ||
+		    (DUK_HOBJECT_IS_DECENV(obj) && ((duk_hdecenv *) obj)->thread != NULL)) {
+			/* Heap thread is registered up front, other threads
+			 * and open environments have native state.
+			 */
+			goto unsupported;
+		}
+		id = duk__snap_add_item(ctx, ent, (void *) h, (void *) h, DUK__SNAP_KIND_OBJECT);
+		duk__snap_write_u32(thr, &ctx->bw_hdr, DUK_HEAPHDR_GET_FLAGS_RAW(h) & DUK__SNAP_USER_FLAGS_MASK);
+		return id;
+	} else {
+		duk_hbuffer *buf = (duk_hbuffer *) h;
+		duk_size_t len;
+
+		DUK_ASSERT(DUK_HEAPHDR_IS_BUFFER(h));
+		if (DUK_HBUFFER_HAS_EXTERNAL(buf)) {
+			goto unsupported;
+		}
+		id = duk__snap_add_item(ctx, ent, (void *) h, (void *) h, DUK__SNAP_KIND_BUFFER);
+		len = DUK_HBUFFER_GET_SIZE(buf);
+		DUK_ASSERT(len <= 0xffffffffUL);  /* buffer limits */
+		duk__snap_write_u8(thr, &ctx->bw_hdr, DUK_HBUFFER_HAS_DYNAMIC(buf) ? 1 : 0);
+		duk__snap_write_u32(thr, &ctx->bw_hdr, (duk_uint32_t) len);
+		DUK_BW_WRITE_ENSURE_BYTES(thr, &ctx->bw_hdr, DUK_HBUFFER_GET_DATA_PTR(thr->heap, buf), len);
+		return id;
+	}
+
+ unsupported:
+	DUK_ERROR_TYPE(thr, DUK_STR_UNDUMPABLE_VALUE);
+	DUK_WO_NORETURN(return 0;);
+}
+
+/* Function data (constants, inner function templates, bytecode) is shared
+ * between a function template and its closures, and is keyed by the data
+ * buffer.
+ */
+DUK_LOCAL duk_uint32_t duk__snap_funcdata_id(duk__snap_dump_ctx *ctx, duk_hcompfunc *f) {
+	duk__snap_mapent *ent;
+	duk_hbuffer *data;
+	duk_uint32_t id;
+
+	data = (duk_hbuffer *) DUK_HCOMPFUNC_GET_DATA(ctx->thr->heap, f);
+	DUK_ASSERT(data != NULL);
+	ent = duk__snap_map_find(ctx, (void *) data);
+	if (ent->ptr != NULL) {
+		id = ent->id;
+		if (duk__snap_get_kind(ctx, id) != DUK__SNAP_KIND_FUNCDATA) {
+			DUK_ERROR_TYPE(ctx->thr, DUK_STR_UNDUMPABLE_VALUE);
+			DUK_WO_NORETURN(return 0;);
+		}
+		return id;
+	}
+	id = duk__snap_add_item(ctx, ent, (void *) data, (void *) f, DUK__SNAP_KIND_FUNCDATA);
+	duk__snap_write_u32(ctx->thr, &ctx->bw_hdr, (duk_uint32_t) DUK_HBUFFER_GET_SIZE(data));
+	return id;
+}
+
+/* Object or buffer reference: 0 for NULL, otherwise item index + 1. */
+DUK_LOCAL void duk__snap_write_ref(duk__snap_dump_ctx *ctx, duk_heaphdr *h) {
+	duk_uint32_t ref = 0;
+
+	if (h != NULL) {
+		ref = duk__snap_item_id(ctx, h) + 1U;
+	}
+	duk__snap_write_u32(ctx->thr, &ctx->bw_body, ref);
+}
+
+DUK_LOCAL void duk__snap_write_tval(duk__snap_dump_ctx *ctx, duk_tval *tv) {
+	duk_hthread *thr = ctx->thr;
+	duk_bufwriter_ctx *bw = &ctx->bw_body;
+	duk_uint32_t id;
+
+	switch (DUK_TVAL_GET_TAG(tv)) {
+	case DUK_TAG_UNUSED:
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_UNUSED);
+		break;
+	case DUK_TAG_UNDEFINED:
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_UNDEFINED);
+		break;
+	case DUK_TAG_NULL:
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_NULL);
+		break;
+	case DUK_TAG_BOOLEAN:
+		duk__snap_write_u8(thr, bw, DUK_TVAL_GET_BOOLEAN(tv) ? DUK__SNAP_TAG_TRUE : DUK__SNAP_TAG_FALSE);
+		break;
+	case DUK_TAG_STRING:
+		id = duk__snap_string_id(ctx, DUK_TVAL_GET_STRING(tv));
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_STRING);
+		duk__snap_write_u32(thr, bw, id);
+		break;
+	case DUK_TAG_OBJECT:
+		id = duk__snap_item_id(ctx, (duk_heaphdr *) DUK_TVAL_GET_OBJECT(tv));
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_OBJECT);
+		duk__snap_write_u32(thr, bw, id);
+		break;
+	case DUK_TAG_BUFFER:
+		id = duk__snap_item_id(ctx, (duk_heaphdr *) DUK_TVAL_GET_BUFFER(tv));
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_BUFFER);
+		duk__snap_write_u32(thr, bw, id);
+		break;
+	case DUK_TAG_POINTER: {
+		void *ptr = DUK_TVAL_GET_POINTER(tv);
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_POINTER);
+		DUK_BW_WRITE_ENSURE_BYTES(thr, bw, (const void *) &ptr, sizeof(ptr));
+		break;
+	}
+	case DUK_TAG_LIGHTFUNC: {
+		duk_c_function func;
+		duk_small_uint_t lf_flags;
+		DUK_TVAL_GET_LIGHTFUNC(tv, func, lf_flags);
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_LIGHTFUNC);
+		DUK_BW_WRITE_ENSURE_BYTES(thr, bw, (const void *) &func, sizeof(func));
+		duk__snap_write_u16(thr, bw, (duk_uint16_t) lf_flags);
+		break;
+	}
+	default:
+		DUK_ASSERT(DUK_TVAL_IS_NUMBER(tv));
+		duk__snap_write_u8(thr, bw, DUK__SNAP_TAG_NUMBER);
+		duk__snap_write_double(thr, bw, DUK_TVAL_GET_NUMBER(tv));
+		break;
+	}
+}
+
+DUK_LOCAL void duk__snap_dump_object(duk__snap_dump_ctx *ctx, duk_hobject *h) {
+	duk_hthread *thr = ctx->thr;
+	duk_heap *heap = thr->heap;
+	duk_bufwriter_ctx *bw = &ctx->bw_body;
+	duk_uint32_t a_count;
+	duk_uint32_t e_count;
+	duk_uint32_t i;
+
+	DUK_UNREF(heap);
+
+	duk__snap_write_u32(thr, bw, DUK_HEAPHDR_GET_FLAGS_RAW(&h->hdr) & DUK__SNAP_USER_FLAGS_MASK);
+	duk__snap_write_ref(ctx, (duk_heaphdr *) DUK_HOBJECT_GET_PROTOTYPE(heap, h));
+
+	/* Array part, trailing gaps trimmed. */
+	a_count = DUK_HOBJECT_GET_ASIZE(h);
+	while (a_count > 0 && DUK_TVAL_IS_UNUSED(DUK_HOBJECT_A_GET_VALUE_PTR(heap, h, a_count - 1))) {
+		a_count--;
+	}
+	duk__snap_write_u32(thr, bw, a_count);
+	for (i = 0; i < a_count; i++) {
+		duk__snap_write_tval(ctx, DUK_HOBJECT_A_GET_VALUE_PTR(heap, h, i));
+	}
+
+	/* Entry part, deleted entries skipped.  Writing values only appends
+	 * to the image buffers so the property table stays put.
+	 */
+	e_count = 0;
+	for (i = 0; i < DUK_HOBJECT_GET_ENEXT(h); i++) {
+		if (DUK_HOBJECT_E_GET_KEY(heap, h, i) != NULL) {
+			e_count++;
+		}
+	}
+	duk__snap_write_u32(thr, bw, e_count);
+	for (i = 0; i < DUK_HOBJECT_GET_ENEXT(h); i++) {
+		duk_hstring *key;
+		duk_uint32_t key_id;
+		duk_small_uint_t propflags;
+
+		key = DUK_HOBJECT_E_GET_KEY(heap, h, i);
+		if (key == NULL) {
+			continue;
+		}
+		key_id = duk__snap_string_id(ctx, key);
+		propflags = DUK_HOBJECT_E_GET_FLAGS(heap, h, i);
+		duk__snap_write_u32(thr, bw, key_id);
+		duk__snap_write_u8(thr, bw, (duk_uint8_t) propflags);
+		if (propflags & DUK_PROPDESC_FLAG_ACCESSOR) {
+			duk__snap_write_ref(ctx, (duk_heaphdr *) DUK_HOBJECT_E_GET_VALUE_GETTER(heap, h, i));
+			duk__snap_write_ref(ctx, (duk_heaphdr *) DUK_HOBJECT_E_GET_VALUE_SETTER(heap, h, i));
+		} else {
+			duk__snap_write_tval(ctx, DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(heap, h, i));
+		}
+	}
+
+	/* Internal fields of object subtypes. */
+	if (DUK_HOBJECT_IS_THREAD(h)) {
+		/* Only the heap thread, whose internal state is not dumped. */
+		DUK_ASSERT(h == (duk_hobject *) heap->heap_thread);
+	} else if (DUK_HOBJECT_IS_COMPFUNC(h)) {
+		duk_hcompfunc *f = (duk_hcompfunc *) h;
+		duk_uint32_t data_ref = 0;
+
+		if (DUK_HCOMPFUNC_GET_DATA(heap, f) != NULL) {
+			data_ref = duk__snap_funcdata_id(ctx, f) + 1U;
+		}
+		duk__snap_write_u32(thr, bw, data_ref);
+		if (data_ref != 0) {
+			duk__snap_write_u32(thr, bw, (duk_uint32_t) DUK_HCOMPFUNC_GET_CONSTS_COUNT(heap, f));
+			duk__snap_write_u32(thr, bw, (duk_uint32_t) DUK_HCOMPFUNC_GET_FUNCS_COUNT(heap, f));
+			duk__snap_write_u32(thr, bw, (duk_uint32_t) DUK_HCOMPFUNC_GET_CODE_COUNT(heap, f));
+		}
+		duk__snap_write_ref(ctx, (duk_heaphdr *) DUK_HCOMPFUNC_GET_LEXENV(heap, f));
+		duk__snap_write_ref(ctx, (duk_heaphdr *) DUK_HCOMPFUNC_GET_VARENV(heap, f));
+		duk__snap_write_u16(thr, bw, f->nregs);
+		duk__snap_write_u16(thr, bw, f->nargs);
+#if defined(DUK_USE_DEBUGGER_SUPPORT)
+		duk__snap_write_u32(thr, bw, f->start_line);
+		duk__snap_write_u32(thr, bw, f->end_line);
+#endif
+	} else if (DUK_HOBJECT_IS_NATFUNC(h)) {
+		duk_hnatfunc *f = (duk_hnatfunc *) h;
+
+		DUK_BW_WRITE_ENSURE_BYTES(thr, bw, (const void *) &f->func, sizeof(f->func));
+		duk__snap_write_u16(thr, bw, (duk_uint16_t) f->nargs);
+		duk__snap_write_u16(thr, bw, (duk_uint16_t) f->magic);
+	} else if (DUK_HOBJECT_IS_BOUNDFUNC(h)) {
+		duk_hboundfunc *f = (duk_hboundfunc *) (void *) h;
+		duk_idx_t j;
+
+		duk__snap_write_tval(ctx, &f->target);
+		duk__snap_write_tval(ctx, &f->this_binding);
+		duk__snap_write_u32(thr, bw, (duk_uint32_t) f->nargs);
+		for (j = 0; j < f->nargs; j++) {
+			duk__snap_write_tval(ctx, f->args + j);
+		}
+#if defined(DUK_USE_BUFFEROBJECT_SUPPORT)
+	} else if (DUK_HOBJECT_IS_BUFOBJ(h)) {
+		duk_hbufobj *b = (duk_hbufobj *) h;
+
+		duk__snap_write_ref(ctx, (duk_heaphdr *) b->buf);
+		duk__snap_write_ref(ctx, (duk_heaphdr *) b->buf_prop);
+		duk__snap_write_u32(thr, bw, (duk_uint32_t) b->offset);
+		duk__snap_write_u32(thr, bw, (duk_uint32_t) b->length);
+		duk__snap_write_u8(thr, bw, b->shift);
+		duk__snap_write_u8(thr, bw, b->elem_type);
+		duk__snap_write_u8(thr, bw, b->is_typedarray);
+#endif
+#if defined(DUK_USE_ES6_PROXY)
+	} else if (DUK_HOBJECT_IS_PROXY(h)) {
+		duk_hproxy *p = (duk_hproxy *) h;
+
+		duk__snap_write_ref(ctx, (duk_heaphdr *) p->target);
+		duk__snap_write_ref(ctx, (duk_heaphdr *) p->handler);
+#endif
+	} else if (DUK_HOBJECT_IS_OBJENV(h)) {
+		duk_hobjenv *e = (duk_hobjenv *) h;
+
+		duk__snap_write_ref(ctx, (duk_heaphdr *) e->target);
+		duk__snap_write_u8(thr, bw, e->has_this ? 1 : 0);
+	} else if (DUK_HOBJECT_HAS_EXOTIC_ARRAY(h)) {
+		duk_harray *a = (duk_harray *) h;
+
+		duk__snap_write_u32(thr, bw, a->length);
+		duk__snap_write_u8(thr, bw, a->length_nonwritable ? 1 : 0);
+	}
+	/* Closed declarative environments have no state beyond properties. */
+}
+
+DUK_LOCAL void duk__snap_dump_funcdata(duk__snap_dump_ctx *ctx, duk_hcompfunc *f) {
+	duk_hthread *thr = ctx->thr;
+	duk_heap *heap = thr->heap;
+	duk_tval *tv, *tv_end;
+	duk_hobject **fn, **fn_end;
+
+	DUK_UNREF(heap);
+
+	duk__snap_write_u32(thr, &ctx->bw_body, (duk_uint32_t) DUK_HCOMPFUNC_GET_CONSTS_COUNT(heap, f));
+	duk__snap_write_u32(thr, &ctx->bw_body, (duk_uint32_t) DUK_HCOMPFUNC_GET_FUNCS_COUNT(heap, f));
+	duk__snap_write_u32(thr, &ctx->bw_body, (duk_uint32_t) DUK_HCOMPFUNC_GET_CODE_COUNT(heap, f));
+
+	tv = DUK_HCOMPFUNC_GET_CONSTS_BASE(heap, f);
+	tv_end = DUK_HCOMPFUNC_GET_CONSTS_END(heap, f);
+	while (tv < tv_end) {
+		duk__snap_write_tval(ctx, tv++);
+	}
+	fn = DUK_HCOMPFUNC_GET_FUNCS_BASE(heap, f);
+	fn_end = DUK_HCOMPFUNC_GET_FUNCS_END(heap, f);
+	while (fn < fn_end) {
+		duk__snap_write_ref(ctx, (duk_heaphdr *) *fn++);
+	}
+
+	/* Bytecode is stored in native byte order.  The inline cache is not
+	 * stored, it starts out empty after a load.
+	 */
+	DUK_BW_WRITE_ENSURE_BYTES(thr,
+	                          &ctx->bw_body,
+	                          (const void *) DUK_HCOMPFUNC_GET_CODE_BASE(heap, f),
+	                          DUK_HCOMPFUNC_GET_CODE_SIZE(heap, f));
+}
+
+DUK_LOCAL void duk__snap_register_root(duk__snap_dump_ctx *ctx, duk_hobject *h, duk_small_uint_t kind, duk_small_uint_t bidx) {
+	duk__snap_mapent *ent;
+
+	if (h == NULL) {
+		return;
+	}
+	if (DUK_HEAPHDR_HAS_READONLY((duk_heaphdr *) h)) {
+		(void) duk__snap_item_id(ctx, (duk_heaphdr *) h);
+		return;
+	}
+	ent = duk__snap_map_find(ctx, (void *) h);
+	if (ent->ptr != NULL) {
+		return;
+	}
+	(void) duk__snap_add_item(ctx, ent, (void *) h, (void *) h, kind);
+	if (kind == DUK__SNAP_KIND_BUILTIN) {
+		duk__snap_write_u8(ctx->thr, &ctx->bw_hdr, (duk_uint8_t) bidx);
+	}
+}
+
+DUK_LOCAL duk_ret_t duk__dump_heap_raw(duk_hthread *thr, void *udata) {
+	duk__snap_dump_ctx ctx_alloc;
+	duk__snap_dump_ctx *ctx = &ctx_alloc;
+	duk_heap *heap = thr->heap;
+	duk_uint32_t i;
+	duk_size_t len_str, len_hdr, len_body;
+	duk_uint8_t *p;
+
+	DUK_UNREF(udata);
+
+	duk_memzero(ctx, sizeof(*ctx));
+	ctx->thr = thr;
+	duk__snap_map_init(ctx, DUK__SNAP_MAP_MIN_SIZE);
+	DUK_BW_INIT_PUSHBUF(thr, &ctx->bw_items, DUK__SNAP_INITIAL_ALLOC);
+	DUK_BW_INIT_PUSHBUF(thr, &ctx->bw_str, DUK__SNAP_INITIAL_ALLOC);
+	DUK_BW_INIT_PUSHBUF(thr, &ctx->bw_hdr, DUK__SNAP_INITIAL_ALLOC);
+	DUK_BW_INIT_PUSHBUF(thr, &ctx->bw_body, DUK__SNAP_INITIAL_ALLOC);
+
+	/* Roots, patched in place on load. */
+	for (i = 0; i < DUK_NUM_BUILTINS; i++) {
+		duk__snap_register_root(ctx, thr->builtins[i], DUK__SNAP_KIND_BUILTIN, (duk_small_uint_t) i);
+	}
+	duk__snap_register_root(ctx, heap->heap_object, DUK__SNAP_KIND_HEAP_OBJECT, 0);
+	duk__snap_register_root(ctx, (duk_hobject *) heap->heap_thread, DUK__SNAP_KIND_HEAP_THREAD, 0);
+
+	/* Breadth first: bodies are written in item order, and new items are
+	 * appended while bodies are being written.
+	 */
+	for (i = 0; i < ctx->nitems; i++) {
+		duk__snap_item item;
+
+		item = ((duk__snap_item *) (void *) DUK_BW_GET_BASEPTR(thr, &ctx->bw_items))[i];
+		switch (item.kind) {
+		case DUK__SNAP_KIND_OBJECT:
+		case DUK__SNAP_KIND_BUILTIN:
+		case DUK__SNAP_KIND_HEAP_OBJECT:
+		case DUK__SNAP_KIND_HEAP_THREAD:
+			duk__snap_dump_object(ctx, (duk_hobject *) item.ptr);
+			break;
+		case DUK__SNAP_KIND_FUNCDATA:
+			duk__snap_dump_funcdata(ctx, (duk_hcompfunc *) item.ptr);
+			break;
+		default:
+			/* ROM objects and plain buffers are complete in the header. */
+			break;
+		}
+	}
+
+	len_str = DUK_BW_GET_SIZE(thr, &ctx->bw_str);
+	len_hdr = DUK_BW_GET_SIZE(thr, &ctx->bw_hdr);
+	len_body = DUK_BW_GET_SIZE(thr, &ctx->bw_body);
+	p = (duk_uint8_t *) duk_push_fixed_buffer_nozero(thr, 1 + 4 + 2 + 8 + 8 + len_str + len_hdr + len_body);
+	DUK_RAW_WRITEINC_U8(p, DUK__SNAP_MARKER);
+	DUK_RAW_WRITEINC_U32_BE(p, (duk_uint32_t) DUK_VERSION);
+	DUK_RAW_WRITEINC_U8(p, (duk_uint8_t) sizeof(void *));
+	DUK_RAW_WRITEINC_U8(p, (duk_uint8_t) sizeof(duk_tval));
+	DUK_RAW_WRITEINC_U32_BE(p, heap->sym_counter[0]);
+	DUK_RAW_WRITEINC_U32_BE(p, heap->sym_counter[1]);
+	DUK_RAW_WRITEINC_U32_BE(p, ctx->nstrings);
+	DUK_RAW_WRITEINC_U32_BE(p, ctx->nitems);
+	duk_memcpy_unsafe((void *) p, (const void *) DUK_BW_GET_BASEPTR(thr, &ctx->bw_str), len_str);
+	p += len_str;
+	duk_memcpy_unsafe((void *) p, (const void *) DUK_BW_GET_BASEPTR(thr, &ctx->bw_hdr), len_hdr);
+	p += len_hdr;
+	duk_memcpy_unsafe((void *) p, (const void *) DUK_BW_GET_BASEPTR(thr, &ctx->bw_body), len_body);
+
+	DUK_DD(DUK_DDPRINT("dumped heap: %ld strings, %ld items, %ld bytes",
+	                   (long) ctx->nstrings, (long) ctx->nitems, (long) duk_get_length(thr, -1)));
+	return 1;
+}
+
+/*
+ *  Load
+ */
+
+typedef struct {
+	duk_hthread *thr;
+	const duk_uint8_t *p;
+	const duk_uint8_t *p_end;
+
+	duk_hstring **strs;    /* [nstrings], kept reachable by a bare array */
+	duk_uint32_t nstrings;
+	void **items;          /* [nitems], kept reachable by a bare array */
+	duk_uint8_t *kinds;    /* [nitems] */
+	duk_uint32_t nitems;
+} duk__snap_load_ctx;
+
+DUK_LOCAL DUK_NORETURN(void duk__snap_format_error(duk_hthread *thr));
+DUK_LOCAL void duk__snap_format_error(duk_hthread *thr) {
+	DUK_ERROR_TYPE(thr, DUK_STR_INVALID_HEAP_IMAGE);
+	DUK_WO_NORETURN(return;);
+}
+
+DUK_LOCAL void duk__snap_need(duk__snap_load_ctx *ctx, duk_size_t len) {
+	if ((duk_size_t) (ctx->p_end - ctx->p) < len) {
+		duk__snap_format_error(ctx->thr);
+	}
+}
+
+DUK_LOCAL duk_uint8_t duk__snap_read_u8(duk__snap_load_ctx *ctx) {
+	duk__snap_need(ctx, 1);
+	return DUK_RAW_READINC_U8(ctx->p);
+}
+
+DUK_LOCAL duk_uint16_t duk__snap_read_u16(duk__snap_load_ctx *ctx) {
+	duk_uint16_t res;
+
+	duk__snap_need(ctx, 2);
+	res = DUK_RAW_READINC_U16_BE(ctx->p);
+	return res;
+}
+
+DUK_LOCAL duk_uint32_t duk__snap_read_u32(duk__snap_load_ctx *ctx) {
+	duk_uint32_t res;
+
+	duk__snap_need(ctx, 4);
+	res = DUK_RAW_READINC_U32_BE(ctx->p);
+	return res;
+}
+
+DUK_LOCAL void duk__snap_read_bytes(duk__snap_load_ctx *ctx, void *out, duk_size_t len) {
+	duk__snap_need(ctx, len);
+	duk_memcpy_unsafe(out, (const void *) ctx->p, len);
+	ctx->p += len;
+}
+
+DUK_LOCAL duk_bool_t duk__snap_kind_is_object(duk_small_uint_t kind) {
+	return kind <= DUK__SNAP_KIND_ROMOBJ;
+}
+
+DUK_LOCAL duk_hstring *duk__snap_read_string(duk__snap_load_ctx *ctx) {
+	duk_uint32_t id;
+
+	id = duk__snap_read_u32(ctx);
+	if (id >= ctx->nstrings) {
+		duk__snap_format_error(ctx->thr);
+	}
+	return ctx->strs[id];
+}
+
+DUK_LOCAL duk_heaphdr *duk__snap_read_item(duk__snap_load_ctx *ctx, duk_uint32_t id, duk_bool_t want_object) {
+	if (id >= ctx->nitems || duk__snap_kind_is_object(ctx->kinds[id]) != want_object) {
+		duk__snap_format_error(ctx->thr);
+	}
+	return (duk_heaphdr *) ctx->items[id];
+}
+
+DUK_LOCAL duk_heaphdr *duk__snap_read_ref(duk__snap_load_ctx *ctx, duk_bool_t want_object) {
+	duk_uint32_t ref;
+
+	ref = duk__snap_read_u32(ctx);
+	if (ref == 0) {
+		return NULL;
+	}
+	return duk__snap_read_item(ctx, ref - 1U, want_object);
+}
+
+DUK_LOCAL duk_hobject *duk__snap_read_objref(duk__snap_load_ctx *ctx) {
+	return (duk_hobject *) duk__snap_read_ref(ctx, 1 /*want_object*/);
+}
+
+/* Read a value into 'tv' without updating refcounts. */
+DUK_LOCAL void duk__snap_read_tval(duk__snap_load_ctx *ctx, duk_tval *tv) {
+	switch (duk__snap_read_u8(ctx)) {
+	case DUK__SNAP_TAG_UNDEFINED:
+		DUK_TVAL_SET_UNDEFINED(tv);
+		break;
+	case DUK__SNAP_TAG_NULL:
+		DUK_TVAL_SET_NULL(tv);
+		break;
+	case DUK__SNAP_TAG_FALSE:
+		DUK_TVAL_SET_BOOLEAN_FALSE(tv);
+		break;
+	case DUK__SNAP_TAG_TRUE:
+		DUK_TVAL_SET_BOOLEAN_TRUE(tv);
+		break;
+	case DUK__SNAP_TAG_NUMBER: {
+		duk_double_t d;
+		duk__snap_need(ctx, 8);
+		d = DUK_RAW_READINC_DOUBLE_BE(ctx->p);
+		DUK_TVAL_SET_NUMBER_CHKFAST_SLOW(tv, d);
+		break;
+	}
+	case DUK__SNAP_TAG_STRING:
+		DUK_TVAL_SET_STRING(tv, duk__snap_read_string(ctx));
+		break;
+	case DUK__SNAP_TAG_OBJECT:
+		DUK_TVAL_SET_OBJECT(tv, (duk_hobject *) duk__snap_read_item(ctx, duk__snap_read_u32(ctx), 1 /*want_object*/));
+		break;
+	case DUK__SNAP_TAG_BUFFER:
+		DUK_TVAL_SET_BUFFER(tv, (duk_hbuffer *) duk__snap_read_item(ctx, duk__snap_read_u32(ctx), 0 /*want_object*/));
+		break;
+	case DUK__SNAP_TAG_POINTER: {
+		void *ptr;
+		duk__snap_read_bytes(ctx, (void *) &ptr, sizeof(ptr));
+		DUK_TVAL_SET_POINTER(tv, ptr);
+		break;
+	}
+	case DUK__SNAP_TAG_LIGHTFUNC: {
+		duk_c_function func;
+		duk_small_uint_t lf_flags;
+		duk__snap_read_bytes(ctx, (void *) &func, sizeof(func));
+		lf_flags = (duk_small_uint_t) duk__snap_read_u16(ctx);
+		DUK_TVAL_SET_LIGHTFUNC(tv, func, lf_flags);
+		break;
+	}
+	case DUK__SNAP_TAG_UNUSED:
+		DUK_TVAL_SET_UNUSED(tv);
+		break;
+	default:
+		duk__snap_format_error(ctx->thr);
+	}
+}
+
+DUK_LOCAL duk_hobject *duk__snap_alloc_object(duk_hthread *thr, duk_uint_t flags) {
+	duk_small_uint_t class_num;
+	duk_hobject *res;
+
+	class_num = (duk_small_uint_t) ((flags >> DUK_HOBJECT_FLAG_CLASS_BASE) & ((1U << DUK_HOBJECT_FLAG_CLASS_BITS) - 1U));
+	flags = (flags | DUK_HOBJECT_FLAG_EXTENSIBLE) & ~(DUK__SNAP_LOOKUP_FLAGS | DUK_HOBJECT_FLAG_HAVE_FINALIZER);
+
+	if (flags & DUK_HOBJECT_FLAG_COMPFUNC) {
+		res = (duk_hobject *) duk_hcompfunc_alloc(thr, flags);
+	} else if (flags & DUK_HOBJECT_FLAG_NATFUNC) {
+		res = (duk_hobject *) duk_hnatfunc_alloc(thr, flags);
+	} else if (flags & DUK_HOBJECT_FLAG_BOUNDFUNC) {
+		res = (duk_hobject *) duk_hboundfunc_alloc(thr->heap, flags);
+		if (res == NULL) {
+			DUK_ERROR_ALLOC_FAILED(thr);
+			DUK_WO_NORETURN(return NULL;);
+		}
+	} else if (flags & DUK_HOBJECT_FLAG_BUFOBJ) {
+#if defined(DUK_USE_BUFFEROBJECT_SUPPORT)
+		res = (duk_hobject *) duk_hbufobj_alloc(thr, flags);
+#else
+		goto format_error;
+#endif
+	} else if (flags & DUK_HOBJECT_FLAG_EXOTIC_PROXYOBJ) {
+#if defined(DUK_USE_ES6_PROXY)
+		res = (duk_hobject *) duk_hproxy_alloc(thr, flags);
+#else
+		goto format_error;
+#endif
+	} else if (flags & DUK_HOBJECT_FLAG_EXOTIC_ARRAY) {
+		res = (duk_hobject *) duk_harray_alloc(thr, flags);
+	} else if (class_num == DUK_HOBJECT_CLASS_DECENV) {
+		res = (duk_hobject *) duk_hdecenv_alloc(thr, flags);
+	} else if (class_num == DUK_HOBJECT_CLASS_OBJENV) {
+		res = (duk_hobject *) duk_hobjenv_alloc(thr, flags);
+	} else if (class_num == DUK_HOBJECT_CLASS_THREAD) {
+		goto format_error;
+	} else {
+		res = duk_hobject_alloc(thr, flags);
+	}
+	DUK_ASSERT(res != NULL);
+	return res;
+
+ format_error:
+	duk__snap_format_error(thr);
+	DUK_WO_NORETURN(return NULL;);
+}
+
+DUK_LOCAL void duk__snap_load_items(duk__snap_load_ctx *ctx, duk_idx_t idx_keep) {
+	duk_hthread *thr = ctx->thr;
+	duk_uint32_t i;
+
+	for (i = 0; i < ctx->nitems; i++) {
+		duk_small_uint_t kind;
+		void *ptr;
+
+		kind = duk__snap_read_u8(ctx);
+		switch (kind) {
+		case DUK__SNAP_KIND_OBJECT: {
+			duk_uint32_t flags;
+			flags = duk__snap_read_u32(ctx);
+			ptr = (void *) duk__snap_alloc_object(thr, (duk_uint_t) flags);
+			duk_push_hobject(thr, (duk_hobject *) ptr);
+			duk_put_prop_index(thr, idx_keep, (duk_uarridx_t) i);
+			break;
+		}
+		case DUK__SNAP_KIND_BUILTIN: {
+			duk_small_uint_t bidx;
+			bidx = duk__snap_read_u8(ctx);
+			if (bidx >= DUK_NUM_BUILTINS) {
+				goto format_error;
+			}
+			ptr = (void *) thr->builtins[bidx];
+			if (ptr == NULL || DUK_HEAPHDR_HAS_READONLY((duk_heaphdr *) ptr)) {
+				goto format_error;
+			}
+			break;
+		}
+		case DUK__SNAP_KIND_HEAP_OBJECT:
+			ptr = (void *) thr->heap->heap_object;
+			break;
+		case DUK__SNAP_KIND_HEAP_THREAD:
+			ptr = (void *) thr->heap->heap_thread;
+			break;
+		case DUK__SNAP_KIND_ROMOBJ:
+#if defined(DUK_USE_ROM_OBJECTS)
+			duk__snap_read_bytes(ctx, (void *) &ptr, sizeof(ptr));
+			break;
+#else
+			goto format_error;
+#endif
+		case DUK__SNAP_KIND_BUFFER: {
+			duk_small_uint_t dynamic;
+			duk_uint32_t len;
+			dynamic = duk__snap_read_u8(ctx);
+			len = duk__snap_read_u32(ctx);
+			duk__snap_need(ctx, len);
+			(void) duk_push_buffer(thr, (duk_size_t) len, dynamic);
+			ptr = (void *) duk_known_hbuffer(thr, -1);
+			duk_memcpy_unsafe(DUK_HBUFFER_GET_DATA_PTR(thr->heap, (duk_hbuffer *) ptr), (const void *) ctx->p, (size_t) len);
+			ctx->p += len;
+			duk_put_prop_index(thr, idx_keep, (duk_uarridx_t) i);
+			break;
+		}
+		case DUK__SNAP_KIND_FUNCDATA: {
+			duk_uint32_t len;
+			len = duk__snap_read_u32(ctx);
+			(void) duk_push_fixed_buffer_zero(thr, (duk_size_t) len);
+			ptr = (void *) duk_known_hbuffer(thr, -1);
+			duk_put_prop_index(thr, idx_keep, (duk_uarridx_t) i);
+			break;
+		}
+		default:
+			goto format_error;
+		}
+		ctx->items[i] = ptr;
+		ctx->kinds[i] = (duk_uint8_t) kind;
+	}
+	return;
+
+ format_error:
+	duk__snap_format_error(thr);
+}
+
+/* Remove all own properties of an existing object which is being patched. */
+DUK_LOCAL void duk__snap_clear_object(duk_hthread *thr, duk_hobject *h) {
+	duk_heap *heap = thr->heap;
+	duk_uint32_t i;
+
+	DUK_UNREF(heap);
+
+	for (i = DUK_HOBJECT_GET_ENEXT(h); i-- > 0;) {
+		duk_hstring *key;
+
+		key = DUK_HOBJECT_E_GET_KEY(heap, h, i);
+		if (key != NULL) {
+			(void) duk_hobject_delprop_raw(thr, h, key, DUK_DELPROP_FLAG_THROW | DUK_DELPROP_FLAG_FORCE);
+		}
+	}
+	for (i = 0; i < DUK_HOBJECT_GET_ASIZE(h); i++) {
+		duk_tval *tv;
+
+		tv = DUK_HOBJECT_A_GET_VALUE_PTR(heap, h, i);
+		DUK_TVAL_SET_UNUSED_UPDREF(thr, tv);
+	}
+}
+
+DUK_LOCAL void duk__snap_load_object(duk__snap_load_ctx *ctx, duk_hobject *h, duk_small_uint_t kind) {
+	duk_hthread *thr = ctx->thr;
+	duk_heap *heap = thr->heap;
+	duk_uint32_t flags;
+	duk_hobject *proto;
+	duk_uint32_t a_count;
+	duk_uint32_t e_count;
+	duk_uint32_t i;
+
+	flags = duk__snap_read_u32(ctx);
+	proto = duk__snap_read_objref(ctx);
+
+	if (kind != DUK__SNAP_KIND_OBJECT) {
+		/* The object subtype is fixed by the allocation. */
+		const duk_uint32_t type_mask = DUK_HOBJECT_FLAG_COMPFUNC | DUK_HOBJECT_FLAG_NATFUNC |
+		                               DUK_HOBJECT_FLAG_BOUNDFUNC | DUK_HOBJECT_FLAG_BUFOBJ |
+		                               DUK_HOBJECT_FLAG_EXOTIC_ARRAY | DUK_HOBJECT_FLAG_EXOTIC_PROXYOBJ |
+		                               DUK_HOBJECT_CLASS_AS_FLAGS((1U << DUK_HOBJECT_FLAG_CLASS_BITS) - 1U);
+		if ((flags & type_mask) != (DUK_HEAPHDR_GET_FLAGS_RAW(&h->hdr) & type_mask)) {
+			duk__snap_format_error(thr);
+		}
+		duk__snap_clear_object(thr, h);
+	}
+
+	a_count = duk__snap_read_u32(ctx);
+	if (a_count > 0) {
+		if (!DUK_HOBJECT_HAS_ARRAY_PART(h) || a_count > DUK_HOBJECT_MAX_PROPERTIES) {
+			duk__snap_format_error(thr);
+		}
+		if (a_count > DUK_HOBJECT_GET_ASIZE(h)) {
+			duk_hobject_realloc_props(thr, h, DUK_HOBJECT_GET_ESIZE(h), a_count, DUK_HOBJECT_GET_HSIZE(h), 0 /*abandon_array*/);
+		}
+		for (i = 0; i < a_count; i++) {
+			duk_tval *tv;
+
+			tv = DUK_HOBJECT_A_GET_VALUE_PTR(heap, h, i);
+			DUK_ASSERT(DUK_TVAL_IS_UNUSED(tv));
+			duk__snap_read_tval(ctx, tv);
+			DUK_TVAL_INCREF(thr, tv);
+		}
+	}
+
+	e_count = duk__snap_read_u32(ctx);
+	if (e_count > DUK_HOBJECT_MAX_PROPERTIES) {
+		duk__snap_format_error(thr);
+	}
+	if (e_count > DUK_HOBJECT_GET_ESIZE(h) - DUK_HOBJECT_GET_ENEXT(h)) {
+		duk_hobject_resize_entrypart(thr, h, DUK_HOBJECT_GET_ENEXT(h) + e_count);
+	}
+	for (i = 0; i < e_count; i++) {
+		duk_hstring *key;
+		duk_small_uint_t propflags;
+
+		key = duk__snap_read_string(ctx);
+		propflags = duk__snap_read_u8(ctx);
+		if (propflags & DUK_PROPDESC_FLAG_ACCESSOR) {
+			duk_hobject *getter;
+			duk_hobject *setter;
+
+			getter = duk__snap_read_objref(ctx);
+			setter = duk__snap_read_objref(ctx);
+			duk_hobject_define_property_helper(thr,
+			                                   DUK_DEFPROP_HAVE_GETTER | DUK_DEFPROP_HAVE_SETTER |
+			                                   DUK_DEFPROP_HAVE_ENUMERABLE | DUK_DEFPROP_HAVE_CONFIGURABLE |
+			                                   (propflags & (DUK_PROPDESC_FLAG_ENUMERABLE | DUK_PROPDESC_FLAG_CONFIGURABLE)) |
+			                                   DUK_DEFPROP_FORCE,
+			                                   h,
+			                                   key,
+			                                   0 /*idx_value, unused*/,
+			                                   getter,
+			                                   setter,
+			                                   1 /*throw_flag*/);
+		} else {
+			duk__snap_read_tval(ctx, thr->valstack_top);
+			DUK_TVAL_INCREF(thr, thr->valstack_top);
+			thr->valstack_top++;
+
+			if (DUK_HOBJECT_HAS_ARRAY_PART(h) && DUK_HSTRING_HAS_ARRIDX(key)) {
+				/* Array index keys in the entry part, e.g. non-WEC
+				 * elements; the array part may need to be abandoned.
+				 */
+				duk_hobject_define_property_helper(thr,
+				                                   DUK_DEFPROP_HAVE_VALUE | DUK_DEFPROP_HAVE_WEC |
+				                                   (propflags & DUK_PROPDESC_FLAGS_WEC) |
+				                                   DUK_DEFPROP_FORCE,
+				                                   h,
+				                                   key,
+				                                   duk_get_top_index(thr),
+				                                   NULL,
+				                                   NULL,
+				                                   1 /*throw_flag*/);
+				duk_pop_unsafe(thr);
+			} else {
+				duk_hobject_define_property_internal(thr, h, key, propflags);  /* pops value */
+			}
+		}
+	}
+
+	/* Internal fields of object subtypes.  Patched objects (built-ins and
+	 * heap objects) may have existing references which are replaced.
+	 */
+	if (DUK_HOBJECT_IS_THREAD(h)) {
+		if (h != (duk_hobject *) heap->heap_thread) {
+			duk__snap_format_error(thr);
+		}
+	} else if (DUK_HOBJECT_IS_COMPFUNC(h)) {
+		duk_hcompfunc *f = (duk_hcompfunc *) h;
+		duk_uint32_t data_ref;
+		duk_hbuffer *data;
+		duk_hobject *env;
+
+		DUK_ASSERT(kind == DUK__SNAP_KIND_OBJECT);
+		data_ref = duk__snap_read_u32(ctx);
+		if (data_ref != 0) {
+			duk_uint32_t nconst, nfunc, ninstr;
+			duk_uint8_t *base;
+
+			if (data_ref > ctx->nitems || ctx->kinds[data_ref - 1U] != DUK__SNAP_KIND_FUNCDATA) {
+				duk__snap_format_error(thr);
+			}
+			data = (duk_hbuffer *) ctx->items[data_ref - 1U];
+			nconst = duk__snap_read_u32(ctx);
+			nfunc = duk__snap_read_u32(ctx);
+			ninstr = duk__snap_read_u32(ctx);
+			if (DUK__SNAP_COMPFUNC_DATA_SIZE(nconst, nfunc, ninstr) != DUK_HBUFFER_GET_SIZE(data)) {
+				duk__snap_format_error(thr);
+			}
+			base = (duk_uint8_t *) DUK_HBUFFER_FIXED_GET_DATA_PTR(heap, (duk_hbuffer_fixed *) data);
+			DUK_HCOMPFUNC_SET_DATA(heap, f, (duk_hbuffer_fixed *) data);
+			DUK_HBUFFER_INCREF(thr, data);
+			base += (duk_size_t) nconst * sizeof(duk_tval);
+			DUK_HCOMPFUNC_SET_FUNCS(heap, f, (duk_hobject **) (void *) base);
+			base += (duk_size_t) nfunc * sizeof(duk_hobject *);
+			DUK_HCOMPFUNC_SET_BYTECODE(heap, f, (duk_instr_t *) (void *) base);
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+			base += (duk_size_t) ninstr * sizeof(duk_instr_t);
+			DUK_HCOMPFUNC_SET_ICACHE(heap, f, base);
+#endif
+		}
+		env = duk__snap_read_objref(ctx);
+		DUK_HCOMPFUNC_SET_LEXENV(heap, f, env);
+		DUK_HOBJECT_INCREF_ALLOWNULL(thr, env);
+		env = duk__snap_read_objref(ctx);
+		DUK_HCOMPFUNC_SET_VARENV(heap, f, env);
+		DUK_HOBJECT_INCREF_ALLOWNULL(thr, env);
+		f->nregs = duk__snap_read_u16(ctx);
+		f->nargs = duk__snap_read_u16(ctx);
+#if defined(DUK_USE_DEBUGGER_SUPPORT)
+		f->start_line = duk__snap_read_u32(ctx);
+		f->end_line = duk__snap_read_u32(ctx);
+#endif
+	} else if (DUK_HOBJECT_IS_NATFUNC(h)) {
+		duk_hnatfunc *f = (duk_hnatfunc *) h;
+
+		duk__snap_read_bytes(ctx, (void *) &f->func, sizeof(f->func));
+		f->nargs = (duk_int16_t) duk__snap_read_u16(ctx);
+		f->magic = (duk_int16_t) duk__snap_read_u16(ctx);
+	} else if (DUK_HOBJECT_IS_BOUNDFUNC(h)) {
+		duk_hboundfunc *f = (duk_hboundfunc *) (void *) h;
+		duk_uint32_t nargs;
+		duk_uint32_t j;
+
+		DUK_ASSERT(kind == DUK__SNAP_KIND_OBJECT);
+		duk__snap_read_tval(ctx, &f->target);
+		DUK_TVAL_INCREF(thr, &f->target);
+		duk__snap_read_tval(ctx, &f->this_binding);
+		DUK_TVAL_INCREF(thr, &f->this_binding);
+		nargs = duk__snap_read_u32(ctx);
+		if (nargs > (duk_uint32_t) DUK_HBOUNDFUNC_MAX_ARGS) {
+			duk__snap_format_error(thr);
+		}
+		if (nargs > 0) {
+			f->args = (duk_tval *) DUK_ALLOC_CHECKED(thr, (duk_size_t) nargs * sizeof(duk_tval));
+			for (j = 0; j < nargs; j++) {
+				DUK_TVAL_SET_UNDEFINED(f->args + j);
+			}
+			f->nargs = (duk_idx_t) nargs;
+			for (j = 0; j < nargs; j++) {
+				duk__snap_read_tval(ctx, f->args + j);
+				DUK_TVAL_INCREF(thr, f->args + j);
+			}
+		}
+#if defined(DUK_USE_BUFFEROBJECT_SUPPORT)
+	} else if (DUK_HOBJECT_IS_BUFOBJ(h)) {
+		duk_hbufobj *b = (duk_hbufobj *) h;
+		duk_hbuffer *buf;
+		duk_hobject *buf_prop;
+		duk_hbuffer *old_buf;
+		duk_hobject *old_buf_prop;
+
+		buf = (duk_hbuffer *) duk__snap_read_ref(ctx, 0 /*want_object*/);
+		buf_prop = duk__snap_read_objref(ctx);
+		old_buf = b->buf;
+		old_buf_prop = b->buf_prop;
+		DUK_UNREF(old_buf);
+		DUK_UNREF(old_buf_prop);  /* unused without refcounting */
+		b->buf = buf;
+		DUK_HBUFFER_INCREF_ALLOWNULL(thr, buf);
+		b->buf_prop = buf_prop;
+		DUK_HOBJECT_INCREF_ALLOWNULL(thr, buf_prop);
+		DUK_HBUFFER_DECREF_ALLOWNULL(thr, old_buf);
+		DUK_HOBJECT_DECREF_ALLOWNULL(thr, old_buf_prop);
+		b->offset = (duk_uint_t) duk__snap_read_u32(ctx);
+		b->length = (duk_uint_t) duk__snap_read_u32(ctx);
+		b->shift = duk__snap_read_u8(ctx);
+		b->elem_type = duk__snap_read_u8(ctx);
+		b->is_typedarray = duk__snap_read_u8(ctx);
+#endif
+#if defined(DUK_USE_ES6_PROXY)
+	} else if (DUK_HOBJECT_IS_PROXY(h)) {
+		duk_hproxy *p = (duk_hproxy *) h;
+
+		DUK_ASSERT(kind == DUK__SNAP_KIND_OBJECT);
+		p->target = duk__snap_read_objref(ctx);
+		p->handler = duk__snap_read_objref(ctx);
+		if (p->target == NULL || p->handler == NULL) {
+			duk__snap_format_error(thr);
+		}
+		DUK_HOBJECT_INCREF(thr, p->target);
+		DUK_HOBJECT_INCREF(thr, p->handler);
+#endif
+	} else if (DUK_HOBJECT_IS_OBJENV(h)) {
+		duk_hobjenv *e = (duk_hobjenv *) h;
+		duk_hobject *target;
+		duk_hobject *old_target;
+
+		target = duk__snap_read_objref(ctx);
+		if (target == NULL) {
+			duk__snap_format_error(thr);
+		}
+		old_target = e->target;
+		DUK_UNREF(old_target);  /* unused without refcounting */
+		e->target = target;
+		DUK_HOBJECT_INCREF(thr, target);
+		DUK_HOBJECT_DECREF_ALLOWNULL(thr, old_target);
+		e->has_this = (duk_bool_t) duk__snap_read_u8(ctx);
+	} else if (DUK_HOBJECT_HAS_EXOTIC_ARRAY(h)) {
+		duk_harray *a = (duk_harray *) h;
+
+		a->length = duk__snap_read_u32(ctx);
+		a->length_nonwritable = (duk_bool_t) duk__snap_read_u8(ctx);
+	}
+
+	DUK_HOBJECT_SET_PROTOTYPE_UPDREF(thr, h, proto);
+
+	/* The heap thread keeps its own flags.  The array part may have been
+	 * abandoned while restoring properties.
+	 */
+	if (kind != DUK__SNAP_KIND_HEAP_THREAD) {
+		if (!DUK_HOBJECT_HAS_ARRAY_PART(h)) {
+			flags &= ~DUK_HOBJECT_FLAG_ARRAY_PART;
+		}
+		DUK_HEAPHDR_CLEAR_FLAG_BITS(&h->hdr, DUK__SNAP_USER_FLAGS_MASK);
+		DUK_HEAPHDR_SET_FLAG_BITS(&h->hdr, flags & DUK__SNAP_USER_FLAGS_MASK);
+#if defined(DUK_USE_ALLOC_ARENA)
+		if (flags & DUK_HOBJECT_FLAG_HAVE_FINALIZER) {
+			heap->arena.have_finalizers = 1;
+		}
+#endif
+	}
+}
+
+DUK_LOCAL void duk__snap_load_funcdata(duk__snap_load_ctx *ctx, duk_hbuffer *data) {
+	duk_hthread *thr = ctx->thr;
+	duk_uint32_t nconst, nfunc, ninstr;
+	duk_uint32_t i;
+	duk_tval *tv;
+	duk_hobject **fn;
+	duk_uint8_t *p;
+
+	nconst = duk__snap_read_u32(ctx);
+	nfunc = duk__snap_read_u32(ctx);
+	ninstr = duk__snap_read_u32(ctx);
+	if (DUK__SNAP_COMPFUNC_DATA_SIZE(nconst, nfunc, ninstr) != DUK_HBUFFER_GET_SIZE(data)) {
+		duk__snap_format_error(thr);
+	}
+
+	/* Constants and inner functions are stored without references of
+	 * their own: each function sharing the data holds the references.
+	 */
+	tv = (duk_tval *) DUK_HBUFFER_FIXED_GET_DATA_PTR(thr->heap, (duk_hbuffer_fixed *) data);
+	for (i = 0; i < nconst; i++) {
+		duk__snap_read_tval(ctx, tv++);
+	}
+	fn = (duk_hobject **) (void *) tv;
+	for (i = 0; i < nfunc; i++) {
+		duk_hobject *h;
+
+		h = duk__snap_read_objref(ctx);
+		if (h == NULL || !DUK_HOBJECT_IS_COMPFUNC(h)) {
+			duk__snap_format_error(thr);
+		}
+		*fn++ = h;
+	}
+	p = (duk_uint8_t *) (void *) fn;
+	duk__snap_read_bytes(ctx, (void *) p, (duk_size_t) ninstr * sizeof(duk_instr_t));
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+	p += (duk_size_t) ninstr * sizeof(duk_instr_t);
+	duk_memset((void *) p, (int) DUK_HCOMPFUNC_ICACHE_NONE, DUK_HCOMPFUNC_ICACHE_SIZE(ninstr));
+#endif
+}
+
+DUK_LOCAL duk_ret_t duk__load_heap_raw(duk_hthread *thr, void *udata) {
+	duk__snap_load_ctx ctx_alloc;
+	duk__snap_load_ctx *ctx = &ctx_alloc;
+	duk_heap *heap = thr->heap;
+	duk_size_t sz;
+	duk_uint32_t sym_counter[2];
+	duk_uint32_t i;
+	duk_idx_t idx_keep;
+
+	DUK_UNREF(udata);
+
+	/* [ buf ] */
+
+	duk_memzero(ctx, sizeof(*ctx));
+	ctx->thr = thr;
+	ctx->p = (const duk_uint8_t *) duk_require_buffer(thr, 0, &sz);
+	ctx->p_end = ctx->p + sz;
+	DUK_ASSERT(ctx->p != NULL || sz == 0);
+
+	if (sz < 1 + 4 + 2 + 8 + 8 ||
+	    ctx->p[0] != DUK__SNAP_MARKER) {
+		goto format_error;
+	}
+	ctx->p++;
+	if (duk__snap_read_u32(ctx) != (duk_uint32_t) DUK_VERSION ||
+	    duk__snap_read_u8(ctx) != (duk_uint8_t) sizeof(void *) ||
+	    duk__snap_read_u8(ctx) != (duk_uint8_t) sizeof(duk_tval)) {
+		goto format_error;
+	}
+	sym_counter[0] = duk__snap_read_u32(ctx);
+	sym_counter[1] = duk__snap_read_u32(ctx);
+	ctx->nstrings = duk__snap_read_u32(ctx);
+	ctx->nitems = duk__snap_read_u32(ctx);
+
+	/* Every string and item takes at least one byte, which also bounds
+	 * the table allocations below.
+	 */
+	if ((duk_size_t) ctx->nstrings + (duk_size_t) ctx->nitems > (duk_size_t) (ctx->p_end - ctx->p)) {
+		goto format_error;
+	}
+
+	ctx->strs = (duk_hstring **) duk_push_fixed_buffer_zero(thr, (duk_size_t) ctx->nstrings * sizeof(duk_hstring *));
+	ctx->items = (void **) duk_push_fixed_buffer_zero(thr, (duk_size_t) ctx->nitems * sizeof(void *));
+	ctx->kinds = (duk_uint8_t *) duk_push_fixed_buffer_zero(thr, (duk_size_t) ctx->nitems);
+	idx_keep = duk_push_bare_array(thr);
+
+	/* [ buf strs items kinds keep ] */
+
+	/* Strings are interned, then empty objects and buffers are created
+	 * so that references can be resolved while filling them in.
+	 */
+	for (i = 0; i < ctx->nstrings; i++) {
+		duk_uint32_t len;
+
+		len = duk__snap_read_u32(ctx);
+		duk__snap_need(ctx, len);
+		(void) duk_push_lstring(thr, (const char *) ctx->p, (duk_size_t) len);
+		ctx->p += len;
+		ctx->strs[i] = duk_to_interned_hstring(thr, -1);  /* may be used as a key */
+		duk_put_prop_index(thr, idx_keep, (duk_uarridx_t) i);
+	}
+	duk_push_bare_array(thr);
+	duk__snap_load_items(ctx, idx_keep + 1);
+
+	/* [ buf strs items kinds strkeep itemkeep ] */
+
+	for (i = 0; i < ctx->nitems; i++) {
+		switch (ctx->kinds[i]) {
+		case DUK__SNAP_KIND_OBJECT:
+		case DUK__SNAP_KIND_BUILTIN:
+		case DUK__SNAP_KIND_HEAP_OBJECT:
+		case DUK__SNAP_KIND_HEAP_THREAD:
+			duk__snap_load_object(ctx, (duk_hobject *) ctx->items[i], ctx->kinds[i]);
+			break;
+		case DUK__SNAP_KIND_FUNCDATA:
+			duk__snap_load_funcdata(ctx, (duk_hbuffer *) ctx->items[i]);
+			break;
+		default:
+			break;
+		}
+	}
+	if (ctx->p != ctx->p_end) {
+		goto format_error;
+	}
+
+	/* Function data is complete only now, add the references held by
+	 * each function sharing it.
+	 */
+	for (i = 0; i < ctx->nitems; i++) {
+		duk_hcompfunc *f;
+		duk_tval *tv, *tv_end;
+		duk_hobject **fn, **fn_end;
+
+		if (ctx->kinds[i] != DUK__SNAP_KIND_OBJECT ||
+		    !DUK_HOBJECT_IS_COMPFUNC((duk_hobject *) ctx->items[i])) {
+			continue;
+		}
+		f = (duk_hcompfunc *) ctx->items[i];
+		if (DUK_HCOMPFUNC_GET_DATA(heap, f) == NULL) {
+			continue;
+		}
+		tv = DUK_HCOMPFUNC_GET_CONSTS_BASE(heap, f);
+		tv_end = DUK_HCOMPFUNC_GET_CONSTS_END(heap, f);
+		while (tv < tv_end) {
+			DUK_TVAL_INCREF(thr, tv);
+			tv++;
+		}
+		fn = DUK_HCOMPFUNC_GET_FUNCS_BASE(heap, f);
+		fn_end = DUK_HCOMPFUNC_GET_FUNCS_END(heap, f);
+		while (fn < fn_end) {
+			DUK_HOBJECT_INCREF(thr, *fn);
+			fn++;
+		}
+	}
+
+	/* Symbols created after the load must not collide with symbols in
+	 * the image.
+	 */
+	if (sym_counter[1] > heap->sym_counter[1] ||
+	    (sym_counter[1] == heap->sym_counter[1] && sym_counter[0] > heap->sym_counter[0])) {
+		heap->sym_counter[0] = sym_counter[0];
+		heap->sym_counter[1] = sym_counter[1];
+	}
+
+	DUK_DD(DUK_DDPRINT("loaded heap: %ld strings, %ld items",
+	                   (long) ctx->nstrings, (long) ctx->nitems));
+	return 0;
+
+ format_error:
+	duk__snap_format_error(thr);
+	DUK_WO_NORETURN(return 0;);
+}
+
+/* Both directions run with mark-and-sweep and finalizers prevented:
+ * property tables and function data are accessed through raw pointers
+ * while allocating, and the heap is inconsistent in the middle of a load.
+ */
+DUK_LOCAL void duk__snap_call(duk_hthread *thr, duk_safe_call_function func, duk_idx_t nargs, duk_bool_t has_result) {
+	duk_heap *heap = thr->heap;
+	duk_uint_t prev_ms_prevent_count;
+	duk_uint_t prev_pf_prevent_count;
+	duk_int_t rc;
+
+	prev_ms_prevent_count = heap->ms_prevent_count;
+	prev_pf_prevent_count = heap->pf_prevent_count;
+	heap->ms_prevent_count++;
+	heap->pf_prevent_count++;
+	DUK_ASSERT(heap->ms_prevent_count != 0);  /* Wrap. */
+	DUK_ASSERT(heap->pf_prevent_count != 0);  /* Wrap. */
+
+	rc = duk_safe_call(thr, func, NULL, nargs, 1 /*nrets*/);
+
+	heap->ms_prevent_count = prev_ms_prevent_count;
+	heap->pf_prevent_count = prev_pf_prevent_count;
+	if (rc != DUK_EXEC_SUCCESS) {
+		(void) duk_throw(thr);
+		DUK_WO_NORETURN(return;);
+	}
+	if (!has_result) {
+		duk_pop_unsafe(thr);
+	}
+}
+
+DUK_EXTERNAL void duk_dump_heap(duk_hthread *thr) {
+	DUK_ASSERT_API_ENTRY(thr);
+
+	/* [ ... ] -> [ ... buf ] */
+	duk__snap_call(thr, duk__dump_heap_raw, 0 /*nargs*/, 1 /*has_result*/);
+}
+
+DUK_EXTERNAL void duk_load_heap(duk_hthread *thr) {
+	DUK_ASSERT_API_ENTRY(thr);
+
+	/* [ ... buf ] -> [ ... ] */
+	duk_require_buffer(thr, -1, NULL);
+	duk__snap_call(thr, duk__load_heap_raw, 1 /*nargs*/, 0 /*has_result*/);
+}
+
+#else  /* DUK_USE_HEAP_DUMP_SUPPORT */
+
+DUK_EXTERNAL void duk_dump_heap(duk_hthread *thr) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ERROR_UNSUPPORTED(thr);
+	DUK_WO_NORETURN(return;);
+}
+
+DUK_EXTERNAL void duk_load_heap(duk_hthread *thr) {
+	DUK_ASSERT_API_ENTRY(thr);
+	DUK_ERROR_UNSUPPORTED(thr);
+	DUK_WO_NORETURN(return;);
+}
+
+#endif  /* DUK_USE_HEAP_DUMP_SUPPORT */
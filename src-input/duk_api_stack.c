@@ -3171,6 +3171,37 @@ DUK_INTERNAL duk_hstring *duk_to_property_key_hstring(duk_hthread *thr, duk_idx_
 		h = duk_to_hstring(thr, idx);
 	}
 	DUK_ASSERT(h != NULL);
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+	if (DUK_UNLIKELY(DUK_HSTRING_HAS_UNINTERNED(h))) {
+		/* Property keys are compared by pointer. */
+		h = duk_to_interned_hstring(thr, idx);
+	}
+#endif
+	return h;
+}
+
+/* Replace the string at 'idx' with its interned version, for code which
+ * compares strings by pointer (property keys, identifiers).  Only needed
+ * with DUK_USE_HSTRING_UNINTERNED, otherwise all strings are interned.
+ */
+DUK_INTERNAL duk_hstring *duk_to_interned_hstring(duk_hthread *thr, duk_idx_t idx) {
+	duk_hstring *h;
+
+	DUK_ASSERT_API_ENTRY(thr);
+
+	h = duk_known_hstring(thr, idx);
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+	if (DUK_UNLIKELY(DUK_HSTRING_HAS_UNINTERNED(h))) {
+		/* The uninterned original stays reachable through 'idx'
+		 * while its data is interned.
+		 */
+		idx = duk_normalize_index(thr, idx);
+		h = duk_heap_strtable_intern_checked(thr, DUK_HSTRING_GET_DATA(h), DUK_HSTRING_GET_BYTELEN(h));
+		DUK_ASSERT(!DUK_HSTRING_HAS_UNINTERNED(h));
+		duk_push_hstring(thr, h);
+		duk_replace(thr, idx);
+	}
+#endif
 	return h;
 }
 
@@ -4459,7 +4490,23 @@ DUK_EXTERNAL const char *duk_push_lstring(duk_hthread *thr, const char *str, duk
 		DUK_WO_NORETURN(return NULL;);
 	}
 
-	h = duk_heap_strtable_intern_checked(thr, (const duk_uint8_t *) str, (duk_uint32_t) len);
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+	/* Long strings are not interned until they're used as property keys.
+	 * Symbols are always interned because they're compared by pointer.
+	 */
+	if (len >= DUK_HSTRING_UNINTERNED_MINLEN &&
+	    (((const duk_uint8_t *) str)[0] < 0x80U ||
+	     (((const duk_uint8_t *) str)[0] > 0x82U && ((const duk_uint8_t *) str)[0] != 0xffU))) {
+		h = duk_heap_strtable_alloc_uninterned(thr->heap, (const duk_uint8_t *) str, (duk_uint32_t) len, NULL, 0);
+		if (DUK_UNLIKELY(h == NULL)) {
+			DUK_ERROR_ALLOC_FAILED(thr);
+			DUK_WO_NORETURN(return NULL;);
+		}
+	} else
+#endif
+	{
+		h = duk_heap_strtable_intern_checked(thr, (const duk_uint8_t *) str, (duk_uint32_t) len);
+	}
 	DUK_ASSERT(h != NULL);
 
 	tv_slot = thr->valstack_top++;
@@ -4480,6 +4527,46 @@ DUK_EXTERNAL const char *duk_push_string(duk_hthread *thr, const char *str) {
 	}
 }
 
+DUK_EXTERNAL const char *duk_push_external_lstring(duk_hthread *thr, const char *str, duk_size_t len, duk_external_string_free_function free_func, void *udata) {
+	const char *ret;
+
+	DUK_ASSERT_API_ENTRY(thr);
+
+#if defined(DUK_USE_HSTRING_EXTDATA) && defined(DUK_USE_HSTRING_UNINTERNED)
+	/* Long strings reference the caller's data directly.  Short strings
+	 * and symbols must be interned so they're copied like for
+	 * duk_push_lstring().
+	 */
+	if (str != NULL && len >= DUK_HSTRING_UNINTERNED_MINLEN && len <= DUK_HSTRING_MAX_BYTELEN &&
+	    (((const duk_uint8_t *) str)[0] < 0x80U ||
+	     (((const duk_uint8_t *) str)[0] > 0x82U && ((const duk_uint8_t *) str)[0] != 0xffU))) {
+		duk_hstring *h;
+		duk_tval *tv_slot;
+
+		DUK__CHECK_SPACE();
+		h = duk_heap_strtable_alloc_external(thr->heap, (const duk_uint8_t *) str, (duk_uint32_t) len, free_func, udata);
+		if (DUK_UNLIKELY(h == NULL)) {
+			DUK_ERROR_ALLOC_FAILED(thr);
+			DUK_WO_NORETURN(return NULL;);
+		}
+
+		tv_slot = thr->valstack_top++;
+		DUK_TVAL_SET_STRING(tv_slot, h);
+		DUK_HSTRING_INCREF(thr, h);  /* no side effects */
+		return str;
+	}
+#endif
+
+	/* Copy, the data is no longer needed once the push succeeds.  If
+	 * the push throws the caller still owns the data.
+	 */
+	ret = duk_push_lstring(thr, str, len);
+	if (free_func != NULL && str != NULL) {
+		free_func(udata, str, len);
+	}
+	return ret;
+}
+
 #if !defined(DUK_USE_PREFER_SIZE)
 #if defined(DUK_USE_LITCACHE_SIZE)
 DUK_EXTERNAL const char *duk_push_literal_raw(duk_hthread *thr, const char *str, duk_size_t len) {
@@ -4859,13 +4946,21 @@ DUK_INTERNAL duk_hobject *duk_push_object_helper_proto(duk_hthread *thr, duk_uin
 }
 
 DUK_EXTERNAL duk_idx_t duk_push_object(duk_hthread *thr) {
+	duk_hobject *h;
+
 	DUK_ASSERT_API_ENTRY(thr);
 
-	(void) duk_push_object_helper(thr,
-	                              DUK_HOBJECT_FLAG_EXTENSIBLE |
-	                              DUK_HOBJECT_FLAG_FASTREFS |
-	                              DUK_HOBJECT_CLASS_AS_FLAGS(DUK_HOBJECT_CLASS_OBJECT),
-	                              DUK_BIDX_OBJECT_PROTOTYPE);
+	h = duk_push_object_helper(thr,
+	                           DUK_HOBJECT_FLAG_EXTENSIBLE |
+	                           DUK_HOBJECT_FLAG_FASTREFS |
+	                           DUK_HOBJECT_CLASS_AS_FLAGS(DUK_HOBJECT_CLASS_OBJECT),
+	                           DUK_BIDX_OBJECT_PROTOTYPE);
+	DUK_ASSERT(h != NULL);
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	duk_hshape_attach_root(thr->heap, h);
+#else
+	DUK_UNREF(h);
+#endif
 	return duk_get_top_index_unsafe(thr);
 }
 
@@ -5604,6 +5699,8 @@ DUK_EXTERNAL duk_idx_t duk_push_proxy(duk_hthread *thr, duk_uint_t proxy_flags)
 	h_proxy->target = h_target;
 	DUK_ASSERT(h_handler != NULL);
 	h_proxy->handler = h_handler;
+	DUK_HEAPHDR_MARK_BARRIER(thr, h_target);
+	DUK_HEAPHDR_MARK_BARRIER(thr, h_handler);
 	DUK_HPROXY_ASSERT_VALID(h_proxy);
 
 	DUK_ASSERT(duk_get_hobject(thr, -2) == h_target);
@@ -6183,6 +6280,7 @@ DUK_INTERNAL void duk_pack(duk_hthread *thr, duk_idx_t count) {
 	 */
 	tv_src = thr->valstack_top - count - 1;
 	duk_memcpy_unsafe((void *) tv_dst, (const void *) tv_src, (size_t) count * sizeof(duk_tval));
+	DUK_TVALS_MARK_BARRIER(thr, tv_dst, count);
 
 	/* Overwrite result array to final value stack location and wipe
 	 * the rest; no refcount operations needed.
@@ -139,6 +139,34 @@ DUK_INTERNAL void duk_concat_2(duk_hthread *thr) {
 	                 len > (duk_size_t) DUK_HSTRING_MAX_BYTELEN)) {
 		goto error_overflow;
 	}
+
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+	/* Long results are not interned.  This avoids hashing them, and
+	 * allows the executor to append to them in place.
+	 */
+	if (len >= DUK_HSTRING_UNINTERNED_MINLEN &&
+	    !DUK_HSTRING_HAS_SYMBOL(h1) && !DUK_HSTRING_HAS_SYMBOL(h2)) {
+		duk_hstring *res;
+
+		res = duk_heap_strtable_alloc_uninterned(thr->heap,
+		                                         DUK_HSTRING_GET_DATA(h1),
+		                                         (duk_uint32_t) len1,
+		                                         DUK_HSTRING_GET_DATA(h2),
+		                                         (duk_uint32_t) len2);
+		if (DUK_UNLIKELY(res == NULL)) {
+			DUK_ERROR_ALLOC_FAILED(thr);
+			DUK_WO_NORETURN(return;);
+		}
+		duk_push_hstring(thr, res);
+
+		/* [ ... str1 str2 res ] */
+
+		duk_replace(thr, -3);
+		duk_pop_unsafe(thr);
+		return;
+	}
+#endif
+
 	buf = (duk_uint8_t *) duk_push_fixed_buffer_nozero(thr, len);
 	DUK_ASSERT(buf != NULL);
 
@@ -233,7 +261,9 @@ DUK_EXTERNAL void duk_map_string(duk_hthread *thr, duk_idx_t idx, duk_map_char_f
 
 DUK_EXTERNAL void duk_substring(duk_hthread *thr, duk_idx_t idx, duk_size_t start_offset, duk_size_t end_offset) {
 	duk_hstring *h;
+#if !defined(DUK_USE_HSTRING_UNINTERNED)
 	duk_hstring *res;
+#endif
 	duk_size_t start_byte_offset;
 	duk_size_t end_byte_offset;
 	duk_size_t charlen;
@@ -268,11 +298,18 @@ DUK_EXTERNAL void duk_substring(duk_hthread *thr, duk_idx_t idx, duk_size_t star
 	DUK_ASSERT(end_byte_offset - start_byte_offset <= DUK_UINT32_MAX);  /* Guaranteed by string limits. */
 
 	/* No size check is necessary. */
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+	/* Long substrings may be uninterned, see duk_push_lstring(). */
+	(void) duk_push_lstring(thr,
+	                        (const char *) (DUK_HSTRING_GET_DATA(h) + start_byte_offset),
+	                        (duk_size_t) (end_byte_offset - start_byte_offset));
+#else
 	res = duk_heap_strtable_intern_checked(thr,
 	                                       DUK_HSTRING_GET_DATA(h) + start_byte_offset,
 	                                       (duk_uint32_t) (end_byte_offset - start_byte_offset));
 
 	duk_push_hstring(thr, res);
+#endif
 	duk_replace(thr, idx);
 }
 
@@ -557,6 +557,7 @@ DUK_LOCAL duk_ret_t duk__array_push_fastpath(duk_hthread *thr, duk_harray *h_arr
 		tv_src++;
 		tv_dst++;
 	}
+	DUK_TVALS_MARK_BARRIER(thr, tv_arraypart + len, n);
 	thr->valstack_top = thr->valstack_bottom;
 	len += (duk_uint32_t) n;
 	h_arr->length = len;
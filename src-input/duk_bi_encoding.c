@@ -279,6 +279,23 @@ DUK_LOCAL duk_ret_t duk__decode_helper(duk_hthread *thr, duk__decode_context *de
 	in = input;
 	out = output;
 	while (in < input + len) {
+#if !defined(DUK_USE_PREFER_SIZE)
+		/* ASCII runs outside a multibyte sequence decode to themselves
+		 * and can't contain a BOM, so copy them as is.
+		 */
+		if (dec_ctx->needed == 0 && *in < 0x80U) {
+			duk_size_t n;
+
+			n = duk_unicode_ascii_prefix_length(in, (duk_size_t) (input + len - in));
+			DUK_ASSERT(n >= 1);
+			duk_memcpy((void *) out, (const void *) in, n);
+			in += n;
+			out += n;
+			dec_ctx->bom_handled = 1;
+			DUK_ASSERT(out <= output + (3 + (3 * len)));
+			continue;
+		}
+#endif
 		codepoint = duk__utf8_decode_next(dec_ctx, *in++);
 		if (codepoint < 0) {
 			if (codepoint == DUK__CP_CONTINUE) {
@@ -99,6 +99,7 @@ DUK_INTERNAL duk_ret_t duk_bi_object_constructor_is(duk_hthread *thr) {
 #if defined(DUK_USE_OBJECT_BUILTIN)
 DUK_INTERNAL duk_ret_t duk_bi_object_constructor_create(duk_hthread *thr) {
 	duk_hobject *proto;
+	duk_hobject *h;
 
 	DUK_ASSERT_TOP(thr, 2);
 
@@ -108,11 +109,17 @@ DUK_INTERNAL duk_ret_t duk_bi_object_constructor_create(duk_hthread *thr) {
 	proto = duk_require_hobject_accept_mask(thr, 0, DUK_TYPE_MASK_NULL);
 	DUK_ASSERT(proto != NULL || duk_is_null(thr, 0));
 
-	(void) duk_push_object_helper_proto(thr,
-	                                    DUK_HOBJECT_FLAG_EXTENSIBLE |
-	                                    DUK_HOBJECT_FLAG_FASTREFS |
-	                                    DUK_HOBJECT_CLASS_AS_FLAGS(DUK_HOBJECT_CLASS_OBJECT),
-	                                    proto);
+	h = duk_push_object_helper_proto(thr,
+	                                 DUK_HOBJECT_FLAG_EXTENSIBLE |
+	                                 DUK_HOBJECT_FLAG_FASTREFS |
+	                                 DUK_HOBJECT_CLASS_AS_FLAGS(DUK_HOBJECT_CLASS_OBJECT),
+	                                 proto);
+	DUK_ASSERT(h != NULL);
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	duk_hshape_attach_root(thr->heap, h);
+#else
+	DUK_UNREF(h);
+#endif
 
 	if (!duk_is_undefined(thr, 1)) {
 		/* [ O Properties obj ] */
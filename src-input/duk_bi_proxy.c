@@ -30,6 +30,7 @@ DUK_INTERNAL void duk_proxy_ownkeys_postprocess(duk_hthread *thr, duk_hobject *h
 			DUK_ERROR_TYPE_INVALID_TRAP_RESULT(thr);
 			DUK_WO_NORETURN(return;);
 		}
+		h = duk_to_interned_hstring(thr, -1);  /* used as a key */
 
 		if (!(flags & DUK_ENUM_INCLUDE_NONENUMERABLE)) {
 			/* No support for 'getOwnPropertyDescriptor' trap yet,
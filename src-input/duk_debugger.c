@@ -419,7 +419,8 @@ DUK_LOCAL duk_hstring *duk__debug_read_hstring_raw(duk_hthread *thr, duk_uint32_
 		(void) duk_buffer_to_string(thr, -1);  /* Safety relies on debug client, which is OK. */
 	}
 
-	return duk_require_hstring(thr, -1);
+	/* Variable names and property keys are looked up by pointer. */
+	return duk_to_interned_hstring(thr, -1);
 }
 
 DUK_INTERNAL duk_hstring *duk_debug_read_hstring(duk_hthread *thr) {
@@ -22,6 +22,7 @@ struct duk_harray;
 struct duk_hstring;
 struct duk_hstring_external;
 struct duk_hobject;
+struct duk_hshape;
 struct duk_hcompfunc;
 struct duk_hnatfunc;
 struct duk_hboundfunc;
@@ -48,6 +49,12 @@ struct duk_ljstate;
 struct duk_strcache_entry;
 struct duk_litcache_entry;
 struct duk_strtab_entry;
+struct duk_slab_page;
+struct duk_slab;
+union duk_arena_hdr;
+struct duk_arena_chunk;
+struct duk_arena_large;
+struct duk_arena;
 
 #if defined(DUK_USE_DEBUG)
 struct duk_fixedbuffer;
@@ -83,6 +90,7 @@ typedef struct duk_harray duk_harray;
 typedef struct duk_hstring duk_hstring;
 typedef struct duk_hstring_external duk_hstring_external;
 typedef struct duk_hobject duk_hobject;
+typedef struct duk_hshape duk_hshape;
 typedef struct duk_hcompfunc duk_hcompfunc;
 typedef struct duk_hnatfunc duk_hnatfunc;
 typedef struct duk_hboundfunc duk_hboundfunc;
@@ -109,6 +117,12 @@ typedef struct duk_ljstate duk_ljstate;
 typedef struct duk_strcache_entry duk_strcache_entry;
 typedef struct duk_litcache_entry duk_litcache_entry;
 typedef struct duk_strtab_entry duk_strtab_entry;
+typedef struct duk_slab_page duk_slab_page;
+typedef struct duk_slab duk_slab;
+typedef union duk_arena_hdr duk_arena_hdr;
+typedef struct duk_arena_chunk duk_arena_chunk;
+typedef struct duk_arena_large duk_arena_large;
+typedef struct duk_arena duk_arena;
 
 #if defined(DUK_USE_DEBUG)
 typedef struct duk_fixedbuffer duk_fixedbuffer;
@@ -30,6 +30,13 @@
 #define DUK_HCOMPFUNC_SET_BYTECODE(heap,h,v)  do { \
 		(h)->bytecode16 = DUK_USE_HEAPPTR_ENC16((heap)->heap_udata, (void *) (v)); \
 	} while (0)
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+#define DUK_HCOMPFUNC_GET_ICACHE(heap,h)  \
+	((duk_uint8_t *) (void *) (DUK_USE_HEAPPTR_DEC16((heap)->heap_udata, (h)->icache16)))
+#define DUK_HCOMPFUNC_SET_ICACHE(heap,h,v)  do { \
+		(h)->icache16 = DUK_USE_HEAPPTR_ENC16((heap)->heap_udata, (void *) (v)); \
+	} while (0)
+#endif
 #define DUK_HCOMPFUNC_GET_LEXENV(heap,h)  \
 	((duk_hobject *) (void *) (DUK_USE_HEAPPTR_DEC16((heap)->heap_udata, (h)->lex_env16)))
 #define DUK_HCOMPFUNC_SET_LEXENV(heap,h,v)  do { \
@@ -53,6 +60,12 @@
 #define DUK_HCOMPFUNC_SET_BYTECODE(heap,h,v)  do { \
 		(h)->bytecode = (v); \
 	} while (0)
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+#define DUK_HCOMPFUNC_GET_ICACHE(heap,h)  ((h)->icache)
+#define DUK_HCOMPFUNC_SET_ICACHE(heap,h,v)  do { \
+		(h)->icache = (v); \
+	} while (0)
+#endif
 #define DUK_HCOMPFUNC_GET_LEXENV(heap,h)  ((h)->lex_env)
 #define DUK_HCOMPFUNC_SET_LEXENV(heap,h,v)  do { \
 		(h)->lex_env = (v); \
@@ -86,10 +99,16 @@
 #define DUK_HCOMPFUNC_GET_FUNCS_END(heap,h)  \
 	((duk_hobject **) (void *) DUK_HCOMPFUNC_GET_BYTECODE((heap), (h)))
 
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+/* Inline cache follows bytecode directly. */
+#define DUK_HCOMPFUNC_GET_CODE_END(heap,h)  \
+	((duk_instr_t *) (void *) DUK_HCOMPFUNC_GET_ICACHE((heap), (h)))
+#else
 /* XXX: double evaluation of DUK_HCOMPFUNC_GET_DATA() */
 #define DUK_HCOMPFUNC_GET_CODE_END(heap,h)  \
 	((duk_instr_t *) (void *) (DUK_HBUFFER_FIXED_GET_DATA_PTR((heap), DUK_HCOMPFUNC_GET_DATA((heap), (h))) + \
 	                DUK_HBUFFER_GET_SIZE((duk_hbuffer *) DUK_HCOMPFUNC_GET_DATA((heap), h))))
+#endif
 
 #define DUK_HCOMPFUNC_GET_CONSTS_SIZE(heap,h)  \
 	( \
@@ -127,6 +146,30 @@
 #define DUK_HCOMPFUNC_GET_CODE_COUNT(heap,h)  \
 	((duk_size_t) (DUK_HCOMPFUNC_GET_CODE_SIZE((heap), (h)) / sizeof(duk_instr_t)))
 
+/*
+ *  Inline cache
+ *
+ *  Each instruction has DUK_HCOMPFUNC_ICACHE_WAYS one-byte entries, indexed
+ *  by PC.  Only property access instructions with a constant key use them.
+ *  An entry is an entry part slot index where the key was last found, with
+ *  DUK_HCOMPFUNC_ICACHE_PROTO set if the slot is in the receiver's internal
+ *  prototype rather than the receiver itself.  Entries are just guesses: the
+ *  key in the slot is always compared before a cached slot is used.  When a
+ *  lookup can't be cached (e.g. property not found, or found further up the
+ *  prototype chain) a SKIP entry makes the next few executions go directly
+ *  to the generic lookup.
+ */
+
+#define DUK_HCOMPFUNC_ICACHE_WAYS        2
+#define DUK_HCOMPFUNC_ICACHE_NONE        0xffU   /* unused entry */
+#define DUK_HCOMPFUNC_ICACHE_SKIP_MIN    0xf0U   /* 0xf0-0xfe: countdown to retry after an uncacheable lookup */
+#define DUK_HCOMPFUNC_ICACHE_SKIP_MAX    0xfeU
+#define DUK_HCOMPFUNC_ICACHE_PROTO       0x80U   /* slot is in receiver's prototype */
+#define DUK_HCOMPFUNC_ICACHE_SLOT_MASK   0x7fU
+#define DUK_HCOMPFUNC_ICACHE_MAX_SLOT    0x6fU   /* higher values would collide with SKIP/NONE for prototype slots */
+
+#define DUK_HCOMPFUNC_ICACHE_SIZE(code_count)  ((duk_size_t) (code_count) * DUK_HCOMPFUNC_ICACHE_WAYS)
+
 /*
  *  Validity assert
  */
@@ -155,6 +198,7 @@ struct duk_hcompfunc {
 	 *    constants (duk_tval)
 	 *    inner functions (duk_hobject *)
 	 *    bytecode (duk_instr_t)
+	 *    inline cache (duk_uint8_t), if DUK_USE_EXEC_INLINE_CACHE
 	 *
 	 *  Note: bytecode end address can be computed from 'data' buffer
 	 *  size.  It is not strictly necessary functionally, assuming
@@ -189,6 +233,17 @@ struct duk_hcompfunc {
 	duk_instr_t *bytecode;
 #endif
 
+	/* Inline cache area at the end of 'data', shared (and updated) by
+	 * all closures of the same template.  Also marks bytecode end.
+	 */
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+#if defined(DUK_USE_HEAPPTR16)
+	duk_uint16_t icache16;
+#else
+	duk_uint8_t *icache;
+#endif
+#endif
+
 	/* Lexenv: lexical environment of closure, NULL for templates.
 	 * Varenv: variable environment of closure, NULL for templates.
 	 */
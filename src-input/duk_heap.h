@@ -80,6 +80,16 @@
  */
 #define DUK_MS_FLAG_NO_OBJECT_COMPACTION     (1U << 2)
 
+/* Voluntary GC request which may be satisfied by running a single slice
+ * of an incremental collection (DUK_USE_MARK_AND_SWEEP_INCREMENTAL).
+ */
+#define DUK_MS_FLAG_INCREMENTAL              (1U << 3)
+
+/* Voluntary GC request which may be satisfied by a minor collection of
+ * the young generation (DUK_USE_MARK_AND_SWEEP_GENERATIONAL).
+ */
+#define DUK_MS_FLAG_MINOR                    (1U << 4)
+
 /*
  *  Thread switching
  *
@@ -132,6 +142,30 @@
 #define DUK_HEAP_MARK_AND_SWEEP_TRIGGER_SKIP              256L
 #endif
 
+/* Incremental mark-and-sweep phases and the number of (re)allocations
+ * between slices while a cycle is in progress.
+ */
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+#define DUK_HEAP_MS_INCR_IDLE                             0  /* no cycle in progress */
+#define DUK_HEAP_MS_INCR_MARK                             1  /* marking, write barrier active */
+#define DUK_HEAP_MS_INCR_FINALIZE                         2  /* refcount finalizing unreachable objects */
+#define DUK_HEAP_MS_INCR_SWEEP                            3  /* sweeping heap_allocated */
+#define DUK_HEAP_MARK_AND_SWEEP_INCR_INTERVAL             256L
+#endif
+
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+#error DUK_USE_MARK_AND_SWEEP_GENERATIONAL and DUK_USE_MARK_AND_SWEEP_INCREMENTAL are mutually exclusive
+#endif
+#if (DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE < 1)
+#error DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE must be at least 1
+#endif
+/* First object of the old generation in heap_allocated, NULL if none. */
+#define DUK_HEAP_GEN_OLD_START(heap)  ((heap)->ms_gen_bounds[DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE - 1])
+/* Number of (re)allocations between minor collections. */
+#define DUK_HEAP_MARK_AND_SWEEP_GEN_TRIGGER               32768L
+#endif
+
 /* GC torture. */
 #if defined(DUK_USE_GC_TORTURE)
 #define DUK_GC_TORTURE(heap) do { duk_heap_mark_and_sweep((heap), 0); } while (0)
@@ -142,7 +176,10 @@
 /* Stringcache is used for speeding up char-offset-to-byte-offset
  * translations for non-ASCII strings.
  */
-#define DUK_HEAP_STRCACHE_SIZE                            4
+#if !defined(DUK_USE_STRCACHE_SIZE) || (DUK_USE_STRCACHE_SIZE < 1)
+#error DUK_USE_STRCACHE_SIZE must be at least 1
+#endif
+#define DUK_HEAP_STRCACHE_SIZE                            DUK_USE_STRCACHE_SIZE
 #define DUK_HEAP_STRINGCACHE_NOCACHE_LIMIT                16  /* strings up to the this length are not cached */
 
 /* Some list management macros. */
@@ -177,6 +214,25 @@
  *  Raw memory calls: relative to heap, but no GC interaction
  */
 
+#if defined(DUK_USE_ALLOC_SLAB)
+#define DUK_ALLOC_RAW(heap,size) \
+	duk_heap_slab_alloc((heap), (size))
+
+#define DUK_REALLOC_RAW(heap,ptr,newsize) \
+	duk_heap_slab_realloc((heap), (void *) (ptr), (newsize))
+
+#define DUK_FREE_RAW(heap,ptr) \
+	duk_heap_slab_free((heap), (void *) (ptr))
+#elif defined(DUK_USE_ALLOC_ARENA)
+#define DUK_ALLOC_RAW(heap,size) \
+	duk_heap_arena_alloc((heap), (size))
+
+#define DUK_REALLOC_RAW(heap,ptr,newsize) \
+	duk_heap_arena_realloc((heap), (void *) (ptr), (newsize))
+
+#define DUK_FREE_RAW(heap,ptr) \
+	duk_heap_arena_free((heap), (void *) (ptr))
+#else
 #define DUK_ALLOC_RAW(heap,size) \
 	((heap)->alloc_func((heap)->heap_udata, (size)))
 
@@ -185,6 +241,7 @@
 
 #define DUK_FREE_RAW(heap,ptr) \
 	((heap)->free_func((heap)->heap_udata, (void *) (ptr)))
+#endif
 
 /*
  *  Memory calls: relative to heap, GC interaction, but no error throwing.
@@ -322,6 +379,78 @@ struct duk_ljstate {
 		DUK_ASSERT(heap->lj.type != DUK_LJ_TYPE_UNKNOWN); \
 	} while (0)
 
+/*
+ *  Slab allocator (DUK_USE_ALLOC_SLAB), see duk_heap_slab.c.
+ */
+
+#if defined(DUK_USE_ALLOC_SLAB)
+#define DUK_HEAP_SLAB_PAGE_SHIFT    12
+#define DUK_HEAP_SLAB_PAGE_SIZE     (1U << DUK_HEAP_SLAB_PAGE_SHIFT)
+#define DUK_HEAP_SLAB_MAX_SIZE      256   /* largest allocation served from slab pages */
+#define DUK_HEAP_SLAB_NUM_CLASSES   24    /* 8..128 in steps of 8, 144..256 in steps of 16 */
+
+struct duk_slab_page {
+	duk_slab_page *next;      /* pages of the same class with free chunks */
+	duk_slab_page *prev;
+	void *free_list;          /* chunks freed back to the page */
+	duk_uint16_t used;        /* chunks currently allocated */
+	duk_uint16_t fresh;       /* chunks [fresh, end) have never been allocated */
+	duk_uint8_t cls;          /* size class */
+};
+
+struct duk_slab {
+	duk_slab_page *avail[DUK_HEAP_SLAB_NUM_CLASSES];   /* pages with free chunks */
+	duk_uint8_t empty[DUK_HEAP_SLAB_NUM_CLASSES];      /* number of empty pages kept */
+
+	/* Open addressing hash table of pages, keyed by the page index
+	 * (address >> DUK_HEAP_SLAB_PAGE_SHIFT) of the page start.
+	 */
+	duk_slab_page **pages;
+	duk_uint32_t pages_size;  /* power of two, 0 if not allocated */
+	duk_uint32_t pages_used;
+};
+#endif  /* DUK_USE_ALLOC_SLAB */
+
+/*
+ *  Arena allocator (DUK_USE_ALLOC_ARENA), see duk_heap_arena.c.
+ */
+
+#if defined(DUK_USE_ALLOC_ARENA)
+#define DUK_HEAP_ARENA_CHUNK_SIZE       65536
+#define DUK_HEAP_ARENA_MAX_CLASS_SIZE   4096  /* larger blocks come directly from the allocation functions */
+#define DUK_HEAP_ARENA_NUM_CLASSES      48    /* 8..256 in steps of 8, then 4 classes per power of two */
+
+/* Block header preceding each arena block, 8 bytes to keep alignment. */
+union duk_arena_hdr {
+	duk_size_t capacity;      /* usable size, low bit set for large blocks */
+	duk_double_t align;
+};
+
+struct duk_arena_chunk {
+	duk_arena_chunk *next;
+};
+
+/* Header of a large block, immediately followed by the block. */
+struct duk_arena_large {
+	duk_arena_large *next;
+	duk_arena_large *prev;
+	duk_arena_hdr hdr;
+};
+
+struct duk_arena {
+	void *free[DUK_HEAP_ARENA_NUM_CLASSES];   /* freed blocks by size class */
+	duk_uint8_t *curr;          /* bump pointer in the current chunk */
+	duk_uint8_t *end;
+	duk_arena_chunk *chunks;    /* all chunks, current chunk first */
+	duk_arena_large *large;     /* live large blocks */
+
+	/* Set when a finalizer has been set on any object.  Heap destruction
+	 * skips finalizer processing entirely when not set.
+	 */
+	duk_small_uint_t have_finalizers;
+};
+#endif  /* DUK_USE_ALLOC_ARENA */
+
 /*
  *  Literal intern cache
  */
@@ -355,6 +484,19 @@ struct duk_heap {
 	 */
 	void *heap_udata;
 
+#if defined(DUK_USE_ALLOC_SLAB)
+	/* Slab allocator for small allocations, pages come from the
+	 * allocator functions above.
+	 */
+	duk_slab slab;
+#endif
+#if defined(DUK_USE_ALLOC_ARENA)
+	/* Bump pointer arena, chunks come from the allocator functions
+	 * above and are released as a whole at heap destruction.
+	 */
+	duk_arena arena;
+#endif
+
 	/* Fatal error handling, called e.g. when a longjmp() is needed but
 	 * lj.jmpbuf_ptr is NULL.  fatal_func must never return; it's not
 	 * declared as "noreturn" because doing that for typedefs is a bit
@@ -429,6 +571,38 @@ struct duk_heap {
 	 */
 	duk_uint_t ms_prevent_count;
 
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	/* Incremental mark-and-sweep state.  While marking, gray objects
+	 * have both REACHABLE and TEMPROOT set and the RECLIMIT_REACHED heap
+	 * flag indicates that some gray objects may remain.  The cursor is
+	 * the next heap_allocated entry to process; the sweep start is the
+	 * first heap_allocated entry existing when marking finished (objects
+	 * allocated later are inserted before it and are not swept).
+	 */
+	duk_small_uint_t ms_incr_phase;
+	duk_small_uint_t ms_incr_flags;
+	duk_small_uint_t ms_incr_passes;
+	duk_heaphdr *ms_incr_cursor;
+	duk_heaphdr *ms_incr_sweep_start;
+	duk_size_t ms_incr_count_keep;
+#endif
+
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	/* Generational mark-and-sweep state.  Objects are inserted at the
+	 * heap_allocated head so the young generation is a prefix of the
+	 * list, split into bands by the number of minor collections
+	 * survived: ms_gen_bounds[i] is the first object which has survived
+	 * at least i+1 minor collections, and the last bound is the first
+	 * old object.  Old objects have REACHABLE set outside of full
+	 * collections so that minor collection marking stops at them.
+	 */
+	duk_heaphdr *ms_gen_bounds[DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE];
+	duk_small_uint_t ms_gen_minor;    /* minor collection running */
+	duk_small_int_t ms_gen_adjust;    /* refcount adjustment applied by marking functions, 0 if none */
+	duk_size_t ms_gen_promoted;       /* objects promoted since the last full collection */
+	duk_size_t ms_gen_old_limit;      /* full collection when ms_gen_promoted reaches this */
+#endif
+
 	/* Finalizer processing prevent count, stacking.  Bumped when finalizers
 	 * are processed to prevent recursive finalizer processing (first call site
 	 * processing finalizers handles all finalizers until the list is empty).
@@ -483,6 +657,11 @@ struct duk_heap {
 	/* Heap level "stash" object (e.g., various reachability roots). */
 	duk_hobject *heap_object;
 
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	/* Root of the object shape transition tree (empty shape). */
+	duk_hshape shape_root;
+#endif
+
 	/* duk_handle_call / duk_handle_safe_call recursion depth limiting */
 	duk_int_t call_recursion_depth;
 	duk_int_t call_recursion_limit;
@@ -682,6 +861,13 @@ DUK_INTERNAL_DECL duk_hstring *duk_heap_strtable_intern_literal_checked(duk_hthr
 #endif
 DUK_INTERNAL_DECL duk_hstring *duk_heap_strtable_intern_u32(duk_heap *heap, duk_uint32_t val);
 DUK_INTERNAL_DECL duk_hstring *duk_heap_strtable_intern_u32_checked(duk_hthread *thr, duk_uint32_t val);
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+DUK_INTERNAL_DECL duk_hstring *duk_heap_strtable_alloc_uninterned(duk_heap *heap, const duk_uint8_t *str1, duk_uint32_t blen1, const duk_uint8_t *str2, duk_uint32_t blen2);
+#if defined(DUK_USE_HSTRING_EXTDATA)
+DUK_INTERNAL_DECL duk_hstring *duk_heap_strtable_alloc_external(duk_heap *heap, const duk_uint8_t *str, duk_uint32_t blen, duk_external_string_free_function free_func, void *free_udata);
+#endif
+DUK_INTERNAL_DECL duk_bool_t duk_heap_strtable_append_uninterned(duk_heap *heap, duk_hstring *h, duk_hstring *h_add);
+#endif
 #if defined(DUK_USE_REFERENCE_COUNTING)
 DUK_INTERNAL_DECL void duk_heap_strtable_unlink(duk_heap *heap, duk_hstring *h);
 #endif
@@ -695,6 +881,22 @@ DUK_INTERNAL void duk_heap_strtable_dump(duk_heap *heap);
 DUK_INTERNAL_DECL void duk_heap_strcache_string_remove(duk_heap *heap, duk_hstring *h);
 DUK_INTERNAL_DECL duk_uint_fast32_t duk_heap_strcache_offset_char2byte(duk_hthread *thr, duk_hstring *h, duk_uint_fast32_t char_offset);
 
+#if defined(DUK_USE_ALLOC_SLAB)
+DUK_INTERNAL_DECL void duk_heap_slab_init(duk_heap *heap);
+DUK_INTERNAL_DECL void duk_heap_slab_free_all(duk_heap *heap);
+DUK_INTERNAL_DECL void duk_heap_slab_trim(duk_heap *heap);
+DUK_INTERNAL_DECL void *duk_heap_slab_alloc(duk_heap *heap, duk_size_t size);
+DUK_INTERNAL_DECL void *duk_heap_slab_realloc(duk_heap *heap, void *ptr, duk_size_t newsize);
+DUK_INTERNAL_DECL void duk_heap_slab_free(duk_heap *heap, void *ptr);
+#endif
+#if defined(DUK_USE_ALLOC_ARENA)
+DUK_INTERNAL_DECL void duk_heap_arena_init(duk_heap *heap);
+DUK_INTERNAL_DECL void duk_heap_arena_free_all(duk_heap *heap);
+DUK_INTERNAL_DECL void *duk_heap_arena_alloc(duk_heap *heap, duk_size_t size);
+DUK_INTERNAL_DECL void *duk_heap_arena_realloc(duk_heap *heap, void *ptr, duk_size_t newsize);
+DUK_INTERNAL_DECL void duk_heap_arena_free(duk_heap *heap, void *ptr);
+#endif
+
 #if defined(DUK_USE_PROVIDE_DEFAULT_ALLOC_FUNCTIONS)
 DUK_INTERNAL_DECL void *duk_default_alloc_function(void *udata, duk_size_t size);
 DUK_INTERNAL_DECL void *duk_default_realloc_function(void *udata, void *ptr, duk_size_t newsize);
@@ -717,6 +919,10 @@ DUK_INTERNAL_DECL void duk_heap_process_finalize_list(duk_heap *heap);
 #endif  /* DUK_USE_FINALIZER_SUPPORT */
 
 DUK_INTERNAL_DECL void duk_heap_mark_and_sweep(duk_heap *heap, duk_small_uint_t flags);
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+DUK_INTERNAL_DECL void duk_heap_mark_barrier(duk_heap *heap, duk_heaphdr *h);
+DUK_INTERNAL_DECL void duk_heap_mark_barrier_tvals(duk_heap *heap, duk_tval *tv, duk_size_t count);
+#endif
 
 DUK_INTERNAL_DECL duk_uint32_t duk_heap_hashstring(duk_heap *heap, const duk_uint8_t *str, duk_size_t len);
 
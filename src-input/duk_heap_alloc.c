@@ -23,6 +23,11 @@ DUK_INTERNAL void duk_free_hobject(duk_heap *heap, duk_hobject *h) {
 	DUK_ASSERT(h != NULL);
 
 	DUK_FREE(heap, DUK_HOBJECT_GET_PROPS(heap, h));
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	if (DUK_HOBJECT_GET_SHAPE(h) != NULL) {
+		duk_hshape_release(heap, DUK_HOBJECT_GET_SHAPE(h));
+	}
+#endif
 
 	if (DUK_HOBJECT_IS_COMPFUNC(h)) {
 		duk_hcompfunc *f = (duk_hcompfunc *) h;
@@ -93,11 +98,30 @@ DUK_INTERNAL void duk_free_hstring(duk_heap *heap, duk_hstring *h) {
 	DUK_UNREF(heap);
 	DUK_UNREF(h);
 
+#if defined(DUK_USE_HSTRING_EXTDATA) && defined(DUK_USE_HSTRING_UNINTERNED)
+	if (DUK_HSTRING_HAS_EXTDATA(h) && DUK_HSTRING_HAS_UNINTERNED(h)) {
+		/* Created using duk_push_external_lstring(). */
+		duk_hstring_external *h_ext = (duk_hstring_external *) h;
+
+		DUK_DDD(DUK_DDDPRINT("free external string: hstring %!O, extdata: %p",
+		                     h, DUK_HSTRING_GET_EXTDATA(h_ext)));
+		if (h_ext->free_func != NULL) {
+			h_ext->free_func(h_ext->free_udata, (const char *) DUK_HSTRING_GET_EXTDATA(h_ext), (duk_size_t) DUK_HSTRING_GET_BYTELEN(h));
+		}
+	} else
+#endif
+	{
 #if defined(DUK_USE_HSTRING_EXTDATA) && defined(DUK_USE_EXTSTR_FREE)
-	if (DUK_HSTRING_HAS_EXTDATA(h)) {
-		DUK_DDD(DUK_DDDPRINT("free extstr: hstring %!O, extdata: %p",
-		                     h, DUK_HSTRING_GET_EXTDATA((duk_hstring_external *) h)));
-		DUK_USE_EXTSTR_FREE(heap->heap_udata, (const void *) DUK_HSTRING_GET_EXTDATA((duk_hstring_external *) h));
+		if (DUK_HSTRING_HAS_EXTDATA(h)) {
+			DUK_DDD(DUK_DDDPRINT("free extstr: hstring %!O, extdata: %p",
+			                     h, DUK_HSTRING_GET_EXTDATA((duk_hstring_external *) h)));
+			DUK_USE_EXTSTR_FREE(heap->heap_udata, (const void *) DUK_HSTRING_GET_EXTDATA((duk_hstring_external *) h));
+		}
+#endif
+	}
+#if defined(DUK_USE_HSTRING_CHARIDX)
+	if (h->charidx != NULL) {
+		DUK_FREE(heap, (void *) h->charidx);
 	}
 #endif
 	DUK_FREE(heap, (void *) h);
@@ -193,6 +217,7 @@ DUK_INTERNAL void duk_heap_free_freelists(duk_heap *heap) {
 	                 (long) count_act, (long) count_cat));
 }
 
+#if !defined(DUK_USE_ALLOC_ARENA)
 DUK_LOCAL void duk__free_allocated(duk_heap *heap) {
 	duk_heaphdr *curr;
 	duk_heaphdr *next;
@@ -210,8 +235,9 @@ DUK_LOCAL void duk__free_allocated(duk_heap *heap) {
 		curr = next;
 	}
 }
+#endif  /* !DUK_USE_ALLOC_ARENA */
 
-#if defined(DUK_USE_FINALIZER_SUPPORT)
+#if defined(DUK_USE_FINALIZER_SUPPORT) && !defined(DUK_USE_ALLOC_ARENA)
 DUK_LOCAL void duk__free_finalize_list(duk_heap *heap) {
 	duk_heaphdr *curr;
 	duk_heaphdr *next;
@@ -225,12 +251,30 @@ DUK_LOCAL void duk__free_finalize_list(duk_heap *heap) {
 		curr = next;
 	}
 }
-#endif  /* DUK_USE_FINALIZER_SUPPORT */
+#endif  /* DUK_USE_FINALIZER_SUPPORT && !DUK_USE_ALLOC_ARENA */
 
+#if !defined(DUK_USE_ALLOC_ARENA) || \
+    (defined(DUK_USE_HSTRING_EXTDATA) && (defined(DUK_USE_EXTSTR_FREE) || defined(DUK_USE_HSTRING_UNINTERNED)))
 DUK_LOCAL void duk__free_stringtable(duk_heap *heap) {
 	/* strings are only tracked by stringtable */
 	duk_heap_strtable_free(heap);
 }
+#endif
+
+#if defined(DUK_USE_ALLOC_ARENA)
+/* Release everything allocated from the arena in one go, without walking
+ * heap_allocated.  Only external strings need individual processing so
+ * that their data can be released.
+ */
+DUK_LOCAL void duk__free_arena(duk_heap *heap) {
+#if defined(DUK_USE_HSTRING_EXTDATA) && (defined(DUK_USE_EXTSTR_FREE) || defined(DUK_USE_HSTRING_UNINTERNED))
+	DUK_D(DUK_DPRINT("freeing string table of heap: %p", (void *) heap));
+	duk__free_stringtable(heap);
+#endif
+	DUK_D(DUK_DPRINT("freeing arena chunks of heap: %p", (void *) heap));
+	duk_heap_arena_free_all(heap);
+}
+#endif  /* DUK_USE_ALLOC_ARENA */
 
 #if defined(DUK_USE_FINALIZER_SUPPORT)
 DUK_LOCAL void duk__free_run_finalizers(duk_heap *heap) {
@@ -353,6 +397,19 @@ DUK_INTERNAL void duk_heap_free(duk_heap *heap) {
 	duk_debug_do_detach(heap);
 #endif
 
+#if defined(DUK_USE_ALLOC_ARENA)
+	if (!heap->arena.have_finalizers) {
+		/* No finalizer has ever been set, so the forced mark-and-sweep
+		 * rounds and finalizer passes below would have nothing to do.
+		 */
+		DUK_D(DUK_DPRINT("arena heap without finalizers, skip finalization"));
+		duk__free_arena(heap);
+		DUK_D(DUK_DPRINT("freeing heap structure: %p", (void *) heap));
+		heap->free_func(heap->heap_udata, heap);
+		return;
+	}
+#endif
+
 	/* Execute finalizers before freeing the heap, even for reachable
 	 * objects.  This gives finalizers the chance to free any native
 	 * resources like file handles, allocations made outside Duktape,
@@ -398,6 +455,9 @@ DUK_INTERNAL void duk_heap_free(duk_heap *heap) {
 	duk__free_run_finalizers(heap);
 #endif  /* DUK_USE_FINALIZER_SUPPORT */
 
+#if defined(DUK_USE_ALLOC_ARENA)
+	duk__free_arena(heap);
+#else  /* DUK_USE_ALLOC_ARENA */
 	/* Note: heap->heap_thread, heap->curr_thread, and heap->heap_object
 	 * are on the heap allocated list.
 	 */
@@ -417,9 +477,24 @@ DUK_INTERNAL void duk_heap_free(duk_heap *heap) {
 	duk__free_finalize_list(heap);
 #endif
 
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	/* All objects are gone so only the heap's own reference to the root
+	 * shape remains, and the root shape has no transitions left.
+	 */
+	DUK_ASSERT(heap->shape_root.refcount == 1);
+	DUK_ASSERT(heap->shape_root.users == 0);
+	DUK_ASSERT(heap->shape_root.child == NULL);
+#endif
+
 	DUK_D(DUK_DPRINT("freeing string table of heap: %p", (void *) heap));
 	duk__free_stringtable(heap);
 
+#if defined(DUK_USE_ALLOC_SLAB)
+	DUK_D(DUK_DPRINT("freeing slab allocator pages: %p", (void *) heap));
+	duk_heap_slab_free_all(heap);
+#endif
+#endif  /* DUK_USE_ALLOC_ARENA */
+
 	DUK_D(DUK_DPRINT("freeing heap structure: %p", (void *) heap));
 	heap->free_func(heap->heap_udata, heap);
 }
@@ -507,10 +582,13 @@ DUK_LOCAL duk_bool_t duk__init_heap_strings(duk_heap *heap) {
 
 		DUK_DDD(DUK_DDDPRINT("interned: %!O", (duk_heaphdr *) h));
 
-		/* XXX: The incref macro takes a thread pointer but doesn't
-		 * use it right now.
+		/* There's no thread for the incref macros yet; a plain
+		 * refcount bump is enough because mark-and-sweep cannot
+		 * be running during heap init.
 		 */
-		DUK_HSTRING_INCREF(_never_referenced_, h);
+#if defined(DUK_USE_REFERENCE_COUNTING)
+		DUK_HEAPHDR_PREINC_REFCOUNT((duk_heaphdr *) h);
+#endif
 
 #if defined(DUK_USE_HEAPPTR16)
 		heap->strs16[i] = DUK_USE_HEAPPTR_ENC16(heap->heap_udata, (void *) h);
@@ -903,6 +981,12 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 #if defined(DUK_USE_ASSERTIONS)
 	res->heap_initializing = 1;
 #endif
+#if defined(DUK_USE_ALLOC_SLAB)
+	duk_heap_slab_init(res);
+#endif
+#if defined(DUK_USE_ALLOC_ARENA)
+	duk_heap_arena_init(res);
+#endif
 
 	/* explicit NULL inits */
 #if defined(DUK_USE_EXPLICIT_NULL_INIT)
@@ -922,6 +1006,18 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 #endif
 #if defined(DUK_USE_CACHE_CATCHER)
 	res->catcher_free = NULL;
+#endif
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	res->ms_incr_cursor = NULL;
+	res->ms_incr_sweep_start = NULL;
+#endif
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	{
+		duk_small_uint_t i;
+		for (i = 0; i < DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE; i++) {
+			res->ms_gen_bounds[i] = NULL;
+		}
+	}
 #endif
 	res->heap_thread = NULL;
 	res->curr_thread = NULL;
@@ -1017,12 +1113,12 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 
 	st_initsize = DUK_USE_STRTAB_MINSIZE;
 #if defined(DUK_USE_STRTAB_PTRCOMP)
-	res->strtable16 = (duk_uint16_t *) alloc_func(heap_udata, sizeof(duk_uint16_t) * st_initsize);
+	res->strtable16 = (duk_uint16_t *) DUK_ALLOC_RAW(res, sizeof(duk_uint16_t) * st_initsize);
 	if (res->strtable16 == NULL) {
 		goto failed;
 	}
 #else
-	res->strtable = (duk_hstring **) alloc_func(heap_udata, sizeof(duk_hstring *) * st_initsize);
+	res->strtable = (duk_hstring **) DUK_ALLOC_RAW(res, sizeof(duk_hstring *) * st_initsize);
 	if (res->strtable == NULL) {
 		goto failed;
 	}
@@ -1049,6 +1145,14 @@ duk_heap *duk_heap_alloc(duk_alloc_function alloc_func,
 #endif  /* DUK_USE_EXPLICIT_NULL_INIT */
 #endif  /* DUK_USE_STRTAB_PTRCOMP */
 
+	/*
+	 *  Init object shapes
+	 */
+
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	duk_hshape_init_root(res);
+#endif
+
 	/*
 	 *  Init stringcache
 	 */
@@ -0,0 +1,304 @@
+/*
+ *  Bump pointer arena allocator (DUK_USE_ALLOC_ARENA).
+ *
+ *  Intended for short-lived heaps, e.g. one heap per request: memory is
+ *  carved from large chunks requested from the heap allocation functions
+ *  with a bump pointer, and all chunks are released at once when the heap
+ *  is destroyed.  Heap destruction then doesn't need to walk and free the
+ *  heap_allocated list or the string table one allocation at a time.
+ *
+ *  Each block has a small header holding its capacity so that blocks freed
+ *  during the heap's lifetime (refzero, mark-and-sweep) can be reused:
+ *  blocks up to DUK_HEAP_ARENA_MAX_CLASS_SIZE bytes go to per size class
+ *  free lists, which allocation checks before bumping.  A realloc within
+ *  the block capacity is done in place, as is growing the most recently
+ *  bumped block while the chunk has room.  Blocks larger than
+ *  DUK_HEAP_ARENA_MAX_CLASS_SIZE are allocated directly from the
+ *  allocation functions and tracked in a list so that they can be freed
+ *  eagerly, and released at heap destruction if still alive.
+ *
+ *  Memory is never returned to the allocation functions while the heap is
+ *  alive except for the large blocks, so the arena's footprint is that of
+ *  the heap's peak usage.
+ */
+
+#include "duk_internal.h"
+
+#if defined(DUK_USE_ALLOC_ARENA)
+
+#define DUK__ARENA_HDR_SIZE      ((duk_size_t) sizeof(duk_arena_hdr))
+#define DUK__ARENA_CHUNK_HDR     ((sizeof(duk_arena_chunk) + 7U) & ~((duk_size_t) 7U))
+#define DUK__ARENA_FLAG_LARGE    ((duk_size_t) 1U)  /* in capacity field, capacities are multiples of 8 */
+#define DUK__ARENA_BLOCK_HDR(ptr)  ((duk_arena_hdr *) (void *) ((duk_uint8_t *) (ptr) - DUK__ARENA_HDR_SIZE))
+
+#if (DUK_HEAP_ARENA_MAX_CLASS_SIZE != 4096) || (DUK_HEAP_ARENA_NUM_CLASSES != 48)
+#error arena size class mapping assumes 48 classes up to 4096 bytes
+#endif
+
+/* Size class for an allocation size in [1, DUK_HEAP_ARENA_MAX_CLASS_SIZE]:
+ * 8 byte steps up to 256 bytes, then four classes per power of two.
+ */
+DUK_LOCAL duk_small_uint_t duk__arena_class(duk_size_t size) {
+	duk_small_uint_t shift;
+
+	DUK_ASSERT(size >= 1U && size <= (duk_size_t) DUK_HEAP_ARENA_MAX_CLASS_SIZE);
+	if (DUK_LIKELY(size <= 256U)) {
+		return (duk_small_uint_t) ((size - 1U) >> 3);
+	}
+	shift = 6;  /* (256, 512] in steps of 64 */
+	while ((size - 1U) >> (shift + 3U) > 0U) {
+		shift++;
+	}
+	return (duk_small_uint_t) (32U + (shift - 6U) * 4U + (((size - 1U) >> shift) - 4U));
+}
+
+DUK_LOCAL duk_size_t duk__arena_class_size(duk_small_uint_t cls) {
+	duk_small_uint_t shift;
+
+	DUK_ASSERT(cls < DUK_HEAP_ARENA_NUM_CLASSES);
+	if (cls < 32U) {
+		return (duk_size_t) (cls + 1U) * 8U;
+	}
+	shift = (duk_small_uint_t) (6U + (cls - 32U) / 4U);
+	return (duk_size_t) (5U + (cls - 32U) % 4U) << shift;
+}
+
+/*
+ *  Chunks and large blocks
+ */
+
+/* Bump 'size' bytes (including block header) from the current chunk,
+ * starting a new chunk if necessary.  The unused tail of the previous
+ * chunk is abandoned.
+ */
+DUK_LOCAL duk_uint8_t *duk__arena_bump(duk_heap *heap, duk_size_t size) {
+	duk_arena *arena;
+	duk_arena_chunk *chunk;
+	duk_uint8_t *res;
+
+	arena = &heap->arena;
+	if (DUK_UNLIKELY((duk_size_t) (arena->end - arena->curr) < size)) {
+		DUK_ASSERT(size <= DUK_HEAP_ARENA_CHUNK_SIZE - DUK__ARENA_CHUNK_HDR);
+		chunk = (duk_arena_chunk *) heap->alloc_func(heap->heap_udata, DUK_HEAP_ARENA_CHUNK_SIZE);
+		if (chunk == NULL) {
+			return NULL;
+		}
+		chunk->next = arena->chunks;
+		arena->chunks = chunk;
+		arena->curr = (duk_uint8_t *) chunk + DUK__ARENA_CHUNK_HDR;
+		arena->end = (duk_uint8_t *) chunk + DUK_HEAP_ARENA_CHUNK_SIZE;
+		DUK_DD(DUK_DDPRINT("new arena chunk %p", (void *) chunk));
+	}
+	res = arena->curr;
+	arena->curr += size;
+	return res;
+}
+
+DUK_LOCAL void *duk__arena_large_alloc(duk_heap *heap, duk_size_t size) {
+	duk_arena_large *large;
+
+	if (size > DUK_SIZE_MAX - sizeof(duk_arena_large) - 7U) {
+		return NULL;
+	}
+	size = (size + 7U) & ~((duk_size_t) 7U);
+	large = (duk_arena_large *) heap->alloc_func(heap->heap_udata, sizeof(duk_arena_large) + size);
+	if (large == NULL) {
+		return NULL;
+	}
+	large->prev = NULL;
+	large->next = heap->arena.large;
+	if (large->next != NULL) {
+		large->next->prev = large;
+	}
+	heap->arena.large = large;
+	large->hdr.capacity = size | DUK__ARENA_FLAG_LARGE;
+	return (void *) (large + 1);
+}
+
+DUK_LOCAL duk_arena_large *duk__arena_large_get(void *ptr) {
+	return (duk_arena_large *) (void *) ((duk_uint8_t *) ptr - sizeof(duk_arena_large));
+}
+
+DUK_LOCAL void duk__arena_large_unlink(duk_heap *heap, duk_arena_large *large) {
+	if (large->prev != NULL) {
+		large->prev->next = large->next;
+	} else {
+		DUK_ASSERT(heap->arena.large == large);
+		heap->arena.large = large->next;
+	}
+	if (large->next != NULL) {
+		large->next->prev = large->prev;
+	}
+}
+
+DUK_LOCAL void duk__arena_large_link(duk_heap *heap, duk_arena_large *large) {
+	large->prev = NULL;
+	large->next = heap->arena.large;
+	if (large->next != NULL) {
+		large->next->prev = large;
+	}
+	heap->arena.large = large;
+}
+
+/*
+ *  Heap interface
+ */
+
+DUK_INTERNAL void duk_heap_arena_init(duk_heap *heap) {
+	duk_small_uint_t i;
+
+	DUK_ASSERT(sizeof(duk_arena_hdr) == 8U);
+	DUK_ASSERT(sizeof(duk_arena_large) == 2U * sizeof(void *) + sizeof(duk_arena_hdr));
+
+	for (i = 0; i < DUK_HEAP_ARENA_NUM_CLASSES; i++) {
+		heap->arena.free[i] = NULL;
+	}
+	heap->arena.chunks = NULL;
+	heap->arena.large = NULL;
+	heap->arena.curr = NULL;
+	heap->arena.end = NULL;
+	heap->arena.have_finalizers = 0;
+}
+
+/* Release all chunks and large blocks at heap destruction.  Whatever was
+ * still allocated, including heap objects and strings, is freed with them.
+ */
+DUK_INTERNAL void duk_heap_arena_free_all(duk_heap *heap) {
+	duk_arena_chunk *chunk;
+	duk_arena_chunk *chunk_next;
+	duk_arena_large *large;
+	duk_arena_large *large_next;
+
+	for (chunk = heap->arena.chunks; chunk != NULL; chunk = chunk_next) {
+		chunk_next = chunk->next;
+		heap->free_func(heap->heap_udata, (void *) chunk);
+	}
+	for (large = heap->arena.large; large != NULL; large = large_next) {
+		large_next = large->next;
+		heap->free_func(heap->heap_udata, (void *) large);
+	}
+	duk_heap_arena_init(heap);
+}
+
+DUK_INTERNAL DUK_HOT void *duk_heap_arena_alloc(duk_heap *heap, duk_size_t size) {
+	duk_small_uint_t cls;
+	duk_arena_hdr *hdr;
+	void *res;
+
+	if (DUK_UNLIKELY(size - 1U >= (duk_size_t) DUK_HEAP_ARENA_MAX_CLASS_SIZE)) {
+		if (size == 0) {
+			/* Zero size allocations keep the allocation function
+			 * semantics of returning NULL or a unique pointer; a
+			 * smallest class block is unique.
+			 */
+			size = 1;
+		} else {
+			return duk__arena_large_alloc(heap, size);
+		}
+	}
+
+	cls = duk__arena_class(size);
+	res = heap->arena.free[cls];
+	if (res != NULL) {
+		heap->arena.free[cls] = *((void **) res);
+		return res;
+	}
+
+	hdr = (duk_arena_hdr *) (void *) duk__arena_bump(heap, DUK__ARENA_HDR_SIZE + duk__arena_class_size(cls));
+	if (hdr == NULL) {
+		return NULL;
+	}
+	hdr->capacity = duk__arena_class_size(cls);
+	return (void *) (hdr + 1);
+}
+
+DUK_INTERNAL void *duk_heap_arena_realloc(duk_heap *heap, void *ptr, duk_size_t newsize) {
+	duk_arena_hdr *hdr;
+	duk_arena_large *large;
+	duk_size_t capacity;
+	duk_small_uint_t cls;
+	void *res;
+
+	if (ptr == NULL) {
+		return duk_heap_arena_alloc(heap, newsize);
+	}
+	if (newsize == 0) {
+		duk_heap_arena_free(heap, ptr);
+		return NULL;
+	}
+
+	hdr = DUK__ARENA_BLOCK_HDR(ptr);
+	capacity = hdr->capacity;
+	if (capacity & DUK__ARENA_FLAG_LARGE) {
+		capacity &= ~DUK__ARENA_FLAG_LARGE;
+		if (newsize > (duk_size_t) DUK_HEAP_ARENA_MAX_CLASS_SIZE) {
+			if (newsize > DUK_SIZE_MAX - sizeof(duk_arena_large) - 7U) {
+				return NULL;
+			}
+			newsize = (newsize + 7U) & ~((duk_size_t) 7U);
+			large = duk__arena_large_get(ptr);
+			duk__arena_large_unlink(heap, large);
+			res = heap->realloc_func(heap->heap_udata, (void *) large, sizeof(duk_arena_large) + newsize);
+			if (res == NULL) {
+				/* Original block remains valid. */
+				duk__arena_large_link(heap, large);
+				return NULL;
+			}
+			large = (duk_arena_large *) res;
+			duk__arena_large_link(heap, large);
+			large->hdr.capacity = newsize | DUK__ARENA_FLAG_LARGE;
+			return (void *) (large + 1);
+		}
+	} else if (newsize <= capacity) {
+		/* Shrink in place, the block keeps its capacity. */
+		return ptr;
+	} else if ((duk_uint8_t *) ptr + capacity == heap->arena.curr &&
+	           newsize <= (duk_size_t) DUK_HEAP_ARENA_MAX_CLASS_SIZE) {
+		/* Most recently bumped block: grow in place if the chunk
+		 * has room.  Growing the value stack or a buffer being
+		 * built right after allocating it hits this often.
+		 */
+		cls = duk__arena_class(newsize);
+		if ((duk_size_t) (heap->arena.end - (duk_uint8_t *) ptr) >= duk__arena_class_size(cls)) {
+			heap->arena.curr = (duk_uint8_t *) ptr + duk__arena_class_size(cls);
+			hdr->capacity = duk__arena_class_size(cls);
+			return ptr;
+		}
+	}
+
+	/* On failure the original allocation remains valid. */
+	res = duk_heap_arena_alloc(heap, newsize);
+	if (res == NULL) {
+		return NULL;
+	}
+	duk_memcpy(res, ptr, (capacity < newsize ? capacity : newsize));
+	duk_heap_arena_free(heap, ptr);
+	return res;
+}
+
+DUK_INTERNAL DUK_HOT void duk_heap_arena_free(duk_heap *heap, void *ptr) {
+	duk_arena_hdr *hdr;
+	duk_small_uint_t cls;
+
+	if (ptr == NULL) {
+		return;
+	}
+	hdr = DUK__ARENA_BLOCK_HDR(ptr);
+	if (DUK_UNLIKELY(hdr->capacity & DUK__ARENA_FLAG_LARGE)) {
+		duk_arena_large *large = duk__arena_large_get(ptr);
+		duk__arena_large_unlink(heap, large);
+		heap->free_func(heap->heap_udata, (void *) large);
+		return;
+	}
+
+	/* Capacity is always a class size: blocks only get capacities from
+	 * duk__arena_class_size().
+	 */
+	DUK_ASSERT(hdr->capacity >= 8U && hdr->capacity <= (duk_size_t) DUK_HEAP_ARENA_MAX_CLASS_SIZE);
+	cls = duk__arena_class(hdr->capacity);
+	DUK_ASSERT(duk__arena_class_size(cls) == hdr->capacity);
+	*((void **) ptr) = heap->arena.free[cls];
+	heap->arena.free[cls] = ptr;
+}
+
+#endif  /* DUK_USE_ALLOC_ARENA */
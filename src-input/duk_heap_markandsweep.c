@@ -9,6 +9,16 @@ DUK_LOCAL_DECL void duk__mark_heaphdr_nonnull(duk_heap *heap, duk_heaphdr *h);
 DUK_LOCAL_DECL void duk__mark_tval(duk_heap *heap, duk_tval *tv);
 DUK_LOCAL_DECL void duk__mark_tvals(duk_heap *heap, duk_tval *tv, duk_idx_t count);
 
+/* End of the heap_allocated range processed by the marking and refcount
+ * finalization helpers: a minor collection only processes the young
+ * generation.
+ */
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+#define DUK__SCAN_END(heap)  ((heap)->ms_gen_minor ? DUK_HEAP_GEN_OLD_START((heap)) : NULL)
+#else
+#define DUK__SCAN_END(heap)  NULL
+#endif
+
 /*
  *  Marking functions for heap types: mark children recursively.
  */
@@ -183,6 +193,29 @@ DUK_LOCAL void duk__mark_heaphdr(duk_heap *heap, duk_heaphdr *h) {
 	DUK_HEAPHDR_ASSERT_VALID(h);
 	DUK_ASSERT(!DUK_HEAPHDR_HAS_READONLY(h) || DUK_HEAPHDR_HAS_REACHABLE(h));
 
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	if (heap->ms_gen_minor) {
+		/* Strings are only collected by full collections.  Old
+		 * objects have REACHABLE set so they're neither marked nor
+		 * refcount adjusted.
+		 */
+		if (DUK_HEAPHDR_IS_STRING(h)) {
+			return;
+		}
+		if (heap->ms_gen_adjust != 0) {
+			if (!DUK_HEAPHDR_HAS_REACHABLE(h)) {
+				if (heap->ms_gen_adjust < 0) {
+					DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT(h) > 0);
+					DUK_HEAPHDR_PREDEC_REFCOUNT(h);
+				} else {
+					DUK_HEAPHDR_PREINC_REFCOUNT(h);
+				}
+			}
+			return;
+		}
+	}
+#endif
+
 #if defined(DUK_USE_ASSERTIONS) && defined(DUK_USE_REFERENCE_COUNTING)
 	if (!DUK_HEAPHDR_HAS_READONLY(h)) {
 		h->h_assert_refcount++;  /* Comparison refcount: bump even if already reachable. */
@@ -198,10 +231,21 @@ DUK_LOCAL void duk__mark_heaphdr(duk_heap *heap, duk_heaphdr *h) {
 	 */
 	DUK_ASSERT(!DUK_HEAPHDR_HAS_READONLY(h));
 #endif
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	/* Objects on finalize_list are marked in the incremental remark
+	 * step only, so that marking never leaves flags on them.
+	 */
+	if (heap->ms_incr_phase == DUK_HEAP_MS_INCR_MARK && DUK_HEAPHDR_HAS_FINALIZABLE(h)) {
+		return;
+	}
+#endif
 
 	DUK_HEAPHDR_SET_REACHABLE(h);
 
-	if (heap->ms_recursion_depth >= DUK_USE_MARK_AND_SWEEP_RECLIMIT) {
+	/* Strings and buffers have no children so only objects need to be
+	 * processed later as temproots.
+	 */
+	if (heap->ms_recursion_depth >= DUK_USE_MARK_AND_SWEEP_RECLIMIT && DUK_HEAPHDR_IS_OBJECT(h)) {
 		DUK_D(DUK_DPRINT("mark-and-sweep recursion limit reached, marking as temproot: %p", (void *) h));
 		DUK_HEAP_SET_MARKANDSWEEP_RECLIMIT_REACHED(heap);
 		DUK_HEAPHDR_SET_TEMPROOT(h);
@@ -309,14 +353,16 @@ DUK_LOCAL void duk__mark_roots_heap(duk_heap *heap) {
 #if defined(DUK_USE_FINALIZER_SUPPORT)
 DUK_LOCAL void duk__mark_finalizable(duk_heap *heap) {
 	duk_heaphdr *hdr;
+	duk_heaphdr *end;
 	duk_size_t count_finalizable = 0;
 
 	DUK_DD(DUK_DDPRINT("duk__mark_finalizable: %p", (void *) heap));
 
 	DUK_ASSERT(heap->heap_thread != NULL);
 
+	end = DUK__SCAN_END(heap);
 	hdr = heap->heap_allocated;
-	while (hdr != NULL) {
+	while (hdr != end) {
 		/* A finalizer is looked up from the object and up its
 		 * prototype chain (which allows inherited finalizers).
 		 * The finalizer is checked for using a duk_hobject flag
@@ -355,7 +401,7 @@ DUK_LOCAL void duk__mark_finalizable(duk_heap *heap) {
 	                   (long) count_finalizable));
 
 	hdr = heap->heap_allocated;
-	while (hdr != NULL) {
+	while (hdr != end) {
 		if (DUK_HEAPHDR_HAS_FINALIZABLE(hdr)) {
 			duk__mark_heaphdr_nonnull(heap, hdr);
 		}
@@ -442,12 +488,15 @@ DUK_LOCAL void duk__handle_temproot(duk_heap *heap, duk_heaphdr *hdr) {
 
 DUK_LOCAL void duk__mark_temproots_by_heap_scan(duk_heap *heap) {
 	duk_heaphdr *hdr;
+	duk_heaphdr *end;
 #if defined(DUK_USE_DEBUG)
 	duk_size_t count;
 #endif
 
 	DUK_DD(DUK_DDPRINT("duk__mark_temproots_by_heap_scan: %p", (void *) heap));
 
+	end = DUK__SCAN_END(heap);
+
 	while (DUK_HEAP_HAS_MARKANDSWEEP_RECLIMIT_REACHED(heap)) {
 		DUK_DD(DUK_DDPRINT("recursion limit reached, doing heap scan to continue from temproots"));
 
@@ -457,7 +506,7 @@ DUK_LOCAL void duk__mark_temproots_by_heap_scan(duk_heap *heap) {
 		DUK_HEAP_CLEAR_MARKANDSWEEP_RECLIMIT_REACHED(heap);
 
 		hdr = heap->heap_allocated;
-		while (hdr) {
+		while (hdr != end) {
 #if defined(DUK_USE_DEBUG)
 			duk__handle_temproot(heap, hdr, &count);
 #else
@@ -496,13 +545,15 @@ DUK_LOCAL void duk__mark_temproots_by_heap_scan(duk_heap *heap) {
 #if defined(DUK_USE_REFERENCE_COUNTING)
 DUK_LOCAL void duk__finalize_refcounts(duk_heap *heap) {
 	duk_heaphdr *hdr;
+	duk_heaphdr *end;
 
 	DUK_ASSERT(heap->heap_thread != NULL);
 
 	DUK_DD(DUK_DDPRINT("duk__finalize_refcounts: heap=%p", (void *) heap));
 
+	end = DUK__SCAN_END(heap);
 	hdr = heap->heap_allocated;
-	while (hdr) {
+	while (hdr != end) {
 		if (!DUK_HEAPHDR_HAS_REACHABLE(hdr)) {
 			/*
 			 *  Unreachable object about to be swept.  Finalize target refcounts
@@ -593,8 +644,16 @@ DUK_LOCAL void duk__sweep_stringtable(duk_heap *heap, duk_size_t *out_count_keep
 			duk_hstring *next;
 			next = h->hdr.h_next;
 
-			if (DUK_HEAPHDR_HAS_REACHABLE((duk_heaphdr *) h))
-			{
+			if (DUK_HEAPHDR_HAS_REACHABLE((duk_heaphdr *) h)
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+			    /* Strings may be referenced by objects created
+			     * or interned again after incremental marking
+			     * finished; such strings aren't marked but have
+			     * a refcount.
+			     */
+			    || DUK_HEAPHDR_GET_REFCOUNT((duk_heaphdr *) h) > (DUK_HSTRING_HAS_PINNED_LITERAL(h) ? 1U : 0U)
+#endif
+			   ) {
 				DUK_HEAPHDR_CLEAR_REACHABLE((duk_heaphdr *) h);
 				count_keep++;
 				prev = h;
@@ -655,10 +714,139 @@ DUK_LOCAL void duk__sweep_stringtable(duk_heap *heap, duk_size_t *out_count_keep
  *  Sweep heap.
  */
 
+/* Sweep decision for a single heap_allocated object, shared by the normal
+ * and the incremental sweep.  Updates the object's flags (and refcount for
+ * objects queued for finalization) but leaves list handling and freeing to
+ * the caller.
+ */
+#define DUK__SWEEP_KEEP      0  /* keep in heap_allocated */
+#define DUK__SWEEP_RESCUE    1  /* keep in heap_allocated, rescued after finalization */
+#define DUK__SWEEP_FINALIZE  2  /* move to finalize_list */
+#define DUK__SWEEP_FREE      3  /* free */
+
+DUK_LOCAL duk_small_uint_t duk__sweep_object(duk_heap *heap, duk_heaphdr *curr, duk_small_uint_t flags) {
+	duk_small_uint_t res;
+
+	/* Strings and ROM objects are never placed on the heap allocated list. */
+	DUK_ASSERT(DUK_HEAPHDR_GET_TYPE(curr) != DUK_HTYPE_STRING);
+	DUK_ASSERT(!DUK_HEAPHDR_HAS_READONLY(curr));
+	DUK_UNREF(heap);
+
+	if (DUK_HEAPHDR_HAS_REACHABLE(curr)) {
+		/*
+		 *  Reachable object:
+		 *    - If FINALIZABLE -> actually unreachable (but marked
+		 *      artificially reachable), queue to finalize_list.
+		 *    - If !FINALIZABLE but FINALIZED -> rescued after
+		 *      finalizer execution.
+		 *    - Otherwise just a normal, reachable object.
+		 *
+		 *  Objects which are kept are queued to heap_allocated
+		 *  tail (we're essentially filtering heap_allocated in
+		 *  practice).
+		 */
+
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+		if (DUK_UNLIKELY(DUK_HEAPHDR_HAS_FINALIZABLE(curr))) {
+			DUK_ASSERT(!DUK_HEAPHDR_HAS_FINALIZED(curr));
+			DUK_ASSERT(DUK_HEAPHDR_GET_TYPE(curr) == DUK_HTYPE_OBJECT);
+			DUK_DD(DUK_DDPRINT("sweep; reachable, finalizable --> move to finalize_list: %p", (void *) curr));
+
+#if defined(DUK_USE_REFERENCE_COUNTING)
+			DUK_HEAPHDR_PREINC_REFCOUNT(curr);  /* Bump refcount so that refzero never occurs when pending a finalizer call. */
+#endif
+			res = DUK__SWEEP_FINALIZE;
+		}
+		else
+#endif  /* DUK_USE_FINALIZER_SUPPORT */
+		{
+			if (DUK_UNLIKELY(DUK_HEAPHDR_HAS_FINALIZED(curr))) {
+				DUK_ASSERT(!DUK_HEAPHDR_HAS_FINALIZABLE(curr));
+				DUK_ASSERT(DUK_HEAPHDR_GET_TYPE(curr) == DUK_HTYPE_OBJECT);
+
+				if (flags & DUK_MS_FLAG_POSTPONE_RESCUE) {
+					DUK_DD(DUK_DDPRINT("sweep; reachable, finalized, but postponing rescue decisions --> keep object (with FINALIZED set): %!iO", curr));
+					res = DUK__SWEEP_KEEP;
+				} else {
+					DUK_DD(DUK_DDPRINT("sweep; reachable, finalized --> rescued after finalization: %p", (void *) curr));
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+					DUK_HEAPHDR_CLEAR_FINALIZED(curr);
+#endif
+					res = DUK__SWEEP_RESCUE;
+				}
+			} else {
+				DUK_DD(DUK_DDPRINT("sweep; reachable --> keep: %!iO", curr));
+				res = DUK__SWEEP_KEEP;
+			}
+		}
+
+		/*
+		 *  Shrink check for value stacks here.  We're inside
+		 *  ms_prevent_count protection which prevents recursive
+		 *  mark-and-sweep and refzero finalizers, so there are
+		 *  no side effects that would affect the heap lists.
+		 */
+		if (DUK_HEAPHDR_IS_OBJECT(curr) && DUK_HOBJECT_IS_THREAD((duk_hobject *) curr)) {
+			duk_hthread *thr_curr = (duk_hthread *) curr;
+			DUK_DD(DUK_DDPRINT("value stack shrink check for thread: %!O", curr));
+			duk_valstack_shrink_check_nothrow(thr_curr, flags & DUK_MS_FLAG_EMERGENCY /*snug*/);
+		}
+
+		DUK_HEAPHDR_CLEAR_REACHABLE(curr);
+		/* Keep FINALIZED if set, used if rescue decisions are postponed. */
+		/* Keep FINALIZABLE for objects on finalize_list. */
+		DUK_ASSERT(!DUK_HEAPHDR_HAS_REACHABLE(curr));
+		return res;
+	}
+
+	/*
+	 *  Unreachable object:
+	 *    - If FINALIZED, object was finalized but not
+	 *      rescued.  This doesn't affect freeing.
+	 *    - Otherwise normal unreachable object.
+	 *
+	 *  There's no guard preventing a FINALIZED object
+	 *  from being freed while finalizers execute: the
+	 *  artificial finalize_list reachability roots can't
+	 *  cause an incorrect free decision (but can cause
+	 *  an incorrect rescue decision).
+	 */
+
+#if defined(DUK_USE_REFERENCE_COUNTING)
+	/* Non-zero refcounts should not happen because we refcount
+	 * finalize all unreachable objects which should cancel out
+	 * refcounts (even for cycles).
+	 */
+	DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT(curr) == 0);
+#endif
+	DUK_ASSERT(!DUK_HEAPHDR_HAS_FINALIZABLE(curr));
+
+#if defined(DUK_USE_DEBUG)
+	if (DUK_HEAPHDR_HAS_FINALIZED(curr)) {
+		DUK_DD(DUK_DDPRINT("sweep; unreachable, finalized --> finalized object not rescued: %p", (void *) curr));
+	} else {
+		DUK_DD(DUK_DDPRINT("sweep; not reachable --> free: %p", (void *) curr));
+	}
+
+#endif
+
+	/* Note: object cannot be a finalizable unreachable object, as
+	 * they have been marked temporarily reachable for this round,
+	 * and are handled above.
+	 */
+
+	/* Weak refs should be handled here, but no weak refs for
+	 * any non-string objects exist right now.
+	 */
+
+	return DUK__SWEEP_FREE;
+}
+
 DUK_LOCAL void duk__sweep_heap(duk_heap *heap, duk_small_uint_t flags, duk_size_t *out_count_keep) {
 	duk_heaphdr *prev;  /* last element that was left in the heap */
 	duk_heaphdr *curr;
 	duk_heaphdr *next;
+	duk_small_uint_t res;
 #if defined(DUK_USE_DEBUG)
 	duk_size_t count_free = 0;
 	duk_size_t count_finalize = 0;
@@ -672,140 +860,49 @@ DUK_LOCAL void duk__sweep_heap(duk_heap *heap, duk_small_uint_t flags, duk_size_
 	curr = heap->heap_allocated;
 	heap->heap_allocated = NULL;
 	while (curr) {
-		/* Strings and ROM objects are never placed on the heap allocated list. */
-		DUK_ASSERT(DUK_HEAPHDR_GET_TYPE(curr) != DUK_HTYPE_STRING);
-		DUK_ASSERT(!DUK_HEAPHDR_HAS_READONLY(curr));
-
 		next = DUK_HEAPHDR_GET_NEXT(heap, curr);
 
-		if (DUK_HEAPHDR_HAS_REACHABLE(curr)) {
-			/*
-			 *  Reachable object:
-			 *    - If FINALIZABLE -> actually unreachable (but marked
-			 *      artificially reachable), queue to finalize_list.
-			 *    - If !FINALIZABLE but FINALIZED -> rescued after
-			 *      finalizer execution.
-			 *    - Otherwise just a normal, reachable object.
-			 *
-			 *  Objects which are kept are queued to heap_allocated
-			 *  tail (we're essentially filtering heap_allocated in
-			 *  practice).
-			 */
-
-#if defined(DUK_USE_FINALIZER_SUPPORT)
-			if (DUK_UNLIKELY(DUK_HEAPHDR_HAS_FINALIZABLE(curr))) {
-				DUK_ASSERT(!DUK_HEAPHDR_HAS_FINALIZED(curr));
-				DUK_ASSERT(DUK_HEAPHDR_GET_TYPE(curr) == DUK_HTYPE_OBJECT);
-				DUK_DD(DUK_DDPRINT("sweep; reachable, finalizable --> move to finalize_list: %p", (void *) curr));
-
-#if defined(DUK_USE_REFERENCE_COUNTING)
-				DUK_HEAPHDR_PREINC_REFCOUNT(curr);  /* Bump refcount so that refzero never occurs when pending a finalizer call. */
-#endif
-				DUK_HEAP_INSERT_INTO_FINALIZE_LIST(heap, curr);
+		res = duk__sweep_object(heap, curr, flags);
+		if (res == DUK__SWEEP_KEEP || res == DUK__SWEEP_RESCUE) {
+			if (res == DUK__SWEEP_KEEP) {
+				count_keep++;
+			} else {
 #if defined(DUK_USE_DEBUG)
-				count_finalize++;
+				count_rescue++;
 #endif
 			}
-			else
-#endif  /* DUK_USE_FINALIZER_SUPPORT */
-			{
-				if (DUK_UNLIKELY(DUK_HEAPHDR_HAS_FINALIZED(curr))) {
-					DUK_ASSERT(!DUK_HEAPHDR_HAS_FINALIZABLE(curr));
-					DUK_ASSERT(DUK_HEAPHDR_GET_TYPE(curr) == DUK_HTYPE_OBJECT);
-
-					if (flags & DUK_MS_FLAG_POSTPONE_RESCUE) {
-						DUK_DD(DUK_DDPRINT("sweep; reachable, finalized, but postponing rescue decisions --> keep object (with FINALIZED set): %!iO", curr));
-						count_keep++;
-					} else {
-						DUK_DD(DUK_DDPRINT("sweep; reachable, finalized --> rescued after finalization: %p", (void *) curr));
-#if defined(DUK_USE_FINALIZER_SUPPORT)
-						DUK_HEAPHDR_CLEAR_FINALIZED(curr);
-#endif
-#if defined(DUK_USE_DEBUG)
-						count_rescue++;
-#endif
-					}
-				} else {
-					DUK_DD(DUK_DDPRINT("sweep; reachable --> keep: %!iO", curr));
-					count_keep++;
-				}
-
-				if (prev != NULL) {
-					DUK_ASSERT(heap->heap_allocated != NULL);
-					DUK_HEAPHDR_SET_NEXT(heap, prev, curr);
-				} else {
-					DUK_ASSERT(heap->heap_allocated == NULL);
-					heap->heap_allocated = curr;
-				}
-#if defined(DUK_USE_DOUBLE_LINKED_HEAP)
-				DUK_HEAPHDR_SET_PREV(heap, curr, prev);
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+			/* All survivors of a full collection become old. */
+			DUK_HEAPHDR_SET_REACHABLE(curr);
 #endif
-				DUK_HEAPHDR_ASSERT_LINKS(heap, prev);
-				DUK_HEAPHDR_ASSERT_LINKS(heap, curr);
-				prev = curr;
-			}
 
-			/*
-			 *  Shrink check for value stacks here.  We're inside
-			 *  ms_prevent_count protection which prevents recursive
-			 *  mark-and-sweep and refzero finalizers, so there are
-			 *  no side effects that would affect the heap lists.
-			 */
-			if (DUK_HEAPHDR_IS_OBJECT(curr) && DUK_HOBJECT_IS_THREAD((duk_hobject *) curr)) {
-				duk_hthread *thr_curr = (duk_hthread *) curr;
-				DUK_DD(DUK_DDPRINT("value stack shrink check for thread: %!O", curr));
-				duk_valstack_shrink_check_nothrow(thr_curr, flags & DUK_MS_FLAG_EMERGENCY /*snug*/);
+			if (prev != NULL) {
+				DUK_ASSERT(heap->heap_allocated != NULL);
+				DUK_HEAPHDR_SET_NEXT(heap, prev, curr);
+			} else {
+				DUK_ASSERT(heap->heap_allocated == NULL);
+				heap->heap_allocated = curr;
 			}
-
-			DUK_HEAPHDR_CLEAR_REACHABLE(curr);
-			/* Keep FINALIZED if set, used if rescue decisions are postponed. */
-			/* Keep FINALIZABLE for objects on finalize_list. */
-			DUK_ASSERT(!DUK_HEAPHDR_HAS_REACHABLE(curr));
-		} else {
-			/*
-			 *  Unreachable object:
-			 *    - If FINALIZED, object was finalized but not
-			 *      rescued.  This doesn't affect freeing.
-			 *    - Otherwise normal unreachable object.
-			 *
-			 *  There's no guard preventing a FINALIZED object
-			 *  from being freed while finalizers execute: the
-			 *  artificial finalize_list reachability roots can't
-			 *  cause an incorrect free decision (but can cause
-			 *  an incorrect rescue decision).
-			 */
-
-#if defined(DUK_USE_REFERENCE_COUNTING)
-			/* Non-zero refcounts should not happen because we refcount
-			 * finalize all unreachable objects which should cancel out
-			 * refcounts (even for cycles).
-			 */
-			DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT(curr) == 0);
+#if defined(DUK_USE_DOUBLE_LINKED_HEAP)
+			DUK_HEAPHDR_SET_PREV(heap, curr, prev);
 #endif
-			DUK_ASSERT(!DUK_HEAPHDR_HAS_FINALIZABLE(curr));
-
+			DUK_HEAPHDR_ASSERT_LINKS(heap, prev);
+			DUK_HEAPHDR_ASSERT_LINKS(heap, curr);
+			prev = curr;
+		}
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+		else if (res == DUK__SWEEP_FINALIZE) {
+			DUK_HEAP_INSERT_INTO_FINALIZE_LIST(heap, curr);
 #if defined(DUK_USE_DEBUG)
-			if (DUK_HEAPHDR_HAS_FINALIZED(curr)) {
-				DUK_DD(DUK_DDPRINT("sweep; unreachable, finalized --> finalized object not rescued: %p", (void *) curr));
-			} else {
-				DUK_DD(DUK_DDPRINT("sweep; not reachable --> free: %p", (void *) curr));
-			}
-
+			count_finalize++;
 #endif
-
-			/* Note: object cannot be a finalizable unreachable object, as
-			 * they have been marked temporarily reachable for this round,
-			 * and are handled above.
-			 */
-
+		}
+#endif
+		else {
+			DUK_ASSERT(res == DUK__SWEEP_FREE);
 #if defined(DUK_USE_DEBUG)
 			count_free++;
 #endif
-
-			/* Weak refs should be handled here, but no weak refs for
-			 * any non-string objects exist right now.
-			 */
-
 			/* Free object and all auxiliary (non-heap) allocs. */
 			duk_heap_free_heaphdr_raw(heap, curr);
 		}
@@ -884,9 +981,7 @@ DUK_LOCAL void duk__compact_object_list(duk_heap *heap, duk_hthread *thr, duk_he
 		obj = (duk_hobject *) curr;
 
 #if defined(DUK_USE_DEBUG)
-		old_size = DUK_HOBJECT_P_COMPUTE_SIZE(DUK_HOBJECT_GET_ESIZE(obj),
-		                                      DUK_HOBJECT_GET_ASIZE(obj),
-		                                      DUK_HOBJECT_GET_HSIZE(obj));
+		old_size = DUK_HOBJECT_P_ALLOC_SIZE(obj);
 #endif
 
 		DUK_DD(DUK_DDPRINT("compact object: %p", (void *) obj));
@@ -895,9 +990,7 @@ DUK_LOCAL void duk__compact_object_list(duk_heap *heap, duk_hthread *thr, duk_he
 		duk_safe_call(thr, duk__protected_compact_object, NULL, 1, 0);
 
 #if defined(DUK_USE_DEBUG)
-		new_size = DUK_HOBJECT_P_COMPUTE_SIZE(DUK_HOBJECT_GET_ESIZE(obj),
-		                                      DUK_HOBJECT_GET_ASIZE(obj),
-		                                      DUK_HOBJECT_GET_HSIZE(obj));
+		new_size = DUK_HOBJECT_P_ALLOC_SIZE(obj);
 #endif
 
 #if defined(DUK_USE_DEBUG)
@@ -981,13 +1074,39 @@ DUK_LOCAL void duk__assert_walk_strtable(duk_heap *heap, duk__gc_hstring_assert
 
 DUK_LOCAL void duk__assert_heaphdr_flags_cb(duk_heap *heap, duk_heaphdr *h) {
 	DUK_UNREF(heap);
-	DUK_ASSERT(!DUK_HEAPHDR_HAS_REACHABLE(h));
+#if !defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	DUK_ASSERT(!DUK_HEAPHDR_HAS_REACHABLE(h));  /* old objects are marked, see duk__assert_generations() */
+#endif
 	DUK_ASSERT(!DUK_HEAPHDR_HAS_TEMPROOT(h));
 	DUK_ASSERT(!DUK_HEAPHDR_HAS_FINALIZABLE(h));
 	/* may have FINALIZED */
 }
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+DUK_LOCAL void duk__assert_generations(duk_heap *heap) {
+	duk_heaphdr *curr;
+	duk_small_uint_t band = 0;
+
+	for (curr = heap->heap_allocated;; curr = DUK_HEAPHDR_GET_NEXT(heap, curr)) {
+		while (band < DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE && curr == heap->ms_gen_bounds[band]) {
+			band++;
+		}
+		if (curr == NULL) {
+			break;
+		}
+		if (band < DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE) {
+			DUK_ASSERT(!DUK_HEAPHDR_HAS_REACHABLE(curr));
+		} else {
+			DUK_ASSERT(DUK_HEAPHDR_HAS_REACHABLE(curr));
+		}
+	}
+	DUK_ASSERT(band == DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE);  /* bounds are in list order */
+}
+#endif
 DUK_LOCAL void duk__assert_heaphdr_flags(duk_heap *heap) {
 	duk__assert_walk_list(heap, heap->heap_allocated, duk__assert_heaphdr_flags_cb);
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	duk__assert_generations(heap);
+#endif
 #if defined(DUK_USE_REFERENCE_COUNTING)
 	DUK_ASSERT(heap->refzero_list == NULL);  /* Always handled to completion inline in DECREF. */
 #endif
@@ -1186,6 +1305,644 @@ DUK_LOCAL void duk__dump_stats(duk_heap *heap) {
 }
 #endif  /* DUK_USE_DEBUG */
 
+/*
+ *  Voluntary GC trigger.
+ */
+
+#if defined(DUK_USE_VOLUNTARY_GC)
+DUK_LOCAL void duk__reset_trigger(duk_heap *heap, duk_size_t count_keep) {
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	/* The next voluntary GC is normally a minor collection, whose cost
+	 * doesn't depend on the number of objects kept.
+	 */
+	DUK_UNREF(count_keep);
+	heap->ms_trigger_counter = DUK_HEAP_MARK_AND_SWEEP_GEN_TRIGGER;
+#else
+	duk_size_t tmp;
+
+	tmp = count_keep / 256;
+	heap->ms_trigger_counter = (duk_int_t) (
+	    (tmp * DUK_HEAP_MARK_AND_SWEEP_TRIGGER_MULT) +
+	    DUK_HEAP_MARK_AND_SWEEP_TRIGGER_ADD);
+#endif
+}
+#endif  /* DUK_USE_VOLUNTARY_GC */
+
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL) || defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+/* Unlink an object being swept in place from heap_allocated.  Unlike
+ * duk_heap_remove_from_heap_allocated() this doesn't update the list
+ * positions tracked by the collector, the caller deals with them.
+ */
+DUK_LOCAL void duk__sweep_unlink(duk_heap *heap, duk_heaphdr *hdr) {
+	duk_heaphdr *prev;
+	duk_heaphdr *next;
+
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	DUK_ASSERT(hdr != heap->ms_incr_cursor);
+#endif
+
+	prev = DUK_HEAPHDR_GET_PREV(heap, hdr);
+	next = DUK_HEAPHDR_GET_NEXT(heap, hdr);
+	if (prev != NULL) {
+		DUK_HEAPHDR_SET_NEXT(heap, prev, next);
+	} else {
+		DUK_ASSERT(heap->heap_allocated == hdr);
+		heap->heap_allocated = next;
+	}
+	if (next != NULL) {
+		DUK_HEAPHDR_SET_PREV(heap, next, prev);
+	}
+}
+#endif  /* DUK_USE_MARK_AND_SWEEP_INCREMENTAL || DUK_USE_MARK_AND_SWEEP_GENERATIONAL */
+
+/*
+ *  Incremental mark-and-sweep.
+ *
+ *  When enabled, a voluntary GC runs a single slice of an incremental
+ *  collection cycle and returns.  A cycle consists of:
+ *
+ *    1. Start (atomic): mark the heap roots without recursing into them,
+ *       leaving them gray (REACHABLE and TEMPROOT set).
+ *
+ *    2. MARK slices: walk heap_allocated from a cursor and process gray
+ *       objects so that their children become gray.  The walk restarts
+ *       from the list head while gray objects may remain, up to a pass
+ *       limit.  Between slices the write barrier in INCREF grays objects
+ *       gaining a reference so that a processed object can't hide an
+ *       unprocessed one.  A few places move references into objects
+ *       without an INCREF and apply the barrier explicitly.  Value stack
+ *       and activation changes are not tracked at all: reachable threads
+ *       are rescanned in the remark step instead.
+ *
+ *    3. Remark (atomic): mark roots again, rescan reachable threads and
+ *       finish marking recursively.  Finalizable objects and finalize_list
+ *       are then marked like in a stop-the-world collection.
+ *
+ *    4. FINALIZE slices: refcount finalize unreachable objects.  This must
+ *       be complete before any object is freed so that no DECREF targets
+ *       freed memory.
+ *
+ *    5. SWEEP slices: free unreachable objects and move finalizable ones
+ *       to finalize_list.  Objects are inserted at the heap_allocated head
+ *       so anything allocated after the remark step is before the sweep
+ *       start point and isn't swept.
+ *
+ *    6. End (atomic): sweep the string table.  Strings are never freed by
+ *       refcounting after marking has finished (see duk_heap_refcount.c)
+ *       because unswept garbage and object shapes may still point to them;
+ *       strings interned again after the remark step are kept based on
+ *       their refcount.
+ *
+ *  Finalizers and refcount frees run normally between slices.  Objects
+ *  freed by refcounting are unlinked from heap_allocated, which keeps the
+ *  cursor valid (see duk_heap_remove_from_heap_allocated()).  Any non-
+ *  incremental GC request (explicit or emergency) first finishes a cycle
+ *  in progress.  Garbage created during a cycle is collected by the next
+ *  one, and objects are never compacted by incremental collection.
+ */
+
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+/* Maximum number of passes over heap_allocated in the MARK phase before
+ * completing marking atomically in the remark step.
+ */
+#define DUK__INCR_MAX_PASSES  4
+
+DUK_INTERNAL void duk_heap_mark_barrier(duk_heap *heap, duk_heaphdr *h) {
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(h != NULL);
+	DUK_ASSERT(heap->ms_incr_phase == DUK_HEAP_MS_INCR_MARK);
+
+	if (DUK_HEAPHDR_HAS_REACHABLE(h)) {
+		return;
+	}
+	DUK_ASSERT(!DUK_HEAPHDR_HAS_READONLY(h));
+
+	if (DUK_HEAPHDR_IS_OBJECT(h)) {
+		if (DUK_HEAPHDR_HAS_FINALIZABLE(h)) {
+			/* On finalize_list, marked in the remark step. */
+			return;
+		}
+		DUK_HEAPHDR_SET_TEMPROOT(h);
+		DUK_HEAP_SET_MARKANDSWEEP_RECLIMIT_REACHED(heap);
+	}
+	DUK_HEAPHDR_SET_REACHABLE(h);
+}
+
+DUK_INTERNAL void duk_heap_mark_barrier_tvals(duk_heap *heap, duk_tval *tv, duk_size_t count) {
+	DUK_ASSERT(count == 0 || tv != NULL);
+
+	while (count-- > 0) {
+		if (DUK_TVAL_IS_HEAP_ALLOCATED(tv)) {
+			duk_heap_mark_barrier(heap, DUK_TVAL_GET_HEAPHDR(tv));
+		}
+		tv++;
+	}
+}
+
+/* Approximate work needed to process a gray object. */
+DUK_LOCAL duk_int_t duk__incr_mark_cost(duk_heaphdr *h) {
+	duk_int_t res;
+	duk_hobject *obj;
+
+	res = 1;
+	if (DUK_HEAPHDR_IS_OBJECT(h)) {
+		obj = (duk_hobject *) h;
+		res += (duk_int_t) DUK_HOBJECT_GET_ENEXT(obj) + (duk_int_t) DUK_HOBJECT_GET_ASIZE(obj);
+		if (DUK_HOBJECT_IS_THREAD(obj)) {
+			res += (duk_int_t) (((duk_hthread *) obj)->valstack_top - ((duk_hthread *) obj)->valstack);
+		}
+	}
+	return res;
+}
+
+DUK_LOCAL void duk__incr_start(duk_heap *heap, duk_small_uint_t flags) {
+	DUK_D(DUK_DPRINT("incremental mark-and-sweep cycle starting"));
+
+#if defined(DUK_USE_ASSERTIONS)
+	DUK_ASSERT(!DUK_HEAP_HAS_MARKANDSWEEP_RECLIMIT_REACHED(heap));
+	duk__assert_heaphdr_flags(heap);
+	duk__assert_validity(heap);
+	duk__assert_valid_refcounts(heap);
+#endif
+
+	heap->ms_incr_phase = DUK_HEAP_MS_INCR_MARK;
+	heap->ms_incr_flags = flags;
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+	if (heap->finalize_list != NULL) {
+		heap->ms_incr_flags |= DUK_MS_FLAG_POSTPONE_RESCUE;
+	}
+#endif
+	heap->ms_incr_passes = 0;
+	heap->ms_incr_count_keep = 0;
+
+	duk_heap_free_freelists(heap);
+
+	/* Gray the roots: marking at the recursion limit leaves objects
+	 * as temproots.
+	 */
+	heap->ms_recursion_depth = DUK_USE_MARK_AND_SWEEP_RECLIMIT;
+	duk__mark_roots_heap(heap);
+	heap->ms_recursion_depth = 0;
+
+	heap->ms_incr_cursor = heap->heap_allocated;
+}
+
+/* Process gray objects until the budget runs out.  Returns 1 when no gray
+ * objects remain or the pass limit is reached.
+ */
+DUK_LOCAL duk_bool_t duk__incr_mark_step(duk_heap *heap, duk_int_t *budget) {
+	duk_heaphdr *hdr;
+	duk_bool_t done = 0;
+#if defined(DUK_USE_DEBUG)
+	duk_size_t count = 0;
+#endif
+
+	/* Processing a temproot one level below the recursion limit grays
+	 * its children without recursing further.
+	 */
+	heap->ms_recursion_depth = DUK_USE_MARK_AND_SWEEP_RECLIMIT - 1;
+
+	while (*budget > 0) {
+		hdr = heap->ms_incr_cursor;
+		if (hdr == NULL) {
+			if (!DUK_HEAP_HAS_MARKANDSWEEP_RECLIMIT_REACHED(heap) ||
+			    heap->ms_incr_passes >= DUK__INCR_MAX_PASSES) {
+				done = 1;
+				break;
+			}
+			DUK_HEAP_CLEAR_MARKANDSWEEP_RECLIMIT_REACHED(heap);
+			heap->ms_incr_passes++;
+			heap->ms_incr_cursor = heap->heap_allocated;
+			continue;
+		}
+
+		heap->ms_incr_cursor = DUK_HEAPHDR_GET_NEXT(heap, hdr);
+		if (DUK_HEAPHDR_HAS_TEMPROOT(hdr)) {
+			*budget -= duk__incr_mark_cost(hdr);
+#if defined(DUK_USE_DEBUG)
+			duk__handle_temproot(heap, hdr, &count);
+#else
+			duk__handle_temproot(heap, hdr);
+#endif
+		} else {
+			(*budget)--;
+		}
+	}
+
+	heap->ms_recursion_depth = 0;
+#if defined(DUK_USE_DEBUG)
+	DUK_DD(DUK_DDPRINT("incremental mark step processed %ld gray objects, pass %ld",
+	                   (long) count, (long) heap->ms_incr_passes));
+#endif
+	return done;
+}
+
+DUK_LOCAL void duk__incr_remark(duk_heap *heap) {
+	duk_heaphdr *hdr;
+
+	DUK_D(DUK_DPRINT("incremental mark-and-sweep remark, passes: %ld", (long) heap->ms_incr_passes));
+
+	/* Barrier is disabled and finalize_list objects are marked normally
+	 * from here on.
+	 */
+	heap->ms_incr_phase = DUK_HEAP_MS_INCR_FINALIZE;
+	DUK_ASSERT(heap->ms_recursion_depth == 0);
+
+	duk__mark_roots_heap(heap);
+	for (hdr = heap->heap_allocated; hdr != NULL; hdr = DUK_HEAPHDR_GET_NEXT(heap, hdr)) {
+		if (DUK_HEAPHDR_HAS_REACHABLE(hdr) &&
+		    DUK_HEAPHDR_IS_OBJECT(hdr) &&
+		    DUK_HOBJECT_IS_THREAD((duk_hobject *) hdr)) {
+			duk__mark_hobject(heap, (duk_hobject *) hdr);
+		}
+	}
+	duk__mark_temproots_by_heap_scan(heap);
+
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+	duk__mark_finalizable(heap);
+	duk__mark_finalize_list(heap);
+#endif
+	duk__mark_temproots_by_heap_scan(heap);
+
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+	if (heap->finalize_list != NULL) {
+		heap->ms_incr_flags |= DUK_MS_FLAG_POSTPONE_RESCUE;
+	}
+	duk__clear_finalize_list_flags(heap);
+#endif
+
+	heap->ms_incr_sweep_start = heap->heap_allocated;
+	heap->ms_incr_cursor = heap->heap_allocated;
+}
+
+/* Refcount finalize unreachable objects.  Returns 1 when done. */
+DUK_LOCAL duk_bool_t duk__incr_finalize_step(duk_heap *heap, duk_int_t *budget) {
+	duk_heaphdr *hdr;
+
+	while ((hdr = heap->ms_incr_cursor) != NULL) {
+		if (*budget <= 0) {
+			return 0;
+		}
+		heap->ms_incr_cursor = DUK_HEAPHDR_GET_NEXT(heap, hdr);
+		if (!DUK_HEAPHDR_HAS_REACHABLE(hdr)) {
+			*budget -= duk__incr_mark_cost(hdr);
+			duk_heaphdr_refcount_finalize_norz(heap, hdr);
+		} else {
+			(*budget)--;
+		}
+	}
+
+	heap->ms_incr_phase = DUK_HEAP_MS_INCR_SWEEP;
+	heap->ms_incr_cursor = heap->ms_incr_sweep_start;
+	heap->ms_incr_sweep_start = NULL;
+	return 1;
+}
+
+/* Sweep objects.  Returns 1 when done. */
+DUK_LOCAL duk_bool_t duk__incr_sweep_step(duk_heap *heap, duk_int_t *budget) {
+	duk_heaphdr *hdr;
+	duk_small_uint_t res;
+
+	while ((hdr = heap->ms_incr_cursor) != NULL) {
+		if (*budget <= 0) {
+			return 0;
+		}
+		(*budget)--;
+		heap->ms_incr_cursor = DUK_HEAPHDR_GET_NEXT(heap, hdr);
+
+		res = duk__sweep_object(heap, hdr, heap->ms_incr_flags);
+		if (res == DUK__SWEEP_FREE) {
+			duk__sweep_unlink(heap, hdr);
+			duk_heap_free_heaphdr_raw(heap, hdr);
+		}
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+		else if (res == DUK__SWEEP_FINALIZE) {
+			duk__sweep_unlink(heap, hdr);
+			DUK_HEAP_INSERT_INTO_FINALIZE_LIST(heap, hdr);
+		}
+#endif
+		else if (res == DUK__SWEEP_KEEP) {
+			heap->ms_incr_count_keep++;
+		}
+	}
+
+	return 1;
+}
+
+DUK_LOCAL void duk__incr_end(duk_heap *heap) {
+	duk_size_t count_keep_str;
+
+#if defined(DUK_USE_LITCACHE_SIZE)
+	/* Litcache entries are unreferenced; wipe them before freeing
+	 * strings.
+	 */
+	duk__wipe_litcache(heap);
+#endif
+	duk__sweep_stringtable(heap, &count_keep_str);
+
+	heap->ms_incr_phase = DUK_HEAP_MS_INCR_IDLE;
+	heap->ms_incr_cursor = NULL;
+	DUK_ASSERT(heap->ms_incr_sweep_start == NULL);
+
+#if defined(DUK_USE_ASSERTIONS)
+	DUK_ASSERT(!DUK_HEAP_HAS_MARKANDSWEEP_RECLIMIT_REACHED(heap));
+	duk__assert_heaphdr_flags(heap);
+	duk__assert_validity(heap);
+	duk__assert_valid_refcounts(heap);
+#endif
+
+	duk__reset_trigger(heap, heap->ms_incr_count_keep + count_keep_str);
+	DUK_D(DUK_DPRINT("incremental mark-and-sweep cycle finished: %ld objects kept, %ld strings kept, trigger reset to %ld",
+	                 (long) heap->ms_incr_count_keep, (long) count_keep_str, (long) heap->ms_trigger_counter));
+}
+
+/* Run one slice of an incremental cycle, starting a new cycle if necessary.
+ * With 'to_completion' set, the cycle in progress is finished.  Returns 1
+ * if the cycle finished.
+ */
+DUK_LOCAL duk_bool_t duk__incr_run(duk_heap *heap, duk_small_uint_t flags, duk_bool_t to_completion) {
+	duk_int_t budget;
+	duk_bool_t done = 0;
+	duk_bool_t entry_creating_error;
+
+	DUK_ASSERT(heap->ms_prevent_count == 0);
+	DUK_ASSERT(heap->ms_running == 0);
+	heap->ms_prevent_count = 1;
+	heap->ms_running = 1;
+	entry_creating_error = heap->creating_error;
+	heap->creating_error = 0;
+
+	budget = to_completion ? DUK_INT_MAX : (duk_int_t) DUK_USE_MARK_AND_SWEEP_INCR_BUDGET;
+
+	if (heap->ms_incr_phase == DUK_HEAP_MS_INCR_IDLE) {
+		duk__incr_start(heap, flags);
+	}
+	if (heap->ms_incr_phase == DUK_HEAP_MS_INCR_MARK) {
+		if (duk__incr_mark_step(heap, &budget)) {
+			duk__incr_remark(heap);
+		}
+	}
+	if (heap->ms_incr_phase == DUK_HEAP_MS_INCR_FINALIZE) {
+		(void) duk__incr_finalize_step(heap, &budget);
+	}
+	if (heap->ms_incr_phase == DUK_HEAP_MS_INCR_SWEEP) {
+		if (duk__incr_sweep_step(heap, &budget)) {
+			duk__incr_end(heap);
+			done = 1;
+		}
+	}
+
+	DUK_ASSERT(heap->ms_recursion_depth == 0);
+	DUK_ASSERT(heap->ms_prevent_count == 1);
+	DUK_ASSERT(heap->ms_running == 1);
+	heap->ms_prevent_count = 0;
+	heap->ms_running = 0;
+	heap->creating_error = entry_creating_error;
+
+	if (!done) {
+		/* Next slice after a fixed number of allocations. */
+		heap->ms_trigger_counter = DUK_HEAP_MARK_AND_SWEEP_INCR_INTERVAL;
+	}
+	return done;
+}
+#endif  /* DUK_USE_MARK_AND_SWEEP_INCREMENTAL */
+
+/*
+ *  Generational mark-and-sweep.
+ *
+ *  New objects are inserted at the heap_allocated head so the young
+ *  generation is a prefix of the list.  It's split into bands by
+ *  ms_gen_bounds: ms_gen_bounds[i] is the first object which has survived
+ *  at least i+1 minor collections, and the last bound is the first old
+ *  object (NULL if none).  Old objects keep REACHABLE set between
+ *  collections so that marking stops at them.
+ *
+ *  A minor collection only processes the young generation:
+ *
+ *    1. Find young objects referenced from outside the young generation
+ *       using refcounts: subtract references from young objects (trial
+ *       deletion), mark objects with a non-zero remainder as TEMPROOT,
+ *       and restore the refcounts.  No write barrier is needed because
+ *       every reference is counted, including value stack references.
+ *       References from old garbage keep young objects alive until the
+ *       next full collection.
+ *
+ *    2. Mark from the TEMPROOT objects and finalize_list, then handle
+ *       finalizable objects like a full collection.  Rescue decisions are
+ *       always postponed because the roots are conservative.
+ *
+ *    3. Sweep the young generation.  Survivors of the last band become
+ *       old by getting their REACHABLE flag set.
+ *
+ *  Strings are only freed by refcounting and full collections.  A full
+ *  collection is done when enough objects have been promoted since the
+ *  previous one, and for explicit and emergency GC requests.  It starts
+ *  by clearing the old generation marks and promotes all survivors.
+ */
+
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+/* Subtract (adjust < 0) or restore (adjust > 0) the refcount
+ * contributions of young objects to other young objects.
+ */
+DUK_LOCAL void duk__gen_adjust_refcounts(duk_heap *heap, duk_heaphdr *end, duk_small_int_t adjust) {
+	duk_heaphdr *hdr;
+
+	DUK_ASSERT(heap->ms_gen_minor);
+	DUK_ASSERT(heap->ms_gen_adjust == 0);
+
+	heap->ms_gen_adjust = adjust;
+	for (hdr = heap->heap_allocated; hdr != end; hdr = DUK_HEAPHDR_GET_NEXT(heap, hdr)) {
+		DUK_ASSERT(!DUK_HEAPHDR_HAS_REACHABLE(hdr));
+		if (DUK_HEAPHDR_IS_OBJECT(hdr)) {
+			duk__mark_hobject(heap, (duk_hobject *) hdr);
+		}
+	}
+	heap->ms_gen_adjust = 0;
+}
+
+DUK_LOCAL void duk__gen_sweep(duk_heap *heap, duk_small_uint_t flags) {
+	duk_heaphdr *first[DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE];  /* first survivor in each band */
+	duk_heaphdr *old_start;
+	duk_heaphdr *curr;
+	duk_heaphdr *next;
+	duk_small_uint_t band;
+	duk_small_uint_t i;
+	duk_small_uint_t res;
+	duk_size_t count_promote = 0;
+#if defined(DUK_USE_DEBUG)
+	duk_size_t count_keep = 0;
+	duk_size_t count_free = 0;
+	duk_size_t count_finalize = 0;
+#endif
+
+	old_start = DUK_HEAP_GEN_OLD_START(heap);
+	for (i = 0; i < DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE; i++) {
+		first[i] = NULL;
+	}
+
+	band = 0;
+	curr = heap->heap_allocated;
+	while (curr != old_start) {
+		/* Band boundaries are checked before 'curr' may be freed. */
+		while (curr == heap->ms_gen_bounds[band]) {
+			band++;
+			DUK_ASSERT(band < DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE);
+		}
+		next = DUK_HEAPHDR_GET_NEXT(heap, curr);
+
+		res = duk__sweep_object(heap, curr, flags);
+		if (res == DUK__SWEEP_KEEP || res == DUK__SWEEP_RESCUE) {
+			if (first[band] == NULL) {
+				first[band] = curr;
+			}
+			if (band == DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE - 1) {
+				DUK_HEAPHDR_SET_REACHABLE(curr);
+				count_promote++;
+			}
+#if defined(DUK_USE_DEBUG)
+			count_keep++;
+#endif
+		} else {
+			duk__sweep_unlink(heap, curr);
+			if (res == DUK__SWEEP_FREE) {
+#if defined(DUK_USE_DEBUG)
+				count_free++;
+#endif
+				duk_heap_free_heaphdr_raw(heap, curr);
+			} else {
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+				DUK_ASSERT(res == DUK__SWEEP_FINALIZE);
+#if defined(DUK_USE_DEBUG)
+				count_finalize++;
+#endif
+				DUK_HEAP_INSERT_INTO_FINALIZE_LIST(heap, curr);
+#else
+				DUK_UNREACHABLE();
+#endif
+			}
+		}
+		curr = next;
+	}
+
+	/* New bound i is the first survivor of a band >= i, or the start of
+	 * the old generation if there's none.
+	 */
+	curr = old_start;
+	for (i = DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE; i-- > 0;) {
+		if (first[i] != NULL) {
+			curr = first[i];
+		}
+		heap->ms_gen_bounds[i] = curr;
+	}
+	heap->ms_gen_promoted += count_promote;
+
+#if defined(DUK_USE_DEBUG)
+	DUK_D(DUK_DPRINT("minor collection: %ld young objects kept, %ld promoted, %ld freed, %ld finalizable",
+	                 (long) count_keep, (long) count_promote, (long) count_free, (long) count_finalize));
+#endif
+}
+
+/* Minor collection, caller has checked ms_prevent_count. */
+DUK_LOCAL void duk__gen_minor(duk_heap *heap, duk_small_uint_t flags) {
+	duk_heaphdr *old_start;
+	duk_heaphdr *hdr;
+	duk_bool_t entry_creating_error;
+
+	DUK_D(DUK_DPRINT("minor collection starting, promoted since last full collection: %ld, limit: %ld",
+	                 (long) heap->ms_gen_promoted, (long) heap->ms_gen_old_limit));
+
+	flags |= heap->ms_base_flags | DUK_MS_FLAG_POSTPONE_RESCUE;
+
+#if defined(DUK_USE_ASSERTIONS)
+	DUK_ASSERT(heap->ms_prevent_count == 0);
+	DUK_ASSERT(heap->ms_running == 0);
+	DUK_ASSERT(!DUK_HEAP_HAS_MARKANDSWEEP_RECLIMIT_REACHED(heap));
+	DUK_ASSERT(heap->ms_recursion_depth == 0);
+	/* Strings aren't touched so the string table isn't validated, it
+	 * may be large compared to the young generation.
+	 */
+	duk__assert_heaphdr_flags(heap);
+	duk__assert_valid_refcounts(heap);
+#endif
+
+	heap->ms_prevent_count = 1;
+	heap->ms_running = 1;
+	entry_creating_error = heap->creating_error;
+	heap->creating_error = 0;
+	heap->ms_gen_minor = 1;
+	old_start = DUK_HEAP_GEN_OLD_START(heap);
+
+	/* Young objects with references from outside the young generation
+	 * are the roots for marking.
+	 */
+	duk__gen_adjust_refcounts(heap, old_start, -1);
+	for (hdr = heap->heap_allocated; hdr != old_start; hdr = DUK_HEAPHDR_GET_NEXT(heap, hdr)) {
+		if (DUK_HEAPHDR_GET_REFCOUNT(hdr) > 0) {
+			DUK_HEAPHDR_SET_TEMPROOT(hdr);
+		}
+	}
+	duk__gen_adjust_refcounts(heap, old_start, 1);
+
+	DUK_HEAP_SET_MARKANDSWEEP_RECLIMIT_REACHED(heap);
+	duk__mark_temproots_by_heap_scan(heap);
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+	duk__mark_finalizable(heap);
+	duk__mark_finalize_list(heap);
+#endif
+	duk__mark_temproots_by_heap_scan(heap);
+
+	duk__finalize_refcounts(heap);
+	duk__gen_sweep(heap, flags);
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+	duk__clear_finalize_list_flags(heap);
+#endif
+
+	heap->ms_gen_minor = 0;
+	heap->ms_prevent_count = 0;
+	heap->ms_running = 0;
+	heap->creating_error = entry_creating_error;
+
+#if defined(DUK_USE_ASSERTIONS)
+	DUK_ASSERT(!DUK_HEAP_HAS_MARKANDSWEEP_RECLIMIT_REACHED(heap));
+	DUK_ASSERT(heap->ms_recursion_depth == 0);
+	duk__assert_heaphdr_flags(heap);
+	duk__assert_valid_refcounts(heap);
+#endif
+
+	duk__reset_trigger(heap, 0);
+}
+
+/* Prepare for a full collection: clear old generation marks so that the
+ * whole heap looks young.
+ */
+DUK_LOCAL void duk__gen_clear_old(duk_heap *heap) {
+	duk_heaphdr *hdr;
+	duk_small_uint_t i;
+
+	for (hdr = DUK_HEAP_GEN_OLD_START(heap); hdr != NULL; hdr = DUK_HEAPHDR_GET_NEXT(heap, hdr)) {
+		DUK_ASSERT(DUK_HEAPHDR_HAS_REACHABLE(hdr));
+		DUK_HEAPHDR_CLEAR_REACHABLE(hdr);
+	}
+	for (i = 0; i < DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE; i++) {
+		heap->ms_gen_bounds[i] = NULL;
+	}
+}
+
+/* After a full collection sweep all survivors are old. */
+DUK_LOCAL void duk__gen_promote_all(duk_heap *heap, duk_size_t count_keep) {
+	duk_small_uint_t i;
+
+	for (i = 0; i < DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE; i++) {
+		heap->ms_gen_bounds[i] = heap->heap_allocated;
+	}
+	heap->ms_gen_promoted = 0;
+	heap->ms_gen_old_limit = count_keep;
+	if (heap->ms_gen_old_limit < DUK_HEAP_MARK_AND_SWEEP_TRIGGER_ADD) {
+		heap->ms_gen_old_limit = DUK_HEAP_MARK_AND_SWEEP_TRIGGER_ADD;
+	}
+}
+#endif  /* DUK_USE_MARK_AND_SWEEP_GENERATIONAL */
+
 /*
  *  Main mark-and-sweep function.
  *
@@ -1197,9 +1954,6 @@ DUK_LOCAL void duk__dump_stats(duk_heap *heap) {
 DUK_INTERNAL void duk_heap_mark_and_sweep(duk_heap *heap, duk_small_uint_t flags) {
 	duk_size_t count_keep_obj;
 	duk_size_t count_keep_str;
-#if defined(DUK_USE_VOLUNTARY_GC)
-	duk_size_t tmp;
-#endif
 	duk_bool_t entry_creating_error;
 
 	DUK_STATS_INC(heap, stats_ms_try_count);
@@ -1233,6 +1987,38 @@ DUK_INTERNAL void duk_heap_mark_and_sweep(duk_heap *heap, duk_small_uint_t flags
 	DUK_ASSERT(heap->heap_thread != NULL);
 	DUK_ASSERT(heap->heap_thread->valstack != NULL);
 
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	/* Voluntary GC runs one incremental slice; other requests finish
+	 * the cycle in progress (without running finalizers yet) and then
+	 * do a normal mark-and-sweep.
+	 */
+	if (flags & DUK_MS_FLAG_INCREMENTAL) {
+		if (duk__incr_run(heap, flags | heap->ms_base_flags, 0 /*to_completion*/)) {
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+			duk_heap_process_finalize_list(heap);
+#endif
+		}
+		return;
+	}
+	if (heap->ms_incr_phase != DUK_HEAP_MS_INCR_IDLE) {
+		DUK_D(DUK_DPRINT("finish incremental mark-and-sweep cycle before full mark-and-sweep"));
+		(void) duk__incr_run(heap, 0, 1 /*to_completion*/);
+	}
+#endif
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	/* Voluntary GC runs a minor collection unless enough objects have
+	 * been promoted since the last full collection.
+	 */
+	if ((flags & DUK_MS_FLAG_MINOR) && heap->ms_gen_promoted < heap->ms_gen_old_limit) {
+		duk__gen_minor(heap, flags);
+#if defined(DUK_USE_FINALIZER_SUPPORT)
+		duk_heap_process_finalize_list(heap);
+#endif
+		return;
+	}
+	duk__gen_clear_old(heap);
+#endif
+
 	DUK_D(DUK_DPRINT("garbage collect (mark-and-sweep) starting, requested flags: 0x%08lx, effective flags: 0x%08lx",
 	                 (unsigned long) flags, (unsigned long) (flags | heap->ms_base_flags)));
 
@@ -1337,6 +2123,9 @@ DUK_INTERNAL void duk_heap_mark_and_sweep(duk_heap *heap, duk_small_uint_t flags
 	duk__finalize_refcounts(heap);
 #endif
 	duk__sweep_heap(heap, flags, &count_keep_obj);
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	duk__gen_promote_all(heap, count_keep_obj);
+#endif
 	duk__sweep_stringtable(heap, &count_keep_str);
 #if defined(DUK_USE_ASSERTIONS) && defined(DUK_USE_REFERENCE_COUNTING)
 	duk__check_assert_refcounts(heap);
@@ -1395,6 +2184,18 @@ DUK_INTERNAL void duk_heap_mark_and_sweep(duk_heap *heap, duk_small_uint_t flags
 		duk_heap_strtable_force_resize(heap);
 	}
 
+	/*
+	 *  Return empty slab pages to the allocation functions (emergency
+	 *  only), normally one empty page per size class is kept.
+	 */
+
+#if defined(DUK_USE_ALLOC_SLAB)
+	if (flags & DUK_MS_FLAG_EMERGENCY) {
+		DUK_D(DUK_DPRINT("release empty slab pages in emergency gc"));
+		duk_heap_slab_trim(heap);
+	}
+#endif
+
 	/*
 	 *  Finish
 	 */
@@ -1431,10 +2232,7 @@ DUK_INTERNAL void duk_heap_mark_and_sweep(duk_heap *heap, duk_small_uint_t flags
 	 */
 
 #if defined(DUK_USE_VOLUNTARY_GC)
-	tmp = (count_keep_obj + count_keep_str) / 256;
-	heap->ms_trigger_counter = (duk_int_t) (
-	    (tmp * DUK_HEAP_MARK_AND_SWEEP_TRIGGER_MULT) +
-	    DUK_HEAP_MARK_AND_SWEEP_TRIGGER_ADD);
+	duk__reset_trigger(heap, count_keep_obj + count_keep_str);
 	DUK_D(DUK_DPRINT("garbage collect (mark-and-sweep) finished: %ld objects kept, %ld strings kept, trigger reset to %ld",
 	                 (long) count_keep_obj, (long) count_keep_str, (long) heap->ms_trigger_counter));
 #else
@@ -15,6 +15,33 @@ DUK_LOCAL duk_bool_t duk__heap_suppress_debuglog(duk_heap *heap) {
 	return heap->heap_object == NULL;
 }
 
+/* Mark-and-sweep flags for the i'th garbage collection attempt in an
+ * allocation slow path.  The first attempt of a voluntary GC (trigger
+ * counter expired) may run a single incremental slice or a minor
+ * collection; if the allocation still fails, later attempts run full and
+ * eventually emergency GCs.
+ */
+DUK_LOCAL duk_small_uint_t duk__heap_gc_flags(duk_heap *heap, duk_small_int_t i) {
+	duk_small_uint_t flags;
+
+	DUK_UNREF(heap);
+
+	flags = 0;
+	if (i >= DUK_HEAP_ALLOC_FAIL_MARKANDSWEEP_EMERGENCY_LIMIT - 1) {
+		flags |= DUK_MS_FLAG_EMERGENCY;
+	}
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	else if (i == 0 && heap->ms_trigger_counter < 0) {
+		flags |= DUK_MS_FLAG_INCREMENTAL;
+	}
+#elif defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	else if (i == 0 && heap->ms_trigger_counter < 0) {
+		flags |= DUK_MS_FLAG_MINOR;
+	}
+#endif
+	return flags;
+}
+
 /* Slow path: voluntary GC triggered, first alloc attempt failed, or zero size. */
 DUK_LOCAL DUK_NOINLINE_PERF DUK_COLD void *duk__heap_mem_alloc_slowpath(duk_heap *heap, duk_size_t size) {
 	void *res;
@@ -57,15 +84,12 @@ DUK_LOCAL DUK_NOINLINE_PERF DUK_COLD void *duk__heap_mem_alloc_slowpath(duk_heap
 	for (i = 0; i < DUK_HEAP_ALLOC_FAIL_MARKANDSWEEP_LIMIT; i++) {
 		duk_small_uint_t flags;
 
-		flags = 0;
-		if (i >= DUK_HEAP_ALLOC_FAIL_MARKANDSWEEP_EMERGENCY_LIMIT - 1) {
-			flags |= DUK_MS_FLAG_EMERGENCY;
-		}
+		flags = duk__heap_gc_flags(heap, i);
 
 		duk_heap_mark_and_sweep(heap, flags);
 
 		DUK_ASSERT(size > 0);
-		res = heap->alloc_func(heap->heap_udata, size);
+		res = DUK_ALLOC_RAW(heap, size);
 		if (res != NULL) {
 			if (!duk__heap_suppress_debuglog(heap)) {
 				DUK_D(DUK_DPRINT("duk_heap_mem_alloc() succeeded after gc (pass %ld), alloc size %ld",
@@ -109,7 +133,7 @@ DUK_INTERNAL DUK_INLINE_PERF DUK_HOT void *duk_heap_mem_alloc(duk_heap *heap, du
 	 * don't check zero size on NULL; handle it in the slow path
 	 * instead.  This reduces size of inlined code.
 	 */
-	res = heap->alloc_func(heap->heap_udata, size);
+	res = DUK_ALLOC_RAW(heap, size);
 	if (DUK_LIKELY(res != NULL)) {
 		return res;
 	}
@@ -223,15 +247,12 @@ DUK_LOCAL DUK_NOINLINE_PERF DUK_COLD void *duk__heap_mem_realloc_slowpath(duk_he
 	for (i = 0; i < DUK_HEAP_ALLOC_FAIL_MARKANDSWEEP_LIMIT; i++) {
 		duk_small_uint_t flags;
 
-		flags = 0;
-		if (i >= DUK_HEAP_ALLOC_FAIL_MARKANDSWEEP_EMERGENCY_LIMIT - 1) {
-			flags |= DUK_MS_FLAG_EMERGENCY;
-		}
+		flags = duk__heap_gc_flags(heap, i);
 
 		duk_heap_mark_and_sweep(heap, flags);
 
 		DUK_ASSERT(newsize > 0);
-		res = heap->realloc_func(heap->heap_udata, ptr, newsize);
+		res = DUK_REALLOC_RAW(heap, ptr, newsize);
 		if (res || newsize == 0) {
 			if (!duk__heap_suppress_debuglog(heap)) {
 				DUK_D(DUK_DPRINT("duk_heap_mem_realloc() succeeded after gc (pass %ld), alloc size %ld",
@@ -272,7 +293,7 @@ DUK_INTERNAL DUK_INLINE_PERF DUK_HOT void *duk_heap_mem_realloc(duk_heap *heap,
 	}
 #endif
 
-	res = heap->realloc_func(heap->heap_udata, ptr, newsize);
+	res = DUK_REALLOC_RAW(heap, ptr, newsize);
 	if (DUK_LIKELY(res != NULL)) {
 		return res;
 	}
@@ -341,10 +362,7 @@ DUK_LOCAL DUK_NOINLINE_PERF DUK_COLD void *duk__heap_mem_realloc_indirect_slowpa
 #if defined(DUK_USE_DEBUG)
 		ptr_pre = cb(heap, ud);
 #endif
-		flags = 0;
-		if (i >= DUK_HEAP_ALLOC_FAIL_MARKANDSWEEP_EMERGENCY_LIMIT - 1) {
-			flags |= DUK_MS_FLAG_EMERGENCY;
-		}
+		flags = duk__heap_gc_flags(heap, i);
 
 		duk_heap_mark_and_sweep(heap, flags);
 #if defined(DUK_USE_DEBUG)
@@ -360,7 +378,7 @@ DUK_LOCAL DUK_NOINLINE_PERF DUK_COLD void *duk__heap_mem_realloc_indirect_slowpa
 		 */
 
 		DUK_ASSERT(newsize > 0);
-		res = heap->realloc_func(heap->heap_udata, cb(heap, ud), newsize);
+		res = DUK_REALLOC_RAW(heap, cb(heap, ud), newsize);
 		if (res || newsize == 0) {
 			if (!duk__heap_suppress_debuglog(heap)) {
 				DUK_D(DUK_DPRINT("duk_heap_mem_realloc_indirect() succeeded after gc (pass %ld), alloc size %ld",
@@ -400,7 +418,7 @@ DUK_INTERNAL DUK_INLINE_PERF DUK_HOT void *duk_heap_mem_realloc_indirect(duk_hea
 	}
 #endif
 
-	res = heap->realloc_func(heap->heap_udata, cb(heap, ud), newsize);
+	res = DUK_REALLOC_RAW(heap, cb(heap, ud), newsize);
 	if (DUK_LIKELY(res != NULL)) {
 		return res;
 	}
@@ -429,7 +447,7 @@ DUK_INTERNAL DUK_INLINE_PERF DUK_HOT void duk_heap_mem_free(duk_heap *heap, void
 	/* Must behave like a no-op with NULL and any pointer returned from
 	 * malloc/realloc with zero size.
 	 */
-	heap->free_func(heap->heap_udata, ptr);
+	DUK_FREE_RAW(heap, ptr);
 
 	/* Never perform a GC (even voluntary) in a memory free, otherwise
 	 * all call sites doing frees would need to deal with the side effects.
@@ -51,6 +51,27 @@ DUK_INTERNAL void duk_heap_remove_from_heap_allocated(duk_heap *heap, duk_heaphd
 	prev = DUK_HEAPHDR_GET_PREV(heap, hdr);
 	next = DUK_HEAPHDR_GET_NEXT(heap, hdr);
 
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	/* Keep incremental mark-and-sweep list positions valid. */
+	if (DUK_UNLIKELY(hdr == heap->ms_incr_cursor)) {
+		heap->ms_incr_cursor = next;
+	}
+	if (DUK_UNLIKELY(hdr == heap->ms_incr_sweep_start)) {
+		heap->ms_incr_sweep_start = next;
+	}
+#endif
+#if defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+	/* Keep generation boundaries valid. */
+	{
+		duk_small_uint_t i;
+		for (i = 0; i < DUK_USE_MARK_AND_SWEEP_GEN_PROMOTE; i++) {
+			if (DUK_UNLIKELY(hdr == heap->ms_gen_bounds[i])) {
+				heap->ms_gen_bounds[i] = next;
+			}
+		}
+	}
+#endif
+
 	if (prev != NULL) {
 		DUK_ASSERT(heap->heap_allocated != hdr);
 		DUK_HEAPHDR_SET_NEXT(heap, prev, next);
@@ -70,6 +91,17 @@ DUK_INTERNAL void duk_heap_remove_from_heap_allocated(duk_heap *heap, duk_heaphd
 DUK_INTERNAL void duk_heap_insert_into_finalize_list(duk_heap *heap, duk_heaphdr *hdr) {
 	duk_heaphdr *root;
 
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	/* Finalizer calls during incremental marking may make finalized
+	 * objects look reachable, so postpone rescue decisions for the
+	 * cycle like a full mark-and-sweep does when finalize_list is
+	 * non-empty.
+	 */
+	if (heap->ms_incr_phase == DUK_HEAP_MS_INCR_MARK) {
+		heap->ms_incr_flags |= DUK_MS_FLAG_POSTPONE_RESCUE;
+	}
+#endif
+
 	root = heap->finalize_list;
 #if defined(DUK_USE_DOUBLE_LINKED_HEAP)
 	DUK_HEAPHDR_SET_PREV(heap, hdr, NULL);
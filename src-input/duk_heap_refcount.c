@@ -380,6 +380,15 @@ DUK_LOCAL DUK_INLINE void duk__refcount_refzero_hobject(duk_heap *heap, duk_hobj
 			 * objects pending finalization.
 			 */
 			DUK_HEAPHDR_PREINC_REFCOUNT(hdr);
+#endif
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL) || defined(DUK_USE_MARK_AND_SWEEP_GENERATIONAL)
+			/* An incremental mark-and-sweep may have marked the
+			 * object before it became garbage, and old generation
+			 * objects are always marked; objects on finalize_list
+			 * must be unmarked.
+			 */
+			DUK_HEAPHDR_CLEAR_REACHABLE(hdr);
+			DUK_HEAPHDR_CLEAR_TEMPROOT(hdr);
 #endif
 			DUK_HEAP_INSERT_INTO_FINALIZE_LIST(heap, hdr);
 
@@ -468,6 +477,18 @@ DUK_LOCAL DUK_INLINE void duk__refcount_refzero_hstring(duk_heap *heap, duk_hstr
 	DUK_ASSERT(str != NULL);
 	DUK_ASSERT(DUK_HEAPHDR_GET_TYPE((duk_heaphdr *) str) == DUK_HTYPE_STRING);
 
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+	/* Once an incremental mark-and-sweep has finished marking, garbage
+	 * objects waiting to be swept may still point to strings whose
+	 * refcount has already been finalized.  Leave such strings to the
+	 * string table sweep at the end of the cycle so that their address
+	 * can't be reused for another string in the meantime.
+	 */
+	if (DUK_UNLIKELY(heap->ms_incr_phase > DUK_HEAP_MS_INCR_MARK)) {
+		return;
+	}
+#endif
+
 	duk_heap_strcache_string_remove(heap, str);
 	duk_heap_strtable_unlink(heap, str);
 	duk_free_hstring(heap, str);
@@ -675,8 +696,10 @@ DUK_INTERNAL DUK_NOINLINE void duk_hobject_refzero_norz(duk_hthread *thr, duk_ho
 }
 
 #if !defined(DUK_USE_FAST_REFCOUNT_DEFAULT)
-DUK_INTERNAL void duk_tval_incref(duk_tval *tv) {
+DUK_INTERNAL void duk_tval_incref(duk_hthread *thr, duk_tval *tv) {
+	DUK_ASSERT(thr != NULL);
 	DUK_ASSERT(tv != NULL);
+	DUK_UNREF(thr);
 
 	if (DUK_TVAL_NEEDS_REFCOUNT_UPDATE(tv)) {
 		duk_heaphdr *h = DUK_TVAL_GET_HEAPHDR(tv);
@@ -685,6 +708,7 @@ DUK_INTERNAL void duk_tval_incref(duk_tval *tv) {
 		DUK_ASSERT_DISABLE(h->h_refcount >= 0);
 		DUK_HEAPHDR_PREINC_REFCOUNT(h);
 		DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT(h) != 0);  /* No wrapping. */
+		DUK_HEAPHDR_MARK_BARRIER(thr, h);
 	}
 }
 
@@ -768,12 +792,15 @@ DUK_INTERNAL void duk_tval_decref_norz(duk_hthread *thr, duk_tval *tv) {
 /* This will in practice be inlined because it's just an INC instructions
  * and a bit test + INC when ROM objects are enabled.
  */
-DUK_INTERNAL void duk_heaphdr_incref(duk_heaphdr *h) {
+DUK_INTERNAL void duk_heaphdr_incref(duk_hthread *thr, duk_heaphdr *h) {
+	DUK_ASSERT(thr != NULL);
 	DUK_ASSERT(h != NULL);
 	DUK_ASSERT(DUK_HEAPHDR_HTYPE_VALID(h));
 	DUK_ASSERT_DISABLE(DUK_HEAPHDR_GET_REFCOUNT(h) >= 0);
+	DUK_UNREF(thr);
 
 	DUK__INCREF_SHARED();
+	DUK_HEAPHDR_MARK_BARRIER(thr, h);
 }
 
 DUK_INTERNAL void duk_heaphdr_decref(duk_hthread *thr, duk_heaphdr *h) {
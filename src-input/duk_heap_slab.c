@@ -0,0 +1,425 @@
+/*
+ *  Size-class slab allocator (DUK_USE_ALLOC_SLAB).
+ *
+ *  Small allocations are served from fixed size pages requested from the
+ *  heap allocation functions.  Each page holds chunks of a single size
+ *  class.  Freed chunks go to a per-page free list, and pages with free
+ *  chunks are kept in a per-class list so that allocation is normally a
+ *  list pop.  Size classes are spaced 8 bytes apart up to 128 bytes, so
+ *  fixed size structs (duk_hobject variants, duk_activation, duk_catcher,
+ *  etc) fit a class without slack, and 16 bytes apart up to 256 bytes for
+ *  short strings and small property tables.  A heap is only used from one
+ *  native thread at a time so the lists need no locking.
+ *
+ *  The allocation functions don't guarantee page alignment, so the page
+ *  of a pointer is found using a hash table keyed by the page index
+ *  (address >> DUK_HEAP_SLAB_PAGE_SHIFT) of each page's start address.
+ *  A pointer belongs to a page starting at the pointer's page index or the
+ *  one before it.  Pointers which aren't found came directly from the
+ *  allocation functions (large allocations and a few allocations made
+ *  during heap init) and are passed through.
+ *
+ *  A page whose last chunk is freed is returned to the allocation
+ *  functions unless it's the only empty page of its class; keeping one
+ *  avoids thrashing when usage oscillates around a page boundary.
+ *  Emergency GC releases the remaining empty pages too.
+ */
+
+#include "duk_internal.h"
+
+#if defined(DUK_USE_ALLOC_SLAB)
+
+#define DUK__SLAB_HEADER_SIZE   ((sizeof(duk_slab_page) + 7U) & ~((duk_size_t) 7U))
+#define DUK__SLAB_PAGE_DATA(page)  ((duk_uint8_t *) (page) + DUK__SLAB_HEADER_SIZE)
+#define DUK__SLAB_TABLE_MINSIZE  64
+
+#if (DUK_HEAP_SLAB_MAX_SIZE != 256) || (DUK_HEAP_SLAB_NUM_CLASSES != 24)
+#error slab size class mapping assumes 24 classes up to 256 bytes
+#endif
+
+/* Size class for an allocation size in [1, DUK_HEAP_SLAB_MAX_SIZE]. */
+#define DUK__SLAB_CLASS(size) \
+	((size) <= 128U ? (duk_small_uint_t) (((size) - 1U) >> 3) : \
+	                  (duk_small_uint_t) (16U + (((size) - 129U) >> 4)))
+
+/* Chunk size and number of chunks in a page for each size class. */
+DUK_LOCAL duk_size_t duk__slab_chunk_size(duk_small_uint_t cls) {
+	DUK_ASSERT(cls < DUK_HEAP_SLAB_NUM_CLASSES);
+	if (cls < 16U) {
+		return (duk_size_t) (cls + 1U) * 8U;
+	}
+	return (duk_size_t) 128U + (duk_size_t) (cls - 15U) * 16U;
+}
+
+DUK_LOCAL duk_uint16_t duk__slab_chunk_count(duk_small_uint_t cls) {
+	return (duk_uint16_t) ((DUK_HEAP_SLAB_PAGE_SIZE - DUK__SLAB_HEADER_SIZE) / duk__slab_chunk_size(cls));
+}
+
+/*
+ *  Page hash table
+ */
+
+DUK_LOCAL duk_uint32_t duk__slab_hash(duk_uintptr_t key, duk_uint32_t mask) {
+	return (duk_uint32_t) (((duk_uint32_t) key * 0x9e3779b1UL) & mask);
+}
+
+DUK_LOCAL duk_uintptr_t duk__slab_page_key(duk_slab_page *page) {
+	return (duk_uintptr_t) page >> DUK_HEAP_SLAB_PAGE_SHIFT;
+}
+
+DUK_LOCAL duk_slab_page *duk__slab_probe(duk_slab *slab, duk_uintptr_t key, duk_uintptr_t addr) {
+	duk_uint32_t mask;
+	duk_uint32_t i;
+	duk_slab_page *page;
+
+	mask = slab->pages_size - 1U;
+	i = duk__slab_hash(key, mask);
+	for (;;) {
+		page = slab->pages[i];
+		if (page == NULL) {
+			return NULL;
+		}
+		/* Pages don't overlap, so any page containing 'addr' is the
+		 * right one even if it was inserted with another key.
+		 */
+		if (addr - (duk_uintptr_t) page < (duk_uintptr_t) DUK_HEAP_SLAB_PAGE_SIZE) {
+			return page;
+		}
+		i = (i + 1U) & mask;
+	}
+}
+
+DUK_LOCAL duk_slab_page *duk__slab_lookup(duk_slab *slab, void *ptr) {
+	duk_uintptr_t addr;
+	duk_uintptr_t key;
+	duk_slab_page *page;
+
+	if (slab->pages_used == 0 || ptr == NULL) {
+		return NULL;
+	}
+	addr = (duk_uintptr_t) ptr;
+	key = addr >> DUK_HEAP_SLAB_PAGE_SHIFT;
+	page = duk__slab_probe(slab, key, addr);
+	if (page == NULL && key > 0) {
+		page = duk__slab_probe(slab, key - 1U, addr);
+	}
+	DUK_ASSERT(page == NULL || (duk_uint8_t *) ptr >= DUK__SLAB_PAGE_DATA(page));
+	return page;
+}
+
+DUK_LOCAL void duk__slab_table_put(duk_slab *slab, duk_slab_page *page) {
+	duk_uint32_t mask;
+	duk_uint32_t i;
+
+	mask = slab->pages_size - 1U;
+	i = duk__slab_hash(duk__slab_page_key(page), mask);
+	while (slab->pages[i] != NULL) {
+		i = (i + 1U) & mask;
+	}
+	slab->pages[i] = page;
+}
+
+DUK_LOCAL duk_bool_t duk__slab_table_insert(duk_heap *heap, duk_slab_page *page) {
+	duk_slab *slab;
+	duk_slab_page **old_pages;
+	duk_uint32_t old_size;
+	duk_uint32_t new_size;
+	duk_uint32_t i;
+
+	slab = &heap->slab;
+	if ((slab->pages_used + 1U) * 2U > slab->pages_size) {
+		old_pages = slab->pages;
+		old_size = slab->pages_size;
+		new_size = (old_size == 0 ? DUK__SLAB_TABLE_MINSIZE : old_size * 2U);
+		if (new_size <= old_size) {
+			return 0;  /* wrapped */
+		}
+
+		slab->pages = (duk_slab_page **) heap->alloc_func(heap->heap_udata, sizeof(duk_slab_page *) * new_size);
+		if (slab->pages == NULL) {
+			slab->pages = old_pages;
+			return 0;
+		}
+		duk_memzero((void *) slab->pages, sizeof(duk_slab_page *) * new_size);
+		slab->pages_size = new_size;
+		for (i = 0; i < old_size; i++) {
+			if (old_pages[i] != NULL) {
+				duk__slab_table_put(slab, old_pages[i]);
+			}
+		}
+		heap->free_func(heap->heap_udata, (void *) old_pages);
+		DUK_DD(DUK_DDPRINT("slab page table resized to %ld entries", (long) new_size));
+	}
+
+	duk__slab_table_put(slab, page);
+	slab->pages_used++;
+	return 1;
+}
+
+/* Remove a page with backward shift deletion to keep probe sequences
+ * intact without tombstones.
+ */
+DUK_LOCAL void duk__slab_table_remove(duk_slab *slab, duk_slab_page *page) {
+	duk_uint32_t mask;
+	duk_uint32_t i;
+	duk_uint32_t j;
+	duk_uint32_t home;
+	duk_slab_page *other;
+
+	mask = slab->pages_size - 1U;
+	i = duk__slab_hash(duk__slab_page_key(page), mask);
+	while (slab->pages[i] != page) {
+		DUK_ASSERT(slab->pages[i] != NULL);
+		i = (i + 1U) & mask;
+	}
+	slab->pages_used--;
+
+	for (;;) {
+		slab->pages[i] = NULL;
+		j = i;
+		for (;;) {
+			j = (j + 1U) & mask;
+			other = slab->pages[j];
+			if (other == NULL) {
+				return;
+			}
+			/* 'other' can fill the hole unless its home slot is
+			 * cyclically within (i, j].
+			 */
+			home = duk__slab_hash(duk__slab_page_key(other), mask);
+			if (i <= j ? (home <= i || home > j) : (home <= i && home > j)) {
+				break;
+			}
+		}
+		slab->pages[i] = other;
+		i = j;
+	}
+}
+
+/*
+ *  Pages
+ */
+
+DUK_LOCAL void duk__slab_avail_link(duk_slab *slab, duk_slab_page *page) {
+	duk_slab_page *next;
+
+	next = slab->avail[page->cls];
+	page->prev = NULL;
+	page->next = next;
+	if (next != NULL) {
+		next->prev = page;
+	}
+	slab->avail[page->cls] = page;
+}
+
+DUK_LOCAL void duk__slab_avail_unlink(duk_slab *slab, duk_slab_page *page) {
+	if (page->prev != NULL) {
+		page->prev->next = page->next;
+	} else {
+		DUK_ASSERT(slab->avail[page->cls] == page);
+		slab->avail[page->cls] = page->next;
+	}
+	if (page->next != NULL) {
+		page->next->prev = page->prev;
+	}
+}
+
+DUK_LOCAL duk_slab_page *duk__slab_page_new(duk_heap *heap, duk_small_uint_t cls) {
+	duk_slab_page *page;
+
+	page = (duk_slab_page *) heap->alloc_func(heap->heap_udata, DUK_HEAP_SLAB_PAGE_SIZE);
+	if (page == NULL) {
+		return NULL;
+	}
+	if (!duk__slab_table_insert(heap, page)) {
+		heap->free_func(heap->heap_udata, (void *) page);
+		return NULL;
+	}
+
+	page->free_list = NULL;
+	page->used = 0;
+	page->fresh = 0;
+	page->cls = (duk_uint8_t) cls;
+	duk__slab_avail_link(&heap->slab, page);
+	heap->slab.empty[cls]++;
+
+	DUK_DD(DUK_DDPRINT("new slab page %p for size class %ld", (void *) page, (long) cls));
+	return page;
+}
+
+DUK_LOCAL void duk__slab_page_release(duk_heap *heap, duk_slab_page *page) {
+	DUK_ASSERT(page->used == 0);
+
+	DUK_DD(DUK_DDPRINT("release slab page %p for size class %ld", (void *) page, (long) page->cls));
+	duk__slab_avail_unlink(&heap->slab, page);
+	duk__slab_table_remove(&heap->slab, page);
+	heap->free_func(heap->heap_udata, (void *) page);
+}
+
+DUK_LOCAL void *duk__slab_page_take(duk_slab *slab, duk_slab_page *page) {
+	void *res;
+	duk_small_uint_t cls;
+
+	cls = page->cls;
+	res = page->free_list;
+	if (res != NULL) {
+		page->free_list = *((void **) res);
+	} else {
+		DUK_ASSERT(page->fresh < duk__slab_chunk_count(cls));
+		res = (void *) (DUK__SLAB_PAGE_DATA(page) + (duk_size_t) page->fresh * duk__slab_chunk_size(cls));
+		page->fresh++;
+	}
+
+	if (page->used == 0) {
+		DUK_ASSERT(slab->empty[cls] > 0);
+		slab->empty[cls]--;
+	}
+	page->used++;
+	if (page->used == duk__slab_chunk_count(cls)) {
+		duk__slab_avail_unlink(slab, page);
+	}
+	return res;
+}
+
+DUK_LOCAL void duk__slab_page_put(duk_heap *heap, duk_slab_page *page, void *ptr) {
+	duk_slab *slab;
+	duk_small_uint_t cls;
+
+	slab = &heap->slab;
+	cls = page->cls;
+	DUK_ASSERT(page->used > 0);
+	DUK_ASSERT((duk_size_t) ((duk_uint8_t *) ptr - DUK__SLAB_PAGE_DATA(page)) % duk__slab_chunk_size(cls) == 0);
+
+	if (page->used == duk__slab_chunk_count(cls)) {
+		duk__slab_avail_link(slab, page);
+	}
+	*((void **) ptr) = page->free_list;
+	page->free_list = ptr;
+	page->used--;
+
+	if (page->used == 0) {
+		if (slab->empty[cls] > 0) {
+			duk__slab_page_release(heap, page);
+		} else {
+			slab->empty[cls] = 1;
+		}
+	}
+}
+
+/*
+ *  Heap interface
+ */
+
+DUK_INTERNAL void duk_heap_slab_init(duk_heap *heap) {
+	duk_small_uint_t i;
+
+	for (i = 0; i < DUK_HEAP_SLAB_NUM_CLASSES; i++) {
+		heap->slab.avail[i] = NULL;
+		heap->slab.empty[i] = 0;
+	}
+	heap->slab.pages = NULL;
+	heap->slab.pages_size = 0;
+	heap->slab.pages_used = 0;
+}
+
+/* Free all pages at heap destruction, all chunks must be free by now
+ * except for leaks which are freed along with the pages.
+ */
+DUK_INTERNAL void duk_heap_slab_free_all(duk_heap *heap) {
+	duk_uint32_t i;
+	duk_slab_page *page;
+
+	for (i = 0; i < heap->slab.pages_size; i++) {
+		page = heap->slab.pages[i];
+		if (page != NULL) {
+			DUK_DD(DUK_DDPRINT("free slab page %p at heap destruction, %ld chunks in use",
+			                   (void *) page, (long) page->used));
+			heap->free_func(heap->heap_udata, (void *) page);
+		}
+	}
+	heap->free_func(heap->heap_udata, (void *) heap->slab.pages);
+	duk_heap_slab_init(heap);
+}
+
+/* Release all empty pages, used in emergency GC. */
+DUK_INTERNAL void duk_heap_slab_trim(duk_heap *heap) {
+	duk_small_uint_t i;
+	duk_slab_page *page;
+	duk_slab_page *next;
+
+	for (i = 0; i < DUK_HEAP_SLAB_NUM_CLASSES; i++) {
+		for (page = heap->slab.avail[i]; page != NULL; page = next) {
+			next = page->next;
+			if (page->used == 0) {
+				duk__slab_page_release(heap, page);
+			}
+		}
+		heap->slab.empty[i] = 0;
+	}
+}
+
+DUK_INTERNAL DUK_HOT void *duk_heap_slab_alloc(duk_heap *heap, duk_size_t size) {
+	duk_small_uint_t cls;
+	duk_slab_page *page;
+
+	/* Zero size allocations keep the allocation function semantics. */
+	if (DUK_UNLIKELY(size - 1U >= (duk_size_t) DUK_HEAP_SLAB_MAX_SIZE)) {
+		return heap->alloc_func(heap->heap_udata, size);
+	}
+
+	cls = DUK__SLAB_CLASS(size);
+	page = heap->slab.avail[cls];
+	if (DUK_UNLIKELY(page == NULL)) {
+		page = duk__slab_page_new(heap, cls);
+		if (page == NULL) {
+			return NULL;
+		}
+	}
+	return duk__slab_page_take(&heap->slab, page);
+}
+
+DUK_INTERNAL void *duk_heap_slab_realloc(duk_heap *heap, void *ptr, duk_size_t newsize) {
+	duk_slab_page *page;
+	duk_size_t oldsize;
+	void *res;
+
+	page = duk__slab_lookup(&heap->slab, ptr);
+	if (page == NULL) {
+		if (ptr == NULL) {
+			return duk_heap_slab_alloc(heap, newsize);
+		}
+		/* Large allocations stay with the allocation functions. */
+		return heap->realloc_func(heap->heap_udata, ptr, newsize);
+	}
+
+	if (newsize == 0) {
+		duk__slab_page_put(heap, page, ptr);
+		return NULL;
+	}
+	if (newsize <= (duk_size_t) DUK_HEAP_SLAB_MAX_SIZE && DUK__SLAB_CLASS(newsize) == page->cls) {
+		return ptr;
+	}
+
+	/* On failure the original allocation remains valid. */
+	res = duk_heap_slab_alloc(heap, newsize);
+	if (res == NULL) {
+		return NULL;
+	}
+	oldsize = duk__slab_chunk_size(page->cls);
+	duk_memcpy(res, ptr, (oldsize < newsize ? oldsize : newsize));
+	duk__slab_page_put(heap, page, ptr);
+	return res;
+}
+
+DUK_INTERNAL DUK_HOT void duk_heap_slab_free(duk_heap *heap, void *ptr) {
+	duk_slab_page *page;
+
+	page = duk__slab_lookup(&heap->slab, ptr);
+	if (page == NULL) {
+		heap->free_func(heap->heap_udata, ptr);
+		return;
+	}
+	duk__slab_page_put(heap, page, ptr);
+}
+
+#endif  /* DUK_USE_ALLOC_SLAB */
@@ -5,6 +5,13 @@
  *  track of (byte offset, char offset) states for a fixed number of strings.
  *  Otherwise we'd need to scan from either end of the string, as we store
  *  strings in (extended) UTF-8.
+ *
+ *  Long non-ASCII strings additionally get a lazily built sparse index
+ *  (DUK_USE_HSTRING_CHARIDX) which records the byte offset of every
+ *  DUK_HSTRING_CHARIDX_STEP'th codepoint.  A lookup then scans at most
+ *  DUK_HSTRING_CHARIDX_STEP-1 codepoints, regardless of access pattern or
+ *  how many strings are being accessed concurrently.  The index is owned
+ *  by the string and is freed together with it.
  */
 
 #include "duk_internal.h"
@@ -74,6 +81,74 @@ DUK_LOCAL const duk_uint8_t *duk__scan_backwards(const duk_uint8_t *p, const duk
 	return p;
 }
 
+/*
+ *  Sparse char-to-byte offset index
+ *
+ *  Built with a single forward scan on first lookup.  If allocation fails
+ *  or the string data is inconsistent with its character length (which may
+ *  happen for invalid UTF-8), no index is created and the caller falls back
+ *  to the string cache.
+ */
+
+#if defined(DUK_USE_HSTRING_CHARIDX)
+DUK_LOCAL duk_uint32_t *duk__charidx_build(duk_heap *heap, duk_hstring *h, duk_uint_fast32_t char_length) {
+	duk_uint32_t *res;
+	duk_uint_fast32_t n;
+	duk_uint_fast32_t i;
+	duk_uint_fast32_t cidx;
+	const duk_uint8_t *p_start;
+	const duk_uint8_t *p_end;
+	const duk_uint8_t *p;
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(h != NULL);
+	DUK_ASSERT(h->charidx == NULL);
+	DUK_ASSERT(!DUK_HEAPHDR_HAS_READONLY((duk_heaphdr *) h));
+
+	n = (char_length >> DUK_HSTRING_CHARIDX_SHIFT) + 1;
+	res = (duk_uint32_t *) DUK_ALLOC(heap, sizeof(duk_uint32_t) * n);
+	if (DUK_UNLIKELY(res == NULL)) {
+		DUK_D(DUK_DPRINT("failed to allocate charidx for string %p, ignoring", (void *) h));
+		return NULL;
+	}
+
+	p_start = (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h);
+	p_end = p_start + DUK_HSTRING_GET_BYTELEN(h);
+	i = 0;
+	cidx = 0;
+	for (p = p_start; p < p_end; p++) {
+		/* The scanning helpers treat the first byte as a character
+		 * even if it's a continuation byte, and so does the index.
+		 */
+		if ((*p & 0xc0) != 0x80 || p == p_start) {
+			if ((cidx & (DUK_HSTRING_CHARIDX_STEP - 1)) == 0) {
+				if (DUK_UNLIKELY(i >= n)) {
+					goto inconsistent;
+				}
+				res[i++] = (duk_uint32_t) (p - p_start);
+			}
+			cidx++;
+		}
+	}
+	if (i < n) {
+		/* Char offset == char_length is a multiple of the step. */
+		res[i++] = (duk_uint32_t) (p_end - p_start);
+	}
+	if (DUK_UNLIKELY(cidx != char_length || i != n)) {
+		goto inconsistent;
+	}
+
+	DUK_DD(DUK_DDPRINT("built charidx for string %p, clen=%ld, %ld entries",
+	                   (void *) h, (long) char_length, (long) n));
+	return res;
+
+ inconsistent:
+	DUK_D(DUK_DPRINT("string %p data inconsistent with clen=%ld, no charidx", (void *) h, (long) char_length));
+	DUK_FREE(heap, (void *) res);
+	return NULL;
+}
+#endif  /* DUK_USE_HSTRING_CHARIDX */
+
 /*
  *  Convert char offset to byte offset
  *
@@ -121,6 +196,32 @@ DUK_INTERNAL duk_uint_fast32_t duk_heap_strcache_offset_char2byte(duk_hthread *t
 		return char_offset;
 	}
 
+#if defined(DUK_USE_HSTRING_CHARIDX)
+	/*
+	 *  For long non-ASCII strings, use (and build if necessary) the
+	 *  sparse index attached to the string.  Symbols and ROM strings
+	 *  are never indexed.
+	 */
+
+	if (char_length >= DUK_HSTRING_CHARIDX_LIMIT) {
+		if (DUK_UNLIKELY(h->charidx == NULL)) {
+			if (!DUK_HSTRING_HAS_SYMBOL(h) && !DUK_HEAPHDR_HAS_READONLY((duk_heaphdr *) h)) {
+				h->charidx = duk__charidx_build(thr->heap, h, char_length);
+			}
+		}
+		if (DUK_LIKELY(h->charidx != NULL && char_offset < char_length)) {
+			p_start = (const duk_uint8_t *) DUK_HSTRING_GET_DATA(h);
+			p_found = duk__scan_forwards(p_start + h->charidx[char_offset >> DUK_HSTRING_CHARIDX_SHIFT],
+			                             p_start + DUK_HSTRING_GET_BYTELEN(h),
+			                             char_offset & (DUK_HSTRING_CHARIDX_STEP - 1));
+			if (DUK_UNLIKELY(p_found == NULL)) {
+				goto scan_error;
+			}
+			return (duk_uint_fast32_t) (p_found - p_start);
+		}
+	}
+#endif  /* DUK_USE_HSTRING_CHARIDX */
+
 	/*
 	 *  For non-ASCII strings, we need to scan forwards or backwards
 	 *  from some starting point.  The starting point may be the start
@@ -200,6 +200,9 @@ DUK_LOCAL duk_hstring *duk__strtable_alloc_hstring(duk_heap *heap,
 
 	DUK_HSTRING_SET_BYTELEN(res, blen);
 	DUK_HSTRING_SET_HASH(res, strhash);
+#if defined(DUK_USE_HSTRING_CHARIDX)
+	res->charidx = NULL;
+#endif
 
 	DUK_ASSERT(!DUK_HSTRING_HAS_ARRIDX(res));
 #if defined(DUK_USE_HSTRING_ARRIDX)
@@ -215,6 +218,9 @@ DUK_LOCAL duk_hstring *duk__strtable_alloc_hstring(duk_heap *heap,
 		DUK_HSTRING_SET_ARRIDX(res);
 		DUK_HSTRING_SET_ASCII(res);
 		DUK_ASSERT(duk_unicode_unvalidated_utf8_length(data, (duk_size_t) blen) == blen);
+#if defined(DUK_USE_HSTRING_CLEN) && !defined(DUK_USE_HSTRING_LAZY_CLEN)
+		DUK_HSTRING_SET_CHARLEN(res, blen);
+#endif
 	} else {
 		/* Because 'data' is NUL-terminated, we don't need a
 		 * blen > 0 check here.  For NUL (0x00) the symbol
@@ -730,7 +736,11 @@ DUK_INTERNAL duk_hstring *duk_heap_strtable_intern(duk_heap *heap, const duk_uin
 	while (h != NULL) {
 		if (DUK_HSTRING_GET_HASH(h) == strhash &&
 		    DUK_HSTRING_GET_BYTELEN(h) == blen &&
-		    duk_memcmp_unsafe((const void *) str, (const void *) DUK_HSTRING_GET_DATA(h), (size_t) blen) == 0) {
+		    duk_memcmp_unsafe((const void *) str, (const void *) DUK_HSTRING_GET_DATA(h), (size_t) blen) == 0
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+		    && !DUK_HSTRING_HAS_UNINTERNED(h)  /* pseudo hash may match by accident */
+#endif
+		    ) {
 			/* Found existing entry. */
 			DUK_STATS_INC(heap, stats_strtab_intern_hit);
 			return h;
@@ -878,6 +888,273 @@ DUK_INTERNAL duk_hstring *duk_heap_strtable_intern_u32_checked(duk_hthread *thr,
 	return res;
 }
 
+/*
+ *  Uninterned strings.
+ *
+ *  An uninterned string is linked into the string table like any other
+ *  string so that refcount finalization, mark-and-sweep and heap
+ *  destruction handle it without changes.  It is placed using a pseudo
+ *  hash derived from its address instead of a content hash, and intern
+ *  lookups skip it, so it's never returned for a matching str/blen.
+ *
+ *  The allocation is rounded up to a size class to leave room for in-place
+ *  appends.  The size class only depends on the current byte length and
+ *  doesn't change when appending within the slack, so the allocated size
+ *  is always duk__strtable_uninterned_size(blen) and needs no field.
+ */
+
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+DUK_LOCAL duk_size_t duk__strtable_uninterned_size(duk_size_t blen) {
+	duk_size_t n;
+	duk_size_t step;
+
+	/* Round 'blen + 1' (NUL terminator included) up to a multiple of
+	 * the smallest power of two (at least 16) which is at least 1/8 of
+	 * it.  The step is then constant for all lengths between two powers
+	 * of two, and the slack is less than 1/4 of the length.
+	 */
+	n = blen + 1;
+	step = 16;
+	while ((step << 3) < n) {
+		step <<= 1;
+	}
+	return sizeof(duk_hstring) + ((n + step - 1) & ~(step - 1));
+}
+
+/* Initialize the fields of a freshly allocated uninterned string whose
+ * data is already in place, and link it into the string table.
+ */
+DUK_LOCAL void duk__strtable_link_uninterned(duk_heap *heap, duk_hstring *res, duk_uint32_t blen) {
+	duk_uint32_t strhash;
+#if defined(DUK_USE_STRTAB_PTRCOMP)
+	duk_uint16_t *slot;
+#else
+	duk_hstring **slot;
+#endif
+
+	DUK_ASSERT(DUK_HSTRING_HAS_UNINTERNED(res));
+	DUK_ASSERT(DUK_HSTRING_GET_DATA(res)[blen] == 0);
+	DUK_ASSERT(blen == 0 || DUK_HSTRING_GET_DATA(res)[0] < 0x80U ||
+	           (DUK_HSTRING_GET_DATA(res)[0] > 0x82U && DUK_HSTRING_GET_DATA(res)[0] != 0xffU));  /* Not a symbol. */
+	DUK_ASSERT(duk_js_to_arrayindex_string(DUK_HSTRING_GET_DATA(res), blen) == DUK_HSTRING_NO_ARRAY_INDEX);
+
+	/* Any value works as long as it stays the same; the address is
+	 * unique and spreads uninterned strings over the chains.
+	 */
+	strhash = (duk_uint32_t) (((duk_uintptr_t) res) >> 4);
+	DUK_HSTRING_SET_BYTELEN(res, blen);
+	DUK_HSTRING_SET_HASH(res, strhash);
+#if defined(DUK_USE_HSTRING_ARRIDX)
+	res->arridx = DUK_HSTRING_NO_ARRAY_INDEX;
+#endif
+#if defined(DUK_USE_HSTRING_CHARIDX)
+	res->charidx = NULL;
+#endif
+#if !defined(DUK_USE_HSTRING_LAZY_CLEN)
+	duk_hstring_init_charlen(res);  /* Also sets ASCII flag. */
+#endif
+
+#if defined(DUK_USE_STRTAB_PTRCOMP)
+	slot = heap->strtable16 + (strhash & heap->st_mask);
+#else
+	slot = heap->strtable + (strhash & heap->st_mask);
+#endif
+	DUK_ASSERT(res->hdr.h_next == NULL);
+	res->hdr.h_next = DUK__HEAPPTR_DEC16(heap, *slot);
+	*slot = DUK__HEAPPTR_ENC16(heap, res);
+#if defined(DUK__STRTAB_RESIZE_CHECK)
+	heap->st_count++;
+#endif
+}
+
+/* Allocate an uninterned string with the concatenation of str1 and str2 as
+ * its data and link it into the string table.  Like for duk_heap_strtable_intern()
+ * the result is not yet reachable, and the caller must INCREF it before any
+ * side effects.  The caller must ensure the result is not a symbol or an
+ * array index, and that the combined length is within limits.
+ */
+DUK_INTERNAL duk_hstring *duk_heap_strtable_alloc_uninterned(duk_heap *heap, const duk_uint8_t *str1, duk_uint32_t blen1, const duk_uint8_t *str2, duk_uint32_t blen2) {
+	duk_hstring *res;
+	duk_uint8_t *data;
+	duk_uint32_t blen;
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(blen1 == 0 || str1 != NULL);
+	DUK_ASSERT(blen2 == 0 || str2 != NULL);
+	DUK_ASSERT((duk_size_t) blen1 + (duk_size_t) blen2 <= DUK_HSTRING_MAX_BYTELEN);
+
+	blen = blen1 + blen2;
+
+	/* Same side effect protection as in duk__strtable_do_intern(), the
+	 * inputs may be data areas of other strings.
+	 */
+	heap->pf_prevent_count++;
+	DUK_ASSERT(heap->pf_prevent_count != 0);  /* Wrap. */
+
+#if defined(DUK__STRTAB_RESIZE_CHECK)
+	if (DUK_UNLIKELY((heap->st_count & DUK_USE_STRTAB_RESIZE_CHECK_MASK) == 0)) {
+		duk__strtable_resize_check(heap);
+	}
+#endif
+
+	res = (duk_hstring *) DUK_ALLOC(heap, duk__strtable_uninterned_size((duk_size_t) blen));
+
+	DUK_ASSERT(heap->pf_prevent_count > 0);
+	heap->pf_prevent_count--;
+
+	if (DUK_UNLIKELY(res == NULL)) {
+		return NULL;
+	}
+
+	duk_memzero(res, sizeof(duk_hstring));
+#if defined(DUK_USE_EXPLICIT_NULL_INIT)
+	DUK_HEAPHDR_STRING_INIT_NULLS(&res->hdr);
+#endif
+	DUK_HEAPHDR_SET_TYPE_AND_FLAGS(&res->hdr, DUK_HTYPE_STRING, DUK_HSTRING_FLAG_UNINTERNED);
+
+	data = (duk_uint8_t *) (res + 1);
+	duk_memcpy_unsafe((void *) data, (const void *) str1, (size_t) blen1);
+	duk_memcpy_unsafe((void *) (data + blen1), (const void *) str2, (size_t) blen2);
+	data[blen] = (duk_uint8_t) 0;
+
+	duk__strtable_link_uninterned(heap, res, blen);
+
+	DUK_DDD(DUK_DDDPRINT("allocated uninterned string %p, blen=%ld", (void *) res, (long) blen));
+	return res;
+}
+
+#if defined(DUK_USE_HSTRING_EXTDATA)
+/* Allocate an uninterned external string for caller owned data 'str' which
+ * must be NUL terminated, i.e. str[blen] == 0.  The data is not copied and
+ * 'free_func' (if non-NULL) is called when the string is freed.  Same
+ * caller requirements as for duk_heap_strtable_alloc_uninterned().
+ */
+DUK_INTERNAL duk_hstring *duk_heap_strtable_alloc_external(duk_heap *heap, const duk_uint8_t *str, duk_uint32_t blen, duk_external_string_free_function free_func, void *free_udata) {
+	duk_hstring_external *res;
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(str != NULL);
+	DUK_ASSERT(str[blen] == 0);
+	DUK_ASSERT(blen <= DUK_HSTRING_MAX_BYTELEN);
+
+#if defined(DUK__STRTAB_RESIZE_CHECK)
+	if (DUK_UNLIKELY((heap->st_count & DUK_USE_STRTAB_RESIZE_CHECK_MASK) == 0)) {
+		heap->pf_prevent_count++;
+		DUK_ASSERT(heap->pf_prevent_count != 0);  /* Wrap. */
+		duk__strtable_resize_check(heap);
+		DUK_ASSERT(heap->pf_prevent_count > 0);
+		heap->pf_prevent_count--;
+	}
+#endif
+
+	res = (duk_hstring_external *) DUK_ALLOC(heap, sizeof(duk_hstring_external));
+	if (DUK_UNLIKELY(res == NULL)) {
+		return NULL;
+	}
+
+	duk_memzero(res, sizeof(duk_hstring_external));
+#if defined(DUK_USE_EXPLICIT_NULL_INIT)
+	DUK_HEAPHDR_STRING_INIT_NULLS(&res->str.hdr);
+	res->free_func = NULL;
+	res->free_udata = NULL;
+#endif
+	DUK_HEAPHDR_SET_TYPE_AND_FLAGS(&res->str.hdr, DUK_HTYPE_STRING, DUK_HSTRING_FLAG_UNINTERNED | DUK_HSTRING_FLAG_EXTDATA);
+	res->extdata = str;
+	res->free_func = free_func;
+	res->free_udata = free_udata;
+
+	duk__strtable_link_uninterned(heap, (duk_hstring *) res, blen);
+
+	DUK_DDD(DUK_DDDPRINT("allocated external string %p, extdata=%p, blen=%ld", (void *) res, (const void *) str, (long) blen));
+	return (duk_hstring *) res;
+}
+#endif  /* DUK_USE_HSTRING_EXTDATA */
+
+/* Append 'h_add' to the uninterned string 'h' in place.  Returns 0 without
+ * changes if the result doesn't fit into the current allocation; the caller
+ * then creates a new string.  The caller must ensure 'h' is not visible to
+ * anyone else, i.e. it's only referenced by the value being updated.
+ * 'h_add' may be the same string as 'h'.
+ */
+DUK_INTERNAL duk_bool_t duk_heap_strtable_append_uninterned(duk_heap *heap, duk_hstring *h, duk_hstring *h_add) {
+	duk_size_t blen_old;
+	duk_size_t blen_add;
+	duk_size_t blen_new;
+	duk_uint8_t *data;
+#if defined(DUK_USE_HSTRING_CLEN)
+	duk_size_t clen_new;
+#else
+	duk_bool_t ascii;
+#endif
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(h != NULL);
+	DUK_ASSERT(h_add != NULL);
+	DUK_ASSERT(DUK_HSTRING_HAS_UNINTERNED(h));
+	DUK_ASSERT(!DUK_HSTRING_HAS_SYMBOL(h_add));
+
+#if defined(DUK_USE_HSTRING_EXTDATA)
+	/* External data is owned by the caller and must not be written. */
+	if (DUK_HSTRING_HAS_EXTDATA(h)) {
+		return 0;
+	}
+#endif
+
+	blen_old = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h);
+	blen_add = (duk_size_t) DUK_HSTRING_GET_BYTELEN(h_add);
+	blen_new = blen_old + blen_add;
+	if (blen_new > (duk_size_t) DUK_HSTRING_MAX_BYTELEN ||
+	    duk__strtable_uninterned_size(blen_new) != duk__strtable_uninterned_size(blen_old)) {
+		return 0;
+	}
+
+	/* Keep the charlen up-to-date when it's known.  With a lazy charlen
+	 * zero means "not computed yet" and stays that way.  Compute before
+	 * modifying the data because 'h_add' may be 'h'.
+	 */
+#if defined(DUK_USE_HSTRING_CLEN)
+#if defined(DUK_USE_STRLEN16)
+	clen_new = (duk_size_t) h->clen16;
+#else
+	clen_new = (duk_size_t) h->clen;
+#endif
+	if (clen_new != 0) {
+		clen_new += DUK_HSTRING_GET_CHARLEN(h_add);
+	}
+#else
+	ascii = DUK_HSTRING_HAS_ASCII(h) && DUK_HSTRING_GET_CHARLEN(h_add) == blen_add;
+#endif
+
+	/* Cached char/byte offsets and the charidx are for the old data. */
+	duk_heap_strcache_string_remove(heap, h);
+#if defined(DUK_USE_HSTRING_CHARIDX)
+	if (h->charidx != NULL) {
+		DUK_FREE(heap, (void *) h->charidx);
+		h->charidx = NULL;
+	}
+#endif
+
+	data = (duk_uint8_t *) DUK_LOSE_CONST(DUK_HSTRING_GET_DATA(h));
+	duk_memcpy_unsafe((void *) (data + blen_old), (const void *) DUK_HSTRING_GET_DATA(h_add), (size_t) blen_add);
+	data[blen_new] = (duk_uint8_t) 0;
+	DUK_HSTRING_SET_BYTELEN(h, (duk_uint32_t) blen_new);
+
+	DUK_HSTRING_CLEAR_ASCII(h);
+#if defined(DUK_USE_HSTRING_CLEN)
+	DUK_HSTRING_SET_CHARLEN(h, clen_new);
+	if (clen_new == blen_new) {
+		DUK_HSTRING_SET_ASCII(h);
+	}
+#else
+	if (ascii) {
+		DUK_HSTRING_SET_ASCII(h);
+	}
+#endif
+
+	return 1;
+}
+#endif  /* DUK_USE_HSTRING_UNINTERNED */
+
 /*
  *  Remove (unlink) a string from the string table.
  *
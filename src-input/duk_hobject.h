@@ -358,43 +358,52 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 	} while (0)
 #endif
 
+/* Key and flags sizes in the 'props' allocation use the "entry key size"
+ * (DUK_HOBJECT_GET_EKSIZE()) which equals e_size for ordinary objects and is
+ * zero for shaped objects whose keys and flags live in their shape.  The
+ * _PROPS variants of the key/flags base macros are only valid for objects
+ * without a shape.
+ */
 #if defined(DUK_USE_HOBJECT_LAYOUT_1)
 /* LAYOUT 1 */
-#define DUK_HOBJECT_E_GET_KEY_BASE(heap,h) \
+#define DUK_HOBJECT_E_GET_KEY_BASE_PROPS(heap,h) \
 	((duk_hstring **) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) \
 	))
 #define DUK_HOBJECT_E_GET_VALUE_BASE(heap,h) \
 	((duk_propvalue *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
-			DUK_HOBJECT_GET_ESIZE((h)) * sizeof(duk_hstring *) \
+			DUK_HOBJECT_GET_EKSIZE((h)) * sizeof(duk_hstring *) \
 	))
-#define DUK_HOBJECT_E_GET_FLAGS_BASE(heap,h) \
+#define DUK_HOBJECT_E_GET_FLAGS_BASE_PROPS(heap,h) \
 	((duk_uint8_t *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + DUK_HOBJECT_GET_ESIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_propvalue)) \
 	))
 #define DUK_HOBJECT_A_GET_BASE(heap,h) \
 	((duk_tval *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
-			DUK_HOBJECT_GET_ESIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_propvalue) + sizeof(duk_uint8_t)) \
+			DUK_HOBJECT_GET_ESIZE((h)) * sizeof(duk_propvalue) + \
+			DUK_HOBJECT_GET_EKSIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_uint8_t)) \
 	))
 #define DUK_HOBJECT_H_GET_BASE(heap,h) \
 	((duk_uint32_t *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
-			DUK_HOBJECT_GET_ESIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_propvalue) + sizeof(duk_uint8_t)) + \
+			DUK_HOBJECT_GET_ESIZE((h)) * sizeof(duk_propvalue) + \
+			DUK_HOBJECT_GET_EKSIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_uint8_t)) + \
 			DUK_HOBJECT_GET_ASIZE((h)) * sizeof(duk_tval) \
 	))
-#define DUK_HOBJECT_P_COMPUTE_SIZE(n_ent,n_arr,n_hash) \
+#define DUK_HOBJECT_P_COMPUTE_SIZE(n_ent,n_ekey,n_arr,n_hash) \
 	( \
-		(n_ent) * (sizeof(duk_hstring *) + sizeof(duk_propvalue) + sizeof(duk_uint8_t)) + \
+		(n_ent) * sizeof(duk_propvalue) + \
+		(n_ekey) * (sizeof(duk_hstring *) + sizeof(duk_uint8_t)) + \
 		(n_arr) * sizeof(duk_tval) + \
 		(n_hash) * sizeof(duk_uint32_t) \
 	)
-#define DUK_HOBJECT_P_SET_REALLOC_PTRS(p_base,set_e_k,set_e_pv,set_e_f,set_a,set_h,n_ent,n_arr,n_hash)  do { \
+#define DUK_HOBJECT_P_SET_REALLOC_PTRS(p_base,set_e_k,set_e_pv,set_e_f,set_a,set_h,n_ent,n_ekey,n_arr,n_hash)  do { \
 		(set_e_k) = (duk_hstring **) (void *) (p_base); \
-		(set_e_pv) = (duk_propvalue *) (void *) ((set_e_k) + (n_ent)); \
+		(set_e_pv) = (duk_propvalue *) (void *) ((set_e_k) + (n_ekey)); \
 		(set_e_f) = (duk_uint8_t *) (void *) ((set_e_pv) + (n_ent)); \
-		(set_a) = (duk_tval *) (void *) ((set_e_f) + (n_ent)); \
+		(set_a) = (duk_tval *) (void *) ((set_e_f) + (n_ekey)); \
 		(set_h) = (duk_uint32_t *) (void *) ((set_a) + (n_arr)); \
 	} while (0)
 #elif defined(DUK_USE_HOBJECT_LAYOUT_2)
@@ -408,7 +417,7 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 #else
 #error invalid DUK_USE_ALIGN_BY
 #endif
-#define DUK_HOBJECT_E_GET_KEY_BASE(heap,h) \
+#define DUK_HOBJECT_E_GET_KEY_BASE_PROPS(heap,h) \
 	((duk_hstring **) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
 			DUK_HOBJECT_GET_ESIZE((h)) * sizeof(duk_propvalue) \
@@ -417,42 +426,45 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 	((duk_propvalue *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) \
 	))
-#define DUK_HOBJECT_E_GET_FLAGS_BASE(heap,h) \
+#define DUK_HOBJECT_E_GET_FLAGS_BASE_PROPS(heap,h) \
 	((duk_uint8_t *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + DUK_HOBJECT_GET_ESIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_propvalue)) \
 	))
 #define DUK_HOBJECT_A_GET_BASE(heap,h) \
 	((duk_tval *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
-			DUK_HOBJECT_GET_ESIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_propvalue) + sizeof(duk_uint8_t)) + \
-			DUK_HOBJECT_E_FLAG_PADDING(DUK_HOBJECT_GET_ESIZE((h))) \
+			DUK_HOBJECT_GET_ESIZE((h)) * sizeof(duk_propvalue) + \
+			DUK_HOBJECT_GET_EKSIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_uint8_t)) + \
+			DUK_HOBJECT_E_FLAG_PADDING(DUK_HOBJECT_GET_EKSIZE((h))) \
 	))
 #define DUK_HOBJECT_H_GET_BASE(heap,h) \
 	((duk_uint32_t *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
-			DUK_HOBJECT_GET_ESIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_propvalue) + sizeof(duk_uint8_t)) + \
-			DUK_HOBJECT_E_FLAG_PADDING(DUK_HOBJECT_GET_ESIZE((h))) + \
+			DUK_HOBJECT_GET_ESIZE((h)) * sizeof(duk_propvalue) + \
+			DUK_HOBJECT_GET_EKSIZE((h)) * (sizeof(duk_hstring *) + sizeof(duk_uint8_t)) + \
+			DUK_HOBJECT_E_FLAG_PADDING(DUK_HOBJECT_GET_EKSIZE((h))) + \
 			DUK_HOBJECT_GET_ASIZE((h)) * sizeof(duk_tval) \
 	))
-#define DUK_HOBJECT_P_COMPUTE_SIZE(n_ent,n_arr,n_hash) \
+#define DUK_HOBJECT_P_COMPUTE_SIZE(n_ent,n_ekey,n_arr,n_hash) \
 	( \
-		(n_ent) * (sizeof(duk_hstring *) + sizeof(duk_propvalue) + sizeof(duk_uint8_t)) + \
-		DUK_HOBJECT_E_FLAG_PADDING((n_ent)) + \
+		(n_ent) * sizeof(duk_propvalue) + \
+		(n_ekey) * (sizeof(duk_hstring *) + sizeof(duk_uint8_t)) + \
+		DUK_HOBJECT_E_FLAG_PADDING((n_ekey)) + \
 		(n_arr) * sizeof(duk_tval) + \
 		(n_hash) * sizeof(duk_uint32_t) \
 	)
-#define DUK_HOBJECT_P_SET_REALLOC_PTRS(p_base,set_e_k,set_e_pv,set_e_f,set_a,set_h,n_ent,n_arr,n_hash)  do { \
+#define DUK_HOBJECT_P_SET_REALLOC_PTRS(p_base,set_e_k,set_e_pv,set_e_f,set_a,set_h,n_ent,n_ekey,n_arr,n_hash)  do { \
 		(set_e_pv) = (duk_propvalue *) (void *) (p_base); \
 		(set_e_k) = (duk_hstring **) (void *) ((set_e_pv) + (n_ent)); \
-		(set_e_f) = (duk_uint8_t *) (void *) ((set_e_k) + (n_ent)); \
+		(set_e_f) = (duk_uint8_t *) (void *) ((set_e_k) + (n_ekey)); \
 		(set_a) = (duk_tval *) (void *) (((duk_uint8_t *) (set_e_f)) + \
-		                                 sizeof(duk_uint8_t) * (n_ent) + \
-		                                 DUK_HOBJECT_E_FLAG_PADDING((n_ent))); \
+		                                 sizeof(duk_uint8_t) * (n_ekey) + \
+		                                 DUK_HOBJECT_E_FLAG_PADDING((n_ekey))); \
 		(set_h) = (duk_uint32_t *) (void *) ((set_a) + (n_arr)); \
 	} while (0)
 #elif defined(DUK_USE_HOBJECT_LAYOUT_3)
 /* LAYOUT 3 */
-#define DUK_HOBJECT_E_GET_KEY_BASE(heap,h) \
+#define DUK_HOBJECT_E_GET_KEY_BASE_PROPS(heap,h) \
 	((duk_hstring **) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
 			DUK_HOBJECT_GET_ESIZE((h)) * sizeof(duk_propvalue) + \
@@ -462,7 +474,7 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 	((duk_propvalue *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) \
 	))
-#define DUK_HOBJECT_E_GET_FLAGS_BASE(heap,h) \
+#define DUK_HOBJECT_E_GET_FLAGS_BASE_PROPS(heap,h) \
 	((duk_uint8_t *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
 			DUK_HOBJECT_GET_ESIZE((h)) * (sizeof(duk_propvalue) + sizeof(duk_hstring *)) + \
@@ -477,28 +489,43 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 #define DUK_HOBJECT_H_GET_BASE(heap,h) \
 	((duk_uint32_t *) (void *) ( \
 		DUK_HOBJECT_GET_PROPS((heap), (h)) + \
-			DUK_HOBJECT_GET_ESIZE((h)) * (sizeof(duk_propvalue) + sizeof(duk_hstring *)) + \
+			DUK_HOBJECT_GET_ESIZE((h)) * sizeof(duk_propvalue) + \
+			DUK_HOBJECT_GET_EKSIZE((h)) * sizeof(duk_hstring *) + \
 			DUK_HOBJECT_GET_ASIZE((h)) * sizeof(duk_tval) \
 	))
-#define DUK_HOBJECT_P_COMPUTE_SIZE(n_ent,n_arr,n_hash) \
+#define DUK_HOBJECT_P_COMPUTE_SIZE(n_ent,n_ekey,n_arr,n_hash) \
 	( \
-		(n_ent) * (sizeof(duk_propvalue) + sizeof(duk_hstring *) + sizeof(duk_uint8_t)) + \
+		(n_ent) * sizeof(duk_propvalue) + \
+		(n_ekey) * (sizeof(duk_hstring *) + sizeof(duk_uint8_t)) + \
 		(n_arr) * sizeof(duk_tval) + \
 		(n_hash) * sizeof(duk_uint32_t) \
 	)
-#define DUK_HOBJECT_P_SET_REALLOC_PTRS(p_base,set_e_k,set_e_pv,set_e_f,set_a,set_h,n_ent,n_arr,n_hash)  do { \
+#define DUK_HOBJECT_P_SET_REALLOC_PTRS(p_base,set_e_k,set_e_pv,set_e_f,set_a,set_h,n_ent,n_ekey,n_arr,n_hash)  do { \
 		(set_e_pv) = (duk_propvalue *) (void *) (p_base); \
 		(set_a) = (duk_tval *) (void *) ((set_e_pv) + (n_ent)); \
 		(set_e_k) = (duk_hstring **) (void *) ((set_a) + (n_arr)); \
-		(set_h) = (duk_uint32_t *) (void *) ((set_e_k) + (n_ent)); \
+		(set_h) = (duk_uint32_t *) (void *) ((set_e_k) + (n_ekey)); \
 		(set_e_f) = (duk_uint8_t *) (void *) ((set_h) + (n_hash)); \
 	} while (0)
 #else
 #error invalid hobject layout defines
 #endif  /* hobject property layout */
 
+#if defined(DUK_USE_HOBJECT_SHAPES)
+#define DUK_HOBJECT_E_GET_KEY_BASE(heap,h) \
+	(DUK_HOBJECT_GET_SHAPE((h)) != NULL ? \
+		DUK_HSHAPE_GET_KEYS(DUK_HOBJECT_GET_SHAPE((h))) : DUK_HOBJECT_E_GET_KEY_BASE_PROPS((heap), (h)))
+#define DUK_HOBJECT_E_GET_FLAGS_BASE(heap,h) \
+	(DUK_HOBJECT_GET_SHAPE((h)) != NULL ? \
+		DUK_HSHAPE_GET_FLAGS(DUK_HOBJECT_GET_SHAPE((h))) : DUK_HOBJECT_E_GET_FLAGS_BASE_PROPS((heap), (h)))
+#else
+#define DUK_HOBJECT_E_GET_KEY_BASE(heap,h)    DUK_HOBJECT_E_GET_KEY_BASE_PROPS((heap), (h))
+#define DUK_HOBJECT_E_GET_FLAGS_BASE(heap,h)  DUK_HOBJECT_E_GET_FLAGS_BASE_PROPS((heap), (h))
+#endif
+
 #define DUK_HOBJECT_P_ALLOC_SIZE(h) \
-	DUK_HOBJECT_P_COMPUTE_SIZE(DUK_HOBJECT_GET_ESIZE((h)), DUK_HOBJECT_GET_ASIZE((h)), DUK_HOBJECT_GET_HSIZE((h)))
+	DUK_HOBJECT_P_COMPUTE_SIZE(DUK_HOBJECT_GET_ESIZE((h)), DUK_HOBJECT_GET_EKSIZE((h)), \
+	                           DUK_HOBJECT_GET_ASIZE((h)), DUK_HOBJECT_GET_HSIZE((h)))
 
 #define DUK_HOBJECT_E_GET_KEY(heap,h,i)              (DUK_HOBJECT_E_GET_KEY_BASE((heap), (h))[(i)])
 #define DUK_HOBJECT_E_GET_KEY_PTR(heap,h,i)          (&DUK_HOBJECT_E_GET_KEY_BASE((heap), (h))[(i)])
@@ -518,6 +545,7 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 #define DUK_HOBJECT_H_GET_INDEX_PTR(heap,h,i)        (&DUK_HOBJECT_H_GET_BASE((heap), (h))[(i)])
 
 #define DUK_HOBJECT_E_SET_KEY(heap,h,i,k)  do { \
+		DUK_ASSERT(DUK_HOBJECT_GET_SHAPE((h)) == NULL); \
 		DUK_HOBJECT_E_GET_KEY((heap), (h), (i)) = (k); \
 	} while (0)
 #define DUK_HOBJECT_E_SET_VALUE(heap,h,i,v)  do { \
@@ -533,6 +561,7 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 		DUK_HOBJECT_E_GET_VALUE((heap), (h), (i)).a.set = (v); \
 	} while (0)
 #define DUK_HOBJECT_E_SET_FLAGS(heap,h,i,f)  do { \
+		DUK_ASSERT(DUK_HOBJECT_GET_SHAPE((h)) == NULL); \
 		DUK_HOBJECT_E_GET_FLAGS((heap), (h), (i)) = (duk_uint8_t) (f); \
 	} while (0)
 #define DUK_HOBJECT_A_SET_VALUE(heap,h,i,v)  do { \
@@ -545,10 +574,12 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 	} while (0)
 
 #define DUK_HOBJECT_E_SET_FLAG_BITS(heap,h,i,mask)  do { \
+		DUK_ASSERT(DUK_HOBJECT_GET_SHAPE((h)) == NULL); \
 		DUK_HOBJECT_E_GET_FLAGS_BASE((heap), (h))[(i)] |= (mask); \
 	} while (0)
 
 #define DUK_HOBJECT_E_CLEAR_FLAG_BITS(heap,h,i,mask)  do { \
+		DUK_ASSERT(DUK_HOBJECT_GET_SHAPE((h)) == NULL); \
 		DUK_HOBJECT_E_GET_FLAGS_BASE((heap), (h))[(i)] &= ~(mask); \
 	} while (0)
 
@@ -611,6 +642,31 @@ DUK_INTERNAL_DECL void duk_hobject_assert_valid(duk_hobject *h);
 #endif
 #endif
 
+/*
+ *  Shape (DUK_USE_HOBJECT_SHAPES)
+ *
+ *  A shaped object has no key/flags arrays or hash part in its 'props'
+ *  allocation, so its entry key size (EKSIZE) is zero.  Keys and flags of
+ *  a shaped object must not be written directly: DUK_HOBJECT_UNSHAPE()
+ *  converts the object into an ordinary one first.
+ */
+
+#if defined(DUK_USE_HOBJECT_SHAPES)
+#define DUK_HOBJECT_GET_SHAPE(h) ((h)->shape)
+#define DUK_HOBJECT_SET_SHAPE(h,v) do { (h)->shape = (v); } while (0)
+#define DUK_HOBJECT_GET_EKSIZE(h) \
+	(DUK_HOBJECT_GET_SHAPE((h)) != NULL ? 0 : DUK_HOBJECT_GET_ESIZE((h)))
+#define DUK_HOBJECT_UNSHAPE(thr,h) do { \
+		if (DUK_HOBJECT_GET_SHAPE((h)) != NULL) { \
+			duk_hobject_unshape((thr), (h)); \
+		} \
+	} while (0)
+#else
+#define DUK_HOBJECT_GET_SHAPE(h) NULL
+#define DUK_HOBJECT_GET_EKSIZE(h) DUK_HOBJECT_GET_ESIZE((h))
+#define DUK_HOBJECT_UNSHAPE(thr,h) do {} while (0)
+#endif
+
 /*
  *  Misc
  */
@@ -807,6 +863,11 @@ struct duk_hobject {
 	 *  skimps on flags size (which would be followed by 3 bytes of padding in
 	 *  most architectures if entries were placed in a struct).
 	 *
+	 *  With DUK_USE_HOBJECT_SHAPES, an object may instead refer to a shared
+	 *  shape (duk_hshape.h) holding its keys and flags.  The layouts are then
+	 *  the same but with zero sized key and flags parts and no hash part, so
+	 *  that 'props' contains only entry values and the array part.
+	 *
 	 *  'props' also contains internal properties distinguished with a non-BMP
 	 *  prefix.  Often used properties should be placed early in 'props' whenever
 	 *  possible to make accessing them as fast a possible.
@@ -842,6 +903,14 @@ struct duk_hobject {
 	duk_uint32_t h_size;  /* hash part size or 0 if unused */
 #endif
 #endif
+
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	/* Shared key/flags descriptor, NULL for objects with their own keys
+	 * and flags in 'props'.  Kept last so that ROM object initializers
+	 * (which are never shaped) don't need to be aware of it.
+	 */
+	duk_hshape *shape;
+#endif
 };
 
 /*
@@ -946,6 +1015,9 @@ DUK_INTERNAL_DECL duk_hobject *duk_hobject_get_varmap(duk_hthread *thr, duk_hobj
 
 /* hobject management functions */
 DUK_INTERNAL_DECL void duk_hobject_compact_props(duk_hthread *thr, duk_hobject *obj);
+#if defined(DUK_USE_HOBJECT_SHAPES)
+DUK_INTERNAL_DECL void duk_hobject_unshape(duk_hthread *thr, duk_hobject *obj);
+#endif
 
 /* ES2015 proxy */
 #if defined(DUK_USE_ES6_PROXY)
@@ -25,6 +25,13 @@ DUK_INTERNAL void duk_hobject_assert_valid(duk_hobject *h) {
 	/* Object is an Array <=> object has exotic array behavior */
 	DUK_ASSERT((DUK_HOBJECT_GET_CLASS_NUMBER(h) == DUK_HOBJECT_CLASS_ARRAY && DUK_HOBJECT_HAS_EXOTIC_ARRAY(h)) ||
 	           (DUK_HOBJECT_GET_CLASS_NUMBER(h) != DUK_HOBJECT_CLASS_ARRAY && !DUK_HOBJECT_HAS_EXOTIC_ARRAY(h)));
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	/* Shaped object: keys and flags come from the shape, no hash part. */
+	DUK_ASSERT(DUK_HOBJECT_GET_SHAPE(h) == NULL ||
+	           (DUK_HOBJECT_GET_SHAPE(h)->count == DUK_HOBJECT_GET_ENEXT(h) &&
+	            DUK_HOBJECT_GET_SHAPE(h)->users > 0 &&
+	            DUK_HOBJECT_GET_HSIZE(h) == 0));
+#endif
 }
 
 DUK_INTERNAL void duk_harray_assert_valid(duk_harray *h) {
@@ -100,6 +107,19 @@ DUK_INTERNAL void duk_hproxy_assert_valid(duk_hproxy *h) {
 	DUK_ASSERT(DUK_HOBJECT_HAS_EXOTIC_PROXYOBJ((duk_hobject *) h));
 }
 
+#if defined(DUK_USE_HOBJECT_SHAPES)
+DUK_INTERNAL void duk_hshape_assert_valid(duk_hshape *s) {
+	DUK_ASSERT(s != NULL);
+	DUK_ASSERT(s->refcount >= s->users);
+	DUK_ASSERT(s->count <= DUK_HSHAPE_MAX_KEYS);
+	DUK_ASSERT((s->parent == NULL && s->count == 0 && s->key == NULL) ||
+	           (s->parent != NULL && s->count == s->parent->count + 1 && s->key != NULL));
+	DUK_ASSERT(s->users == 0 || s->count == 0 || s->keys != NULL);
+	DUK_ASSERT(s->keys == NULL || DUK_HSHAPE_GET_KEYS(s)[s->count - 1] == s->key);
+	DUK_ASSERT(s->hash_size == 0 || s->hash_size > s->count);
+}
+#endif
+
 DUK_INTERNAL void duk_hthread_assert_valid(duk_hthread *thr) {
 	DUK_ASSERT(thr != NULL);
 	DUK_ASSERT(DUK_HEAPHDR_GET_TYPE((duk_heaphdr *) thr) == DUK_HTYPE_OBJECT);
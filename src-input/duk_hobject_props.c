@@ -156,7 +156,11 @@ DUK_LOCAL duk_uint32_t duk__to_property_key(duk_hthread *thr, duk_idx_t idx, duk
 	 */
 
 	tv_dst = DUK_GET_TVAL_NEGIDX(thr, idx);  /* intentionally unvalidated */
-	if (DUK_TVAL_IS_STRING(tv_dst)) {
+	if (DUK_TVAL_IS_STRING(tv_dst)
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+	    && !DUK_HSTRING_HAS_UNINTERNED(DUK_TVAL_GET_STRING(tv_dst))  /* interned by the slow path */
+#endif
+	   ) {
 		/* Most important path: strings and plain symbols are used as
 		 * is.  For symbols the array index check below is unnecessary
 		 * (they're never valid array indices) but checking that the
@@ -602,17 +606,27 @@ DUK_LOCAL duk_bool_t duk__proxy_check_prop(duk_hthread *thr, duk_hobject *obj, d
  *  Note: because we need to potentially resize the valstack (as part
  *  of abandoning the array part), any tval pointers to the valstack
  *  will become invalid after this call.
+ *
+ *  A shaped object keeps its shape (and gets no hash part) unless the
+ *  array part is abandoned or 'unshape' is set, in which case the keys and
+ *  flags are copied from the shape and the object becomes an ordinary one.
  */
 
-DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
-                                            duk_hobject *obj,
-                                            duk_uint32_t new_e_size,
-                                            duk_uint32_t new_a_size,
-                                            duk_uint32_t new_h_size,
-                                            duk_bool_t abandon_array) {
+DUK_LOCAL void duk__realloc_props(duk_hthread *thr,
+                                  duk_hobject *obj,
+                                  duk_uint32_t new_e_size,
+                                  duk_uint32_t new_a_size,
+                                  duk_uint32_t new_h_size,
+                                  duk_bool_t abandon_array,
+                                  duk_bool_t unshape) {
 	duk_small_uint_t prev_ms_base_flags;
 	duk_uint32_t new_alloc_size;
 	duk_uint32_t new_e_size_adjusted;
+	duk_uint32_t new_ek_size;
+	duk_bool_t keep_shape;
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	duk_hshape *old_shape;
+#endif
 	duk_uint8_t *new_p;
 	duk_hstring **new_e_k;
 	duk_propvalue *new_e_pv;
@@ -638,6 +652,18 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 
 	DUK_STATS_INC(thr->heap, stats_object_realloc_props);
 
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	old_shape = DUK_HOBJECT_GET_SHAPE(obj);
+	keep_shape = (old_shape != NULL && !abandon_array && !unshape);
+	if (keep_shape) {
+		/* Shaped objects have no hash part of their own. */
+		new_h_size = 0;
+	}
+#else
+	DUK_UNREF(unshape);
+	keep_shape = 0;
+#endif
+
 	/*
 	 *  Pre resize assertions.
 	 */
@@ -670,6 +696,7 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 #else
 #error invalid hobject layout defines
 #endif
+	new_ek_size = (keep_shape ? 0 : new_e_size_adjusted);
 
 	/*
 	 *  Debug logging after adjustment.
@@ -678,10 +705,8 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 	DUK_DDD(DUK_DDDPRINT("attempt to resize hobject %p props (%ld -> %ld bytes), from {p=%p,e_size=%ld,e_next=%ld,a_size=%ld,h_size=%ld} to "
 	                     "{e_size=%ld,a_size=%ld,h_size=%ld}, abandon_array=%ld, unadjusted new_e_size=%ld",
 	                     (void *) obj,
-	                     (long) DUK_HOBJECT_P_COMPUTE_SIZE(DUK_HOBJECT_GET_ESIZE(obj),
-	                                                       DUK_HOBJECT_GET_ASIZE(obj),
-	                                                       DUK_HOBJECT_GET_HSIZE(obj)),
-	                     (long) DUK_HOBJECT_P_COMPUTE_SIZE(new_e_size_adjusted, new_a_size, new_h_size),
+	                     (long) DUK_HOBJECT_P_ALLOC_SIZE(obj),
+	                     (long) DUK_HOBJECT_P_COMPUTE_SIZE(new_e_size_adjusted, new_ek_size, new_a_size, new_h_size),
 	                     (void *) DUK_HOBJECT_GET_PROPS(thr->heap, obj),
 	                     (long) DUK_HOBJECT_GET_ESIZE(obj),
 	                     (long) DUK_HOBJECT_GET_ENEXT(obj),
@@ -738,7 +763,7 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 	thr->heap->pf_prevent_count++;                 /* Avoid finalizers. */
 	DUK_ASSERT(thr->heap->pf_prevent_count != 0);  /* Wrap. */
 
-	new_alloc_size = DUK_HOBJECT_P_COMPUTE_SIZE(new_e_size_adjusted, new_a_size, new_h_size);
+	new_alloc_size = DUK_HOBJECT_P_COMPUTE_SIZE(new_e_size_adjusted, new_ek_size, new_a_size, new_h_size);
 	DUK_DDD(DUK_DDDPRINT("new hobject allocation size is %ld", (long) new_alloc_size));
 	if (new_alloc_size == 0) {
 		DUK_ASSERT(new_e_size_adjusted == 0);
@@ -768,7 +793,7 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 	 * because it is memory layout specific.
 	 */
 	DUK_HOBJECT_P_SET_REALLOC_PTRS(new_p, new_e_k, new_e_pv, new_e_f, new_a, new_h,
-	                               new_e_size_adjusted, new_a_size, new_h_size);
+	                               new_e_size_adjusted, new_ek_size, new_a_size, new_h_size);
 	DUK_UNREF(new_h);  /* happens when hash part dropped */
 	new_e_next = 0;
 
@@ -891,9 +916,11 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 		DUK_ASSERT(new_p != NULL && new_e_k != NULL &&
 		           new_e_pv != NULL && new_e_f != NULL);
 
-		new_e_k[new_e_next] = key;
 		new_e_pv[new_e_next] = DUK_HOBJECT_E_GET_VALUE(thr->heap, obj, i);
-		new_e_f[new_e_next] = DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, i);
+		if (!keep_shape) {
+			new_e_k[new_e_next] = key;
+			new_e_f[new_e_next] = DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, i);
+		}
 		new_e_next++;
 	}
 	/* the entries [new_e_next, new_e_size_adjusted[ are left uninitialized on purpose (ok, not gc reachable) */
@@ -987,9 +1014,7 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 	DUK_DD(DUK_DDPRINT("resized hobject %p props (%ld -> %ld bytes), from {p=%p,e_size=%ld,e_next=%ld,a_size=%ld,h_size=%ld} to "
 	                   "{p=%p,e_size=%ld,e_next=%ld,a_size=%ld,h_size=%ld}, abandon_array=%ld, unadjusted new_e_size=%ld",
 	                   (void *) obj,
-	                   (long) DUK_HOBJECT_P_COMPUTE_SIZE(DUK_HOBJECT_GET_ESIZE(obj),
-	                                                     DUK_HOBJECT_GET_ASIZE(obj),
-	                                                     DUK_HOBJECT_GET_HSIZE(obj)),
+	                   (long) DUK_HOBJECT_P_ALLOC_SIZE(obj),
 	                   (long) new_alloc_size,
 	                   (void *) DUK_HOBJECT_GET_PROPS(thr->heap, obj),
 	                   (long) DUK_HOBJECT_GET_ESIZE(obj),
@@ -1014,6 +1039,15 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 	DUK_HOBJECT_SET_ENEXT(obj, new_e_next);
 	DUK_HOBJECT_SET_ASIZE(obj, new_a_size);
 	DUK_HOBJECT_SET_HSIZE(obj, new_h_size);
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	if (old_shape != NULL && !keep_shape) {
+		/* Keys and flags now live in 'props'; side effect free. */
+		DUK_HOBJECT_SET_SHAPE(obj, NULL);
+		duk_hshape_release(thr->heap, old_shape);
+	}
+	DUK_ASSERT(DUK_HOBJECT_GET_SHAPE(obj) == NULL ||
+	           DUK_HOBJECT_GET_SHAPE(obj)->count == DUK_HOBJECT_GET_ENEXT(obj));
+#endif
 
 	/* Clear array part flag only after switching. */
 	if (abandon_array) {
@@ -1064,6 +1098,41 @@ DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
 	DUK_WO_NORETURN(return;);
 }
 
+DUK_INTERNAL void duk_hobject_realloc_props(duk_hthread *thr,
+                                            duk_hobject *obj,
+                                            duk_uint32_t new_e_size,
+                                            duk_uint32_t new_a_size,
+                                            duk_uint32_t new_h_size,
+                                            duk_bool_t abandon_array) {
+	duk__realloc_props(thr, obj, new_e_size, new_a_size, new_h_size, abandon_array, 0 /*unshape*/);
+}
+
+#if defined(DUK_USE_HOBJECT_SHAPES)
+/* Convert a shaped object into an ordinary object with its own keys and
+ * flags, e.g. before a delete or an attribute change.  Entry indices are
+ * preserved because shaped objects have no deleted entries.
+ */
+DUK_INTERNAL void duk_hobject_unshape(duk_hthread *thr, duk_hobject *obj) {
+	duk_uint32_t e_size;
+	duk_uint32_t h_size;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(DUK_HOBJECT_GET_SHAPE(obj) != NULL);
+
+	DUK_DD(DUK_DDPRINT("unshape object %p, %ld keys", (void *) obj, (long) DUK_HOBJECT_GET_ENEXT(obj)));
+
+	e_size = DUK_HOBJECT_GET_ESIZE(obj);
+#if defined(DUK_USE_HOBJECT_HASH_PART)
+	h_size = duk__get_default_h_size(e_size);
+#else
+	h_size = 0;
+#endif
+	duk__realloc_props(thr, obj, e_size, DUK_HOBJECT_GET_ASIZE(obj), h_size, 0 /*abandon_array*/, 1 /*unshape*/);
+	DUK_ASSERT(DUK_HOBJECT_GET_SHAPE(obj) == NULL);
+}
+#endif  /* DUK_USE_HOBJECT_SHAPES */
+
 /*
  *  Helpers to resize properties allocation on specific needs.
  */
@@ -1331,6 +1400,20 @@ DUK_INTERNAL duk_bool_t duk_hobject_find_entry(duk_heap *heap, duk_hobject *obj,
 		duk_uint_fast32_t i;
 		duk_uint_fast32_t n;
 		duk_hstring **h_keys_base;
+#if defined(DUK_USE_HOBJECT_SHAPES) && defined(DUK_USE_HOBJECT_HASH_PART)
+		duk_hshape *shape;
+
+		shape = DUK_HOBJECT_GET_SHAPE(obj);
+		if (shape != NULL && shape->hash_size > 0) {
+			/* Larger shapes have a shared hash index. */
+			DUK_DDD(DUK_DDDPRINT("duk_hobject_find_entry() using shape hash for lookup"));
+			if (duk_hshape_find_key(shape, key, e_idx)) {
+				*h_idx = -1;
+				return 1;
+			}
+			return 0;
+		}
+#endif
 		DUK_DDD(DUK_DDDPRINT("duk_hobject_find_entry() using linear scan for lookup"));
 
 		h_keys_base = DUK_HOBJECT_E_GET_KEY_BASE(heap, obj);
@@ -1461,17 +1544,24 @@ DUK_INTERNAL duk_tval *duk_hobject_find_array_entry_tval_ptr(duk_heap *heap, duk
  *  Allocate and initialize a new entry, resizing the properties allocation
  *  if necessary.  Returns entry index (e_idx) or throws an error if alloc fails.
  *
- *  Sets the key of the entry (increasing the key's refcount), and updates
- *  the hash part if it exists.  Caller must set value and flags, and update
+ *  Sets the key and flags of the entry (increasing the key's refcount), and
+ *  updates the hash part if it exists.  Caller must set the value and update
  *  the entry value refcount.  A decref for the previous value is not necessary.
+ *
+ *  For a shaped object the new entry is a shape transition; the object is
+ *  converted into an ordinary object if it has too many keys.
  */
 
-DUK_LOCAL duk_int_t duk__hobject_alloc_entry_checked(duk_hthread *thr, duk_hobject *obj, duk_hstring *key) {
+DUK_LOCAL duk_int_t duk__hobject_alloc_entry_checked(duk_hthread *thr, duk_hobject *obj, duk_hstring *key, duk_small_uint_t flags) {
 	duk_uint32_t idx;
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	duk_hshape *shape;
+#endif
 
 	DUK_ASSERT(thr != NULL);
 	DUK_ASSERT(obj != NULL);
 	DUK_ASSERT(key != NULL);
+	DUK_ASSERT(!DUK_HSTRING_HAS_UNINTERNED(key));  /* keys are compared by pointer */
 	DUK_ASSERT(DUK_HOBJECT_GET_ENEXT(obj) <= DUK_HOBJECT_GET_ESIZE(obj));
 
 #if defined(DUK_USE_ASSERTIONS)
@@ -1484,6 +1574,35 @@ DUK_LOCAL duk_int_t duk__hobject_alloc_entry_checked(duk_hthread *thr, duk_hobje
 	}
 #endif
 
+#if defined(DUK_USE_HOBJECT_SHAPES)
+	shape = DUK_HOBJECT_GET_SHAPE(obj);
+	if (shape != NULL) {
+		if (DUK_LIKELY(shape->count < DUK_HSHAPE_MAX_KEYS)) {
+			duk_hshape *next;
+
+			/* Grow first: a realloc keeps the current shape.  The
+			 * transition may throw, leaving the object unchanged.
+			 */
+			if (DUK_HOBJECT_GET_ENEXT(obj) >= DUK_HOBJECT_GET_ESIZE(obj)) {
+				duk__grow_props_for_new_entry_item(thr, obj);
+			}
+			DUK_ASSERT(DUK_HOBJECT_GET_SHAPE(obj) == shape);
+			DUK_ASSERT(DUK_HOBJECT_GET_ENEXT(obj) < DUK_HOBJECT_GET_ESIZE(obj));
+
+			next = duk_hshape_transition(thr, shape, key, flags);
+			DUK_ASSERT(next != NULL);
+			DUK_HOBJECT_SET_SHAPE(obj, next);
+			duk_hshape_release(thr->heap, shape);
+			idx = DUK_HOBJECT_POSTINC_ENEXT(obj);
+			DUK_ASSERT(DUK_HOBJECT_GET_ENEXT(obj) == next->count);
+			DUK_HSTRING_INCREF(thr, key);
+			goto done;
+		}
+		DUK_DD(DUK_DDPRINT("shape key limit reached, unshape object"));
+		duk_hobject_unshape(thr, obj);
+	}
+#endif
+
 	if (DUK_HOBJECT_GET_ENEXT(obj) >= DUK_HOBJECT_GET_ESIZE(obj)) {
 		/* only need to guarantee 1 more slot, but allocation growth is in chunks */
 		DUK_DDD(DUK_DDDPRINT("entry part full, allocate space for one more entry"));
@@ -1494,6 +1613,7 @@ DUK_LOCAL duk_int_t duk__hobject_alloc_entry_checked(duk_hthread *thr, duk_hobje
 
 	/* previous value is assumed to be garbage, so don't touch it */
 	DUK_HOBJECT_E_SET_KEY(thr->heap, obj, idx, key);
+	DUK_HOBJECT_E_SET_FLAGS(thr->heap, obj, idx, flags);
 	DUK_HSTRING_INCREF(thr, key);
 
 #if defined(DUK_USE_HOBJECT_HASH_PART)
@@ -1531,6 +1651,9 @@ DUK_LOCAL duk_int_t duk__hobject_alloc_entry_checked(duk_hthread *thr, duk_hobje
 	 * needed right now.
 	 */
 
+#if defined(DUK_USE_HOBJECT_SHAPES)
+ done:
+#endif
 	DUK_ASSERT_DISABLE(idx >= 0);
 	DUK_ASSERT(idx < DUK_HOBJECT_GET_ESIZE(obj));
 	DUK_ASSERT(idx < DUK_HOBJECT_GET_ENEXT(obj));
@@ -4186,14 +4309,13 @@ DUK_INTERNAL duk_bool_t duk_hobject_putprop(duk_hthread *thr, duk_tval *tv_obj,
 	 * refcount; may need a props allocation resize but doesn't
 	 * 'recheck' the valstack.
 	 */
-	e_idx = duk__hobject_alloc_entry_checked(thr, orig, key);
+	e_idx = duk__hobject_alloc_entry_checked(thr, orig, key, DUK_PROPDESC_FLAGS_WEC);
 	DUK_ASSERT(e_idx >= 0);
 
 	tv = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, orig, e_idx);
 	/* prev value can be garbage, no decref */
 	DUK_TVAL_SET_TVAL(tv, tv_val);
 	DUK_TVAL_INCREF(thr, tv);
-	DUK_HOBJECT_E_SET_FLAGS(thr->heap, orig, e_idx, DUK_PROPDESC_FLAGS_WEC);
 	goto entry_updated;
 
  entry_updated:
@@ -4407,6 +4529,22 @@ DUK_INTERNAL duk_bool_t duk_hobject_delprop_raw(duk_hthread *thr, duk_hobject *o
 	} else {
 		DUK_ASSERT(desc.a_idx < 0);
 
+#if defined(DUK_USE_HOBJECT_SHAPES)
+		if (DUK_HOBJECT_GET_SHAPE(obj) != NULL) {
+			/* Shapes are append-only: convert into an ordinary
+			 * object and look up the (possibly new) hash index.
+			 * The entry index is preserved.
+			 */
+			duk_int_t e_idx_check;
+
+			duk_hobject_unshape(thr, obj);
+			e_idx_check = -1;
+			(void) duk_hobject_find_entry(thr->heap, obj, key, &e_idx_check, &desc.h_idx);
+			DUK_ASSERT(e_idx_check == desc.e_idx);
+			DUK_UNREF(e_idx_check);
+		}
+#endif
+
 		/* remove hash entry (no decref) */
 #if defined(DUK_USE_HOBJECT_HASH_PART)
 		if (desc.h_idx >= 0) {
@@ -4745,7 +4883,10 @@ DUK_INTERNAL void duk_hobject_define_property_internal(duk_hthread *thr, duk_hob
 				goto error_internal;
 			}
 
-			DUK_HOBJECT_E_SET_FLAGS(thr->heap, obj, desc.e_idx, propflags);
+			if (DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, desc.e_idx) != propflags) {
+				DUK_HOBJECT_UNSHAPE(thr, obj);  /* e_idx is preserved */
+				DUK_HOBJECT_E_SET_FLAGS(thr->heap, obj, desc.e_idx, propflags);
+			}
 			tv1 = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, desc.e_idx);
 		} else if (desc.a_idx >= 0) {
 			if (flags & DUK_PROPDESC_FLAG_NO_OVERWRITE) {
@@ -4802,9 +4943,8 @@ DUK_INTERNAL void duk_hobject_define_property_internal(duk_hthread *thr, duk_hob
 
  write_to_entry_part:
 	DUK_DDD(DUK_DDDPRINT("property does not exist, object belongs in entry part -> allocate new entry and write value and attributes"));
-	e_idx = duk__hobject_alloc_entry_checked(thr, obj, key);  /* increases key refcount */
+	e_idx = duk__hobject_alloc_entry_checked(thr, obj, key, propflags);  /* increases key refcount */
 	DUK_ASSERT(e_idx >= 0);
-	DUK_HOBJECT_E_SET_FLAGS(thr->heap, obj, e_idx, propflags);
 	tv1 = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, e_idx);
 	/* new entry: previous value is garbage; set to undefined to share write_value */
 	DUK_TVAL_SET_UNDEFINED(tv1);
@@ -5403,15 +5543,13 @@ duk_bool_t duk_hobject_define_property_helper(duk_hthread *thr,
 			}
 
 			/* write to entry part */
-			e_idx = duk__hobject_alloc_entry_checked(thr, obj, key);
+			e_idx = duk__hobject_alloc_entry_checked(thr, obj, key, new_flags);
 			DUK_ASSERT(e_idx >= 0);
 
 			DUK_HOBJECT_E_SET_VALUE_GETTER(thr->heap, obj, e_idx, get);
 			DUK_HOBJECT_E_SET_VALUE_SETTER(thr->heap, obj, e_idx, set);
 			DUK_HOBJECT_INCREF_ALLOWNULL(thr, get);
 			DUK_HOBJECT_INCREF_ALLOWNULL(thr, set);
-
-			DUK_HOBJECT_E_SET_FLAGS(thr->heap, obj, e_idx, new_flags);
 			goto success_exotics;
 		} else {
 			duk_int_t e_idx;
@@ -5461,13 +5599,11 @@ duk_bool_t duk_hobject_define_property_helper(duk_hthread *thr,
 			}
 
 			/* write to entry part */
-			e_idx = duk__hobject_alloc_entry_checked(thr, obj, key);
+			e_idx = duk__hobject_alloc_entry_checked(thr, obj, key, new_flags);
 			DUK_ASSERT(e_idx >= 0);
 			tv2 = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, e_idx);
 			DUK_TVAL_SET_TVAL(tv2, &tv);
 			DUK_TVAL_INCREF(thr, tv2);
-
-			DUK_HOBJECT_E_SET_FLAGS(thr->heap, obj, e_idx, new_flags);
 			goto success_exotics;
 		}
 		DUK_UNREACHABLE();
@@ -5647,6 +5783,7 @@ duk_bool_t duk_hobject_define_property_helper(duk_hthread *thr,
 
 			DUK_ASSERT(curr.e_idx >= 0);
 			DUK_ASSERT(!DUK_HOBJECT_E_SLOT_IS_ACCESSOR(thr->heap, obj, curr.e_idx));
+			DUK_HOBJECT_UNSHAPE(thr, obj);  /* flags change, e_idx is preserved */
 
 			tv1 = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, curr.e_idx);
 			DUK_TVAL_SET_UNDEFINED_UPDREF_NORZ(thr, tv1);  /* XXX: just decref */
@@ -5684,6 +5821,7 @@ duk_bool_t duk_hobject_define_property_helper(duk_hthread *thr,
 			DUK_DDD(DUK_DDDPRINT("convert property to data property"));
 
 			DUK_ASSERT(DUK_HOBJECT_E_SLOT_IS_ACCESSOR(thr->heap, obj, curr.e_idx));
+			DUK_HOBJECT_UNSHAPE(thr, obj);  /* flags change, e_idx is preserved */
 			tmp = DUK_HOBJECT_E_GET_VALUE_GETTER(thr->heap, obj, curr.e_idx);
 			DUK_UNREF(tmp);
 			DUK_HOBJECT_E_SET_VALUE_GETTER(thr->heap, obj, curr.e_idx, NULL);
@@ -5806,7 +5944,10 @@ duk_bool_t duk_hobject_define_property_helper(duk_hthread *thr,
 
 	DUK_DDD(DUK_DDDPRINT("update existing property attributes"));
 	if (curr.e_idx >= 0) {
-		DUK_HOBJECT_E_SET_FLAGS(thr->heap, obj, curr.e_idx, new_flags);
+		if (DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, curr.e_idx) != new_flags) {
+			DUK_HOBJECT_UNSHAPE(thr, obj);  /* e_idx is preserved */
+			DUK_HOBJECT_E_SET_FLAGS(thr->heap, obj, curr.e_idx, new_flags);
+		}
 	} else {
 		/* For Array .length the only allowed transition is for .length
 		 * to become non-writable.
@@ -6059,7 +6200,8 @@ DUK_INTERNAL duk_bool_t duk_hobject_object_ownprop_helper(duk_hthread *thr, duk_
 	duk_bool_t ret;
 
 	/* coercion order matters */
-	h_v = duk_to_hstring_acceptsymbol(thr, 0);
+	(void) duk_to_hstring_acceptsymbol(thr, 0);
+	h_v = duk_to_interned_hstring(thr, 0);  /* compared by pointer */
 	DUK_ASSERT(h_v != NULL);
 
 	h_obj = duk_push_this_coercible_to_object(thr);
@@ -6112,6 +6254,7 @@ DUK_INTERNAL void duk_hobject_object_seal_freeze_helper(duk_hthread *thr, duk_ho
 
 	duk__abandon_array_part(thr, obj);
 	DUK_ASSERT(DUK_HOBJECT_GET_ASIZE(obj) == 0);
+	DUK_ASSERT(DUK_HOBJECT_GET_SHAPE(obj) == NULL);  /* abandon unshapes */
 
 	for (i = 0; i < DUK_HOBJECT_GET_ENEXT(obj); i++) {
 		duk_uint8_t *fp;
@@ -0,0 +1,297 @@
+/*
+ *  Object shapes (hidden classes), see duk_hshape.h.
+ */
+
+#include "duk_internal.h"
+
+#if defined(DUK_USE_HOBJECT_SHAPES)
+
+/*
+ *  Helpers.
+ */
+
+/* Drop a non-user reference; frees the shape and unlinks it from its parent
+ * when the refcount reaches zero, which may cascade towards the root.  The
+ * root shape is embedded in duk_heap and its refcount never reaches zero.
+ */
+DUK_LOCAL void duk__hshape_unref(duk_heap *heap, duk_hshape *shape) {
+	while (shape != NULL) {
+		duk_hshape *parent;
+		duk_hshape **p;
+
+		DUK_ASSERT(shape->refcount > 0);
+		if (--shape->refcount > 0) {
+			break;
+		}
+		DUK_ASSERT(shape->users == 0);
+		DUK_ASSERT(shape->keys == NULL);
+		DUK_ASSERT(shape->child == NULL);
+
+		parent = shape->parent;
+		DUK_ASSERT(parent != NULL);
+		for (p = &parent->child; *p != shape; p = &(*p)->sibling) {
+			DUK_ASSERT(*p != NULL);
+		}
+		*p = shape->sibling;
+
+		DUK_DDD(DUK_DDDPRINT("free shape %p, count=%ld", (void *) shape, (long) shape->count));
+		DUK_FREE(heap, (void *) shape);
+		shape = parent;
+	}
+}
+
+/* Allocate key/flags/hash arrays for a shape, copying the parent's arrays
+ * (the parent is in use by the object making the transition so its arrays
+ * exist).  Returns 0 on allocation failure.
+ */
+DUK_LOCAL duk_bool_t duk__hshape_alloc_data(duk_heap *heap, duk_hshape *shape) {
+	duk_hshape *parent;
+	duk_hstring **keys;
+	duk_uint8_t *flags;
+	duk_uint_fast32_t n;
+
+	DUK_ASSERT(shape->keys == NULL);
+	DUK_ASSERT(shape->users == 0);
+	DUK_ASSERT(shape->count >= 1);
+
+	parent = shape->parent;
+	DUK_ASSERT(parent != NULL);
+	DUK_ASSERT(parent->count == shape->count - 1);
+	DUK_ASSERT(parent->keys != NULL || parent->count == 0);
+
+	keys = (duk_hstring **) DUK_ALLOC(heap, DUK_HSHAPE_DATA_SIZE(shape->count, shape->hash_size));
+	if (DUK_UNLIKELY(keys == NULL)) {
+		return 0;
+	}
+	shape->keys = keys;
+	flags = DUK_HSHAPE_GET_FLAGS(shape);
+
+	n = parent->count;
+	if (n > 0) {
+		duk_memcpy((void *) keys, (const void *) DUK_HSHAPE_GET_KEYS(parent), sizeof(duk_hstring *) * n);
+		duk_memcpy((void *) flags, (const void *) DUK_HSHAPE_GET_FLAGS(parent), n);
+	}
+	keys[n] = shape->key;
+	flags[n] = shape->flags;
+
+#if defined(DUK_USE_HOBJECT_HASH_PART)
+	if (shape->hash_size > 0) {
+		duk_uint8_t *hash;
+		duk_uint32_t mask;
+		duk_uint_fast32_t i;
+
+		hash = DUK_HSHAPE_GET_HASH(shape);
+		duk_memset((void *) hash, DUK_HSHAPE_HASH_UNUSED, shape->hash_size);
+		mask = (duk_uint32_t) shape->hash_size - 1U;
+		for (i = 0; i < shape->count; i++) {
+			duk_uint32_t j;
+
+			j = DUK_HSTRING_GET_HASH(keys[i]) & mask;
+			while (hash[j] != DUK_HSHAPE_HASH_UNUSED) {
+				j = (j + 1U) & mask;  /* Guaranteed to finish, hash is larger than count. */
+			}
+			hash[j] = (duk_uint8_t) i;
+		}
+	}
+#endif
+
+	return 1;
+}
+
+/*
+ *  Root shape.
+ */
+
+DUK_INTERNAL void duk_hshape_init_root(duk_heap *heap) {
+	duk_hshape *root;
+
+	DUK_ASSERT(heap != NULL);
+
+	root = &heap->shape_root;
+	duk_memzero((void *) root, sizeof(*root));
+#if defined(DUK_USE_EXPLICIT_NULL_INIT)
+	root->parent = NULL;
+	root->child = NULL;
+	root->sibling = NULL;
+	root->key = NULL;
+	root->keys = NULL;
+#endif
+	root->refcount = 1;  /* Owned by the heap, never freed. */
+}
+
+/* Make a freshly created object (no properties yet) use the empty shape.
+ * Only called for ordinary objects created via duk_push_object() and
+ * Object.create(); internal objects (varmaps, enumerators, etc) are never
+ * shaped.
+ */
+DUK_INTERNAL void duk_hshape_attach_root(duk_heap *heap, duk_hobject *obj) {
+	duk_hshape *root;
+
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(DUK_HOBJECT_GET_SHAPE(obj) == NULL);
+	DUK_ASSERT(DUK_HOBJECT_GET_PROPS(heap, obj) == NULL);
+	DUK_ASSERT(DUK_HOBJECT_GET_ENEXT(obj) == 0);
+
+	root = &heap->shape_root;
+	root->refcount++;
+	root->users++;
+	DUK_HOBJECT_SET_SHAPE(obj, root);
+}
+
+/*
+ *  Transition: find or create the child of 'parent' for (key, flags) and
+ *  add a user reference to it on behalf of the caller.
+ *
+ *  Memory allocation here must not cause object compaction (the caller may
+ *  already have grown the object for the new entry) or run finalizers, so
+ *  use the same protections as duk_hobject_realloc_props().
+ */
+
+DUK_INTERNAL duk_hshape *duk_hshape_transition(duk_hthread *thr, duk_hshape *parent, duk_hstring *key, duk_small_uint_t flags) {
+	duk_heap *heap;
+	duk_hshape *child;
+	duk_hshape *prev;
+	duk_small_uint_t prev_ms_base_flags;
+	duk_bool_t ok;
+
+	DUK_ASSERT(thr != NULL);
+	DUK_ASSERT(parent != NULL);
+	DUK_ASSERT(parent->users > 0);
+	DUK_ASSERT(parent->count < DUK_HSHAPE_MAX_KEYS);
+	DUK_ASSERT(key != NULL);
+	DUK_HSHAPE_ASSERT_VALID(parent);
+
+	heap = thr->heap;
+
+	prev = NULL;
+	for (child = parent->child; child != NULL; child = child->sibling) {
+		if (child->key == key && child->flags == flags) {
+			break;
+		}
+		prev = child;
+	}
+
+	if (child != NULL) {
+		/* Move to front so that hot transitions are found quickly. */
+		if (prev != NULL) {
+			prev->sibling = child->sibling;
+			child->sibling = parent->child;
+			parent->child = child;
+		}
+		if (DUK_LIKELY(child->users > 0)) {
+			DUK_ASSERT(child->keys != NULL);
+			child->users++;
+			child->refcount++;
+			return child;
+		}
+	}
+
+	prev_ms_base_flags = heap->ms_base_flags;
+	heap->ms_base_flags |= DUK_MS_FLAG_NO_OBJECT_COMPACTION;
+	heap->pf_prevent_count++;
+	DUK_ASSERT(heap->pf_prevent_count != 0);  /* Wrap. */
+
+	if (child == NULL) {
+		child = (duk_hshape *) DUK_ALLOC(heap, sizeof(duk_hshape));
+		if (DUK_UNLIKELY(child == NULL)) {
+			ok = 0;
+			goto done;
+		}
+		duk_memzero((void *) child, sizeof(*child));
+		child->parent = parent;
+		child->sibling = parent->child;
+#if defined(DUK_USE_EXPLICIT_NULL_INIT)
+		child->child = NULL;
+		child->keys = NULL;
+#endif
+		child->key = key;
+		child->count = (duk_uint16_t) (parent->count + 1U);
+		child->flags = (duk_uint8_t) flags;
+#if defined(DUK_USE_HOBJECT_HASH_PART)
+		if (child->count >= DUK_HSHAPE_HASH_LIMIT) {
+			duk_uint_fast32_t hsize = 2;
+			while (hsize < 2U * child->count) {
+				hsize <<= 1;
+			}
+			DUK_ASSERT(hsize <= 0xffU);
+			child->hash_size = (duk_uint8_t) hsize;
+		}
+#endif
+		parent->child = child;
+		parent->refcount++;
+		DUK_DDD(DUK_DDDPRINT("created shape %p, count=%ld, parent=%p",
+		                     (void *) child, (long) child->count, (void *) parent));
+	}
+
+	/* Pin the child: a GC triggered by the allocation may release users
+	 * of its descendants.
+	 */
+	child->refcount++;
+	ok = duk__hshape_alloc_data(heap, child);
+	if (DUK_LIKELY(ok)) {
+		child->users++;  /* Pin becomes the user reference. */
+	} else {
+		duk__hshape_unref(heap, child);
+	}
+
+ done:
+	DUK_ASSERT(heap->pf_prevent_count > 0);
+	heap->pf_prevent_count--;
+	heap->ms_base_flags = prev_ms_base_flags;
+
+	if (DUK_UNLIKELY(!ok)) {
+		DUK_ERROR_ALLOC_FAILED(thr);
+		DUK_WO_NORETURN(return NULL;);
+	}
+	DUK_HSHAPE_ASSERT_VALID(child);
+	return child;
+}
+
+/* Drop a user reference, freeing the key arrays when the last object using
+ * the shape goes away.  Side effect free; called from object free paths.
+ */
+DUK_INTERNAL void duk_hshape_release(duk_heap *heap, duk_hshape *shape) {
+	DUK_ASSERT(heap != NULL);
+	DUK_ASSERT(shape != NULL);
+	DUK_ASSERT(shape->users > 0);
+
+	if (--shape->users == 0) {
+		DUK_FREE(heap, (void *) shape->keys);  /* NULL for root. */
+		shape->keys = NULL;
+	}
+	duk__hshape_unref(heap, shape);
+}
+
+/* Hash lookup for shapes with a hash index.  Shapes without one are scanned
+ * linearly by duk_hobject_find_entry().
+ */
+DUK_INTERNAL duk_bool_t duk_hshape_find_key(duk_hshape *shape, duk_hstring *key, duk_int_t *e_idx) {
+	duk_uint8_t *hash;
+	duk_hstring **keys;
+	duk_uint32_t mask;
+	duk_uint32_t i;
+
+	DUK_ASSERT(shape != NULL);
+	DUK_ASSERT(shape->hash_size > 0);
+	DUK_ASSERT(shape->keys != NULL);
+
+	keys = DUK_HSHAPE_GET_KEYS(shape);
+	hash = DUK_HSHAPE_GET_HASH(shape);
+	mask = (duk_uint32_t) shape->hash_size - 1U;
+	i = DUK_HSTRING_GET_HASH(key) & mask;
+	for (;;) {
+		duk_uint8_t t = hash[i];
+		if (t == DUK_HSHAPE_HASH_UNUSED) {
+			return 0;
+		}
+		DUK_ASSERT(t < shape->count);
+		if (keys[t] == key) {
+			*e_idx = (duk_int_t) t;
+			return 1;
+		}
+		i = (i + 1U) & mask;
+	}
+}
+
+#endif  /* DUK_USE_HOBJECT_SHAPES */
@@ -0,0 +1,99 @@
+/*
+ *  Object shapes (hidden classes), DUK_USE_HOBJECT_SHAPES.
+ *
+ *  A shape describes the entry part keys and property flags of an object
+ *  whose properties were added in a certain order.  Objects with the same
+ *  property insertion sequence share a single shape and only store their
+ *  values in the 'props' allocation (see duk_hobject.h), so that e.g. 100k
+ *  structurally identical JSON records don't each carry a copy of the keys.
+ *
+ *  Shapes form a transition tree rooted at heap->shape_root (the empty
+ *  shape).  Each shape is a (key, flags) transition from its parent, and
+ *  a shape with N keys is always the N'th node on its path from the root.
+ *  Shape key order matches entry part order, so entry indices (slots) are
+ *  stable for all objects sharing a shape.
+ *
+ *  Shapes are immutable: any operation which cannot be expressed as adding
+ *  a new key at the end (delete, attribute change, array part abandon,
+ *  exceeding DUK_HSHAPE_MAX_KEYS) converts the object into a "dictionary"
+ *  object with its own keys and flags, i.e. the normal duk_hobject layout.
+ *  Dictionary objects never become shaped again.
+ *
+ *  Shapes are not heap objects.  They're reference counted manually: the
+ *  refcount counts child shapes and objects using the shape, and a shape
+ *  is freed when its refcount drops to zero.  The key/flags arrays are only
+ *  allocated while at least one object uses the shape directly ('users'),
+ *  so that intermediate shapes on a long transition chain (typical for
+ *  objects used as dictionaries) don't each keep a copy of their keys.
+ *
+ *  Shapes don't hold references to their keys.  This is safe because an
+ *  object using a shape holds a reference to every key in the shape (as
+ *  dictionary objects do), and a shape is only reachable from the tree
+ *  while some object uses it or one of its descendants.  Transition lookups
+ *  and unlinking only compare key pointers and never dereference them.
+ */
+
+#if !defined(DUK_HSHAPE_H_INCLUDED)
+#define DUK_HSHAPE_H_INCLUDED
+
+#if defined(DUK_USE_HOBJECT_SHAPES)
+
+/* Maximum number of keys in a shaped object; adding more keys converts the
+ * object into a dictionary object.  Must be < 0xff so that shape hash
+ * indices fit into a byte.
+ */
+#define DUK_HSHAPE_MAX_KEYS                 64
+
+/* Shapes with at least this many keys get a (shared) hash index. */
+#if defined(DUK_USE_HOBJECT_HASH_PART)
+#define DUK_HSHAPE_HASH_LIMIT               DUK_USE_HOBJECT_HASH_PROP_LIMIT
+#endif
+#define DUK_HSHAPE_HASH_UNUSED              0xffU
+
+#define DUK_HSHAPE_GET_KEYS(s)              ((s)->keys)
+#define DUK_HSHAPE_GET_FLAGS(s)             ((duk_uint8_t *) (void *) ((s)->keys + (s)->count))
+#define DUK_HSHAPE_GET_HASH(s)              (DUK_HSHAPE_GET_FLAGS((s)) + (s)->count)
+#define DUK_HSHAPE_DATA_SIZE(count,hsize)   ((count) * (sizeof(duk_hstring *) + sizeof(duk_uint8_t)) + (hsize))
+
+#if defined(DUK_USE_ASSERTIONS)
+DUK_INTERNAL_DECL void duk_hshape_assert_valid(duk_hshape *s);
+#define DUK_HSHAPE_ASSERT_VALID(s)  do { duk_hshape_assert_valid((s)); } while (0)
+#else
+#define DUK_HSHAPE_ASSERT_VALID(s)  do {} while (0)
+#endif
+
+struct duk_hshape {
+	/* Transition tree links.  Children of a shape are in a singly linked
+	 * sibling list in most-recently-used order.
+	 */
+	duk_hshape *parent;   /* NULL for root */
+	duk_hshape *child;    /* first child, NULL if none */
+	duk_hshape *sibling;  /* next sibling, NULL if none */
+
+	/* Key (and its flags) added by the transition from 'parent'.  NULL
+	 * for the root shape.
+	 */
+	duk_hstring *key;
+
+	/* Key array, followed by a flags array and an optional hash index
+	 * (DUK_HSHAPE_DATA_SIZE()).  Allocated only when users > 0, NULL
+	 * otherwise and always for the root shape.
+	 */
+	duk_hstring **keys;
+
+	duk_uint32_t refcount;  /* child shapes + objects using the shape */
+	duk_uint32_t users;     /* objects using the shape */
+	duk_uint16_t count;     /* number of keys, i.e. depth in the tree */
+	duk_uint8_t flags;      /* property flags for 'key' */
+	duk_uint8_t hash_size;  /* size of hash index (power of two), 0 if none */
+};
+
+DUK_INTERNAL_DECL void duk_hshape_init_root(duk_heap *heap);
+DUK_INTERNAL_DECL void duk_hshape_attach_root(duk_heap *heap, duk_hobject *obj);
+DUK_INTERNAL_DECL duk_hshape *duk_hshape_transition(duk_hthread *thr, duk_hshape *parent, duk_hstring *key, duk_small_uint_t flags);
+DUK_INTERNAL_DECL void duk_hshape_release(duk_heap *heap, duk_hshape *shape);
+DUK_INTERNAL_DECL duk_bool_t duk_hshape_find_key(duk_hshape *shape, duk_hstring *key, duk_int_t *e_idx);
+
+#endif  /* DUK_USE_HOBJECT_SHAPES */
+
+#endif  /* DUK_HSHAPE_H_INCLUDED */
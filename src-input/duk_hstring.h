@@ -40,6 +40,7 @@
 
 /* With lowmem builds the high 16 bits of duk_heaphdr are used for other
  * purposes, so this leaves 7 duk_heaphdr flags and 9 duk_hstring flags.
+ * The UNINTERNED flag is outside that range and needs a 32-bit hash field.
  */
 #define DUK_HSTRING_FLAG_ASCII                      DUK_HEAPHDR_USER_FLAG(0)  /* string is ASCII, clen == blen */
 #define DUK_HSTRING_FLAG_ARRIDX                     DUK_HEAPHDR_USER_FLAG(1)  /* string is a valid array index */
@@ -50,6 +51,15 @@
 #define DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS          DUK_HEAPHDR_USER_FLAG(6)  /* string is 'eval' or 'arguments' */
 #define DUK_HSTRING_FLAG_EXTDATA                    DUK_HEAPHDR_USER_FLAG(7)  /* string data is external (duk_hstring_external) */
 #define DUK_HSTRING_FLAG_PINNED_LITERAL             DUK_HEAPHDR_USER_FLAG(8)  /* string is a literal, and pinned */
+#define DUK_HSTRING_FLAG_UNINTERNED                 DUK_HEAPHDR_USER_FLAG(9)  /* string is not interned, may be appended to in place */
+
+#if defined(DUK_USE_HSTRING_UNINTERNED) && defined(DUK_USE_STRHASH16)
+#error DUK_USE_HSTRING_UNINTERNED is incompatible with DUK_USE_STRHASH16
+#endif
+#if defined(DUK_USE_HSTRING_UNINTERNED) && \
+    (!defined(DUK_USE_HSTRING_UNINTERNED_MINLEN) || (DUK_USE_HSTRING_UNINTERNED_MINLEN < 64))
+#error DUK_USE_HSTRING_UNINTERNED_MINLEN must be at least 64
+#endif
 
 #define DUK_HSTRING_HAS_ASCII(x)                    DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ASCII)
 #define DUK_HSTRING_HAS_ARRIDX(x)                   DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ARRIDX)
@@ -60,6 +70,11 @@
 #define DUK_HSTRING_HAS_EVAL_OR_ARGUMENTS(x)        DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS)
 #define DUK_HSTRING_HAS_EXTDATA(x)                  DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EXTDATA)
 #define DUK_HSTRING_HAS_PINNED_LITERAL(x)           DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_PINNED_LITERAL)
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+#define DUK_HSTRING_HAS_UNINTERNED(x)               DUK_HEAPHDR_CHECK_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_UNINTERNED)
+#else
+#define DUK_HSTRING_HAS_UNINTERNED(x)               0
+#endif
 
 #define DUK_HSTRING_SET_ASCII(x)                    DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ASCII)
 #define DUK_HSTRING_SET_ARRIDX(x)                   DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ARRIDX)
@@ -70,6 +85,7 @@
 #define DUK_HSTRING_SET_EVAL_OR_ARGUMENTS(x)        DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS)
 #define DUK_HSTRING_SET_EXTDATA(x)                  DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EXTDATA)
 #define DUK_HSTRING_SET_PINNED_LITERAL(x)           DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_PINNED_LITERAL)
+#define DUK_HSTRING_SET_UNINTERNED(x)               DUK_HEAPHDR_SET_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_UNINTERNED)
 
 #define DUK_HSTRING_CLEAR_ASCII(x)                  DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ASCII)
 #define DUK_HSTRING_CLEAR_ARRIDX(x)                 DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_ARRIDX)
@@ -80,6 +96,7 @@
 #define DUK_HSTRING_CLEAR_EVAL_OR_ARGUMENTS(x)      DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EVAL_OR_ARGUMENTS)
 #define DUK_HSTRING_CLEAR_EXTDATA(x)                DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_EXTDATA)
 #define DUK_HSTRING_CLEAR_PINNED_LITERAL(x)         DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_PINNED_LITERAL)
+#define DUK_HSTRING_CLEAR_UNINTERNED(x)             DUK_HEAPHDR_CLEAR_FLAG_BITS(&(x)->hdr, DUK_HSTRING_FLAG_UNINTERNED)
 
 #if 0  /* Slightly smaller code without explicit flag, but explicit flag
         * is very useful when 'clen' is dropped.
@@ -142,6 +159,22 @@
 #define DUK_HSTRING_GET_DATA_END(x) \
 	(DUK_HSTRING_GET_DATA((x)) + (x)->blen)
 
+/* Sparse char-to-byte offset index: one byte offset is stored for every
+ * DUK_HSTRING_CHARIDX_STEP codepoints, and the index is only built for
+ * non-ASCII strings with at least DUK_HSTRING_CHARIDX_LIMIT codepoints.
+ */
+#define DUK_HSTRING_CHARIDX_SHIFT   6
+#define DUK_HSTRING_CHARIDX_STEP    (1UL << DUK_HSTRING_CHARIDX_SHIFT)
+#define DUK_HSTRING_CHARIDX_LIMIT   1024
+
+/* Strings of at least this many bytes are created as uninterned strings.
+ * The limit is well above the length of any built-in string so that an
+ * uninterned string never compares equal to one.
+ */
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+#define DUK_HSTRING_UNINTERNED_MINLEN  DUK_USE_HSTRING_UNINTERNED_MINLEN
+#endif
+
 /* Marker value; in E5 2^32-1 is not a valid array index (2^32-2 is highest
  * valid).
  */
@@ -218,6 +251,14 @@ struct duk_hstring {
 	duk_uint32_t clen;
 #endif
 
+	/* Lazily built sparse char-to-byte offset index for long non-ASCII
+	 * strings, see duk_heap_stringcache.c.  NULL if not built.  Kept as
+	 * the last field so that ROM string initializers can omit it.
+	 */
+#if defined(DUK_USE_HSTRING_CHARIDX)
+	duk_uint32_t *charidx;
+#endif
+
 	/*
 	 *  String data of 'blen+1' bytes follows (+1 for NUL termination
 	 *  convenience for C API).  No alignment needs to be guaranteed
@@ -237,6 +278,12 @@ struct duk_hstring_external {
 	 */
 
 	const duk_uint8_t *extdata;
+
+	/* Release callback for strings created using duk_push_external_lstring(),
+	 * only used for uninterned external strings.
+	 */
+	duk_external_string_free_function free_func;
+	void *free_udata;
 };
 
 /*
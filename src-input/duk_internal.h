@@ -54,6 +54,7 @@
 #include "duk_api_internal.h"
 #include "duk_hstring.h"
 #include "duk_hobject.h"
+#include "duk_hshape.h"
 #include "duk_hcompfunc.h"
 #include "duk_hnatfunc.h"
 #include "duk_hboundfunc.h"
@@ -406,10 +406,11 @@ typedef duk_uint32_t duk_instr_t;
 #define DUK_OP_GETPROPC_CR          209
 #define DUK_OP_GETPROPC_RC          210
 #define DUK_OP_GETPROPC_CC          211
-#define DUK_OP_UNUSED212            212
-#define DUK_OP_UNUSED213            213
-#define DUK_OP_UNUSED214            214
-#define DUK_OP_UNUSED215            215
+#define DUK_OP_ADDT                 212
+#define DUK_OP_ADDT_RR              212
+#define DUK_OP_ADDT_CR              213
+#define DUK_OP_ADDT_RC              214
+#define DUK_OP_ADDT_CC              215
 #define DUK_OP_UNUSED216            216
 #define DUK_OP_UNUSED217            217
 #define DUK_OP_UNUSED218            218
@@ -622,6 +622,7 @@ DUK_LOCAL duk_int_t duk__cleanup_varmap(duk_compiler_ctx *comp_ctx) {
 	DUK_ASSERT(h_varmap != NULL);
 
 	ret = 0;
+	DUK_HOBJECT_UNSHAPE(thr, h_varmap);  /* keys are deleted in place */
 	e_next = DUK_HOBJECT_GET_ENEXT(h_varmap);
 	for (i = 0; i < e_next; i++) {
 		h_key = DUK_HOBJECT_E_GET_KEY(thr->heap, h_varmap, i);
@@ -763,6 +764,9 @@ DUK_LOCAL void duk__convert_to_func_template(duk_compiler_ctx *comp_ctx) {
 	data_size = consts_count * sizeof(duk_tval) +
 	            funcs_count * sizeof(duk_hobject *) +
 	            code_size;
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+	data_size += DUK_HCOMPFUNC_ICACHE_SIZE(code_count);
+#endif
 
 	DUK_DDD(DUK_DDDPRINT("consts_count=%ld, funcs_count=%ld, code_size=%ld -> "
 	                     "data_size=%ld*%ld + %ld*%ld + %ld = %ld",
@@ -817,7 +821,13 @@ DUK_LOCAL void duk__convert_to_func_template(duk_compiler_ctx *comp_ctx) {
 	}
 	/* Note: 'q_instr' is still used below */
 
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+	DUK_HCOMPFUNC_SET_ICACHE(thr->heap, h_res, (duk_uint8_t *) (p_instr + code_count));
+	duk_memset((void *) (p_instr + code_count), (int) DUK_HCOMPFUNC_ICACHE_NONE, DUK_HCOMPFUNC_ICACHE_SIZE(code_count));
+	DUK_ASSERT((duk_uint8_t *) (p_instr + code_count) + DUK_HCOMPFUNC_ICACHE_SIZE(code_count) == DUK_HBUFFER_FIXED_GET_DATA_PTR(thr->heap, h_data) + data_size);
+#else
 	DUK_ASSERT((duk_uint8_t *) (p_instr + code_count) == DUK_HBUFFER_FIXED_GET_DATA_PTR(thr->heap, h_data) + data_size);
+#endif
 
 	duk_pop(thr);  /* 'data' (and everything in it) is reachable through h_res now */
 
@@ -2322,6 +2332,7 @@ DUK_LOCAL void duk__ivalue_toplain_raw(duk_compiler_ctx *comp_ctx, duk_ivalue *x
 				duk_dup(thr, x->x1.valstack_idx);
 				duk_dup(thr, x->x2.valstack_idx);
 				duk_concat(thr, 2);
+				(void) duk_to_interned_hstring(thr, -1);  /* constants are interned like literals */
 				duk_replace(thr, x->x1.valstack_idx);
 				x->t = DUK_IVAL_PLAIN;
 				DUK_ASSERT(x->x1.t == DUK_ISPEC_VALUE);
@@ -4569,6 +4580,15 @@ DUK_LOCAL void duk__expr_led(duk_compiler_ctx *comp_ctx, duk_ivalue *left, duk_i
 						reg_src = reg_temp;
 					}
 
+#if defined(DUK_USE_HSTRING_UNINTERNED) && defined(DUK_USE_REFERENCE_COUNTING)
+					/* For 's += <expr>' the temp load is dead after
+					 * the ADD; ADDT lets the executor release it so
+					 * that a long string can be appended in place.
+					 */
+					if (args_op == DUK_OP_ADD && reg_src == reg_temp && reg_res == reg_varbind) {
+						args_op = DUK_OP_ADDT;
+					}
+#endif
 					duk__emit_a_b_c(comp_ctx,
 					                args_op | DUK__EMIT_FLAG_BC_REGCONST,
 					                reg_res,
@@ -147,6 +147,28 @@ DUK_LOCAL DUK_EXEC_ALWAYS_INLINE_PERF void duk__vm_arith_add(duk_hthread *thr, d
 		return;
 	}
 
+#if defined(DUK_USE_HSTRING_UNINTERNED) && defined(DUK_USE_REFERENCE_COUNTING)
+	/* String append, e.g. 's += x' for a register bound 's'.  If the left
+	 * side is an uninterned string referenced only by the target register,
+	 * nothing else can observe it and the right side can be appended in
+	 * place when it fits.  Otherwise duk_concat_2() creates a new string.
+	 */
+	if (DUK_TVAL_IS_STRING(tv_x) && DUK_TVAL_IS_STRING(tv_y) &&
+	    tv_x == thr->valstack_bottom + idx_z) {
+		duk_hstring *h_x;
+		duk_hstring *h_y;
+
+		h_x = DUK_TVAL_GET_STRING(tv_x);
+		h_y = DUK_TVAL_GET_STRING(tv_y);
+		if (DUK_HSTRING_HAS_UNINTERNED(h_x) &&
+		    DUK_HEAPHDR_GET_REFCOUNT((duk_heaphdr *) h_x) == 1 &&
+		    !DUK_HSTRING_HAS_SYMBOL(h_y) &&
+		    duk_heap_strtable_append_uninterned(thr->heap, h_x, h_y)) {
+			return;
+		}
+	}
+#endif
+
 	/*
 	 *  Slow path: potentially requires function calls for coercion
 	 */
@@ -182,6 +204,33 @@ DUK_LOCAL DUK_EXEC_ALWAYS_INLINE_PERF void duk__vm_arith_add(duk_hthread *thr, d
 	duk_replace(thr, (duk_idx_t) idx_z);  /* side effects */
 }
 
+/* ADDT is ADD where register B holds a snapshot of the old value of A
+ * which is dead after the instruction; the compiler emits it for 'x += y'
+ * when evaluating 'y' may have side effects.  If A still holds the same
+ * string, drop the snapshot reference and add using A so that the in-place
+ * append above can apply.  The result is the same either way.
+ */
+DUK_LOCAL DUK_EXEC_ALWAYS_INLINE_PERF void duk__vm_arith_add_temp(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_y, duk_small_uint_fast_t idx_z) {
+#if defined(DUK_USE_HSTRING_UNINTERNED) && defined(DUK_USE_REFERENCE_COUNTING)
+	duk_tval *tv_z;
+
+	tv_z = thr->valstack_bottom + idx_z;
+	if (tv_x != tv_z && tv_x != tv_y &&
+	    DUK_TVAL_IS_STRING(tv_x) && DUK_TVAL_IS_STRING(tv_z) &&
+	    DUK_TVAL_GET_STRING(tv_x) == DUK_TVAL_GET_STRING(tv_z)) {
+		duk_hstring *h;
+
+		h = DUK_TVAL_GET_STRING(tv_x);
+		DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT((duk_heaphdr *) h) >= 2);
+		DUK_TVAL_SET_UNDEFINED(tv_x);
+		DUK_HSTRING_DECREF_NORZ(thr, h);  /* still referenced by tv_z, no refzero */
+		tv_x = tv_z;
+	}
+#endif
+
+	duk__vm_arith_add(thr, tv_x, tv_y, idx_z);
+}
+
 DUK_LOCAL DUK_EXEC_ALWAYS_INLINE_PERF void duk__vm_arith_binary_op(duk_hthread *thr, duk_tval *tv_x, duk_tval *tv_y, duk_uint_fast_t idx_z, duk_small_uint_fast_t opcode) {
 	/*
 	 *  Arithmetic operations other than '+' have number-only semantics
@@ -971,6 +1020,7 @@ DUK_LOCAL void duk__handle_catch_part2(duk_hthread *thr) {
 	DUK_ASSERT(act == thr->callstack_curr);
 	DUK_ASSERT(act != NULL);
 	DUK_HOBJECT_SET_PROTOTYPE(thr->heap, (duk_hobject *) new_env, act->lex_env);
+	DUK_HEAPHDR_MARK_BARRIER(thr, act->lex_env);  /* reference moved without INCREF */
 	act->lex_env = (duk_hobject *) new_env;
 	DUK_HOBJECT_INCREF(thr, (duk_hobject *) new_env);  /* reachable through activation */
 	/* Net refcount change to act->lex_env is 0: incref for new_env's
@@ -2366,6 +2416,7 @@ DUK_LOCAL DUK_EXEC_NOINLINE_PERF void duk__handle_op_trycatch(duk_hthread *thr,
 		DUK_ASSERT(DUK_HOBJECT_GET_PROTOTYPE(thr->heap, (duk_hobject *) env) == NULL);
 		DUK_ASSERT(act->lex_env != NULL);
 		DUK_HOBJECT_SET_PROTOTYPE(thr->heap, (duk_hobject *) env, act->lex_env);
+		DUK_HEAPHDR_MARK_BARRIER(thr, act->lex_env);  /* reference moved without INCREF */
 		act->lex_env = (duk_hobject *) env;  /* Now reachable. */
 		DUK_HOBJECT_INCREF(thr, (duk_hobject *) env);
 		/* Net refcount change to act->lex_env is 0: incref for env's
@@ -2669,6 +2720,242 @@ DUK_LOCAL DUK_EXEC_NOINLINE_PERF duk_small_uint_t duk__handle_op_nextenum(duk_ht
 	return pc_skip;
 }
 
+/*
+ *  Inline caches for property access with a constant key.
+ *
+ *  Each GETPROP/GETPROPC/PUTPROP instruction has a few one-byte entries
+ *  (see duk_hcompfunc.h) remembering entry part slots where the key was
+ *  found.  An entry is a guess only: the key stored in the slot is always
+ *  compared before the slot is used, so stale entries are harmless and
+ *  property table resizes, deletions, etc need no invalidation.  Anything
+ *  unusual (non-object base, Proxy, accessor, array index key, 'caller')
+ *  is left to the generic property code.
+ */
+
+#if defined(DUK_USE_EXEC_INLINE_CACHE) && !defined(DUK_USE_EXEC_PREFER_SIZE)
+DUK_LOCAL DUK_EXEC_ALWAYS_INLINE_PERF duk_uint8_t *duk__icache_get_entries(duk_hthread *thr, duk_hcompfunc *fun, duk_instr_t *curr_pc) {
+	duk_size_t pc;
+
+	DUK_UNREF(thr);
+
+	/* 'curr_pc' has already been incremented past the instruction. */
+	pc = (duk_size_t) ((curr_pc - 1) - DUK_HCOMPFUNC_GET_CODE_BASE(thr->heap, fun));
+	DUK_ASSERT(pc < (duk_size_t) DUK_HCOMPFUNC_GET_CODE_COUNT(thr->heap, fun));
+	return DUK_HCOMPFUNC_GET_ICACHE(thr->heap, fun) + pc * DUK_HCOMPFUNC_ICACHE_WAYS;
+}
+
+DUK_LOCAL void duk__icache_insert(duk_uint8_t *ic, duk_uint_t entry) {
+	duk_small_uint_t i;
+
+	DUK_ASSERT(entry < DUK_HCOMPFUNC_ICACHE_SKIP_MIN);
+
+	/* Move-to-front, oldest entry is dropped. */
+	for (i = DUK_HCOMPFUNC_ICACHE_WAYS - 1; i > 0; i--) {
+		ic[i] = ic[i - 1];
+	}
+	ic[0] = (duk_uint8_t) entry;
+}
+
+/* Record an uncacheable lookup: the SKIP entry goes into the first unused
+ * way (or replaces the oldest entry) so that cached slots still get a chance
+ * to hit for other receivers.
+ */
+DUK_LOCAL void duk__icache_set_skip(duk_uint8_t *ic) {
+	duk_small_uint_t i;
+
+	for (i = 0; i < DUK_HCOMPFUNC_ICACHE_WAYS - 1; i++) {
+		if (ic[i] == DUK_HCOMPFUNC_ICACHE_NONE) {
+			break;
+		}
+	}
+	ic[i] = (duk_uint8_t) DUK_HCOMPFUNC_ICACHE_SKIP_MAX;
+}
+
+DUK_LOCAL DUK_EXEC_ALWAYS_INLINE_PERF duk_bool_t duk__icache_slot_matches(duk_hthread *thr, duk_hobject *obj, duk_uint_t slot, duk_hstring *key, duk_small_uint_t flags_mask, duk_small_uint_t flags_value) {
+	DUK_UNREF(thr);
+	return (slot < DUK_HOBJECT_GET_ENEXT(obj) &&
+	        DUK_HOBJECT_E_GET_KEY(thr->heap, obj, slot) == key &&
+	        (DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, slot) & flags_mask) == flags_value);
+}
+
+/* Find a cacheable entry part slot for 'key' in 'obj', -1 if none. */
+DUK_LOCAL duk_int_t duk__icache_find_slot(duk_hthread *thr, duk_hobject *obj, duk_hstring *key, duk_small_uint_t flags_mask, duk_small_uint_t flags_value) {
+	duk_int_t e_idx;
+	duk_int_t h_idx;
+
+	if (!duk_hobject_find_entry(thr->heap, obj, key, &e_idx, &h_idx)) {
+		return -1;
+	}
+	DUK_ASSERT(e_idx >= 0);
+	if (e_idx > (duk_int_t) DUK_HCOMPFUNC_ICACHE_MAX_SLOT ||
+	    (DUK_HOBJECT_E_GET_FLAGS(thr->heap, obj, e_idx) & flags_mask) != flags_value) {
+		return -1;
+	}
+	return e_idx;
+}
+
+/* An inherited property can be read from a prototype slot only if the
+ * receiver doesn't shadow it concretely or virtually.  The array part and
+ * virtual properties other than 'length' only involve array index keys.
+ */
+DUK_LOCAL duk_bool_t duk__icache_receiver_lacks_key(duk_hthread *thr, duk_hobject *obj, duk_hstring *key) {
+	duk_int_t e_idx;
+	duk_int_t h_idx;
+
+	if (DUK_HOBJECT_HAS_VIRTUAL_PROPERTIES(obj) && key == DUK_HTHREAD_STRING_LENGTH(thr)) {
+		return 0;
+	}
+	return !duk_hobject_find_entry(thr->heap, obj, key, &e_idx, &h_idx);
+}
+
+DUK_LOCAL DUK_EXEC_NOINLINE_PERF duk_tval *duk__icache_getprop_miss(duk_hthread *thr, duk_uint8_t *ic, duk_hobject *obj, duk_hstring *key) {
+	duk_hobject *proto;
+	duk_int_t e_idx;
+
+	if (DUK_HSTRING_HAS_ARRIDX(key) || key == DUK_HTHREAD_STRING_CALLER(thr)) {
+		goto skip;
+	}
+
+	e_idx = duk__icache_find_slot(thr, obj, key, DUK_PROPDESC_FLAG_ACCESSOR, 0);
+	if (e_idx >= 0) {
+		duk__icache_insert(ic, (duk_uint_t) e_idx);
+		return DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, e_idx);
+	}
+
+	proto = DUK_HOBJECT_GET_PROTOTYPE(thr->heap, obj);
+	if (proto == NULL || !duk__icache_receiver_lacks_key(thr, obj, key)) {
+		goto skip;
+	}
+	e_idx = duk__icache_find_slot(thr, proto, key, DUK_PROPDESC_FLAG_ACCESSOR, 0);
+	if (e_idx >= 0) {
+		duk__icache_insert(ic, (duk_uint_t) e_idx | DUK_HCOMPFUNC_ICACHE_PROTO);
+		return DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, proto, e_idx);
+	}
+
+ skip:
+	duk__icache_set_skip(ic);
+	return NULL;
+}
+
+/* Return a pointer to the data property value for a GETPROP with a constant
+ * key, or NULL if the generic path must be used.  No side effects.
+ */
+DUK_LOCAL DUK_EXEC_ALWAYS_INLINE_PERF duk_tval *duk__icache_getprop(duk_hthread *thr, duk_hcompfunc *fun, duk_instr_t *curr_pc, duk_tval *tv_obj, duk_tval *tv_key) {
+	duk_uint8_t *ic;
+	duk_hobject *obj;
+	duk_hobject *proto;
+	duk_hstring *key;
+	duk_uint_t entry;
+	duk_small_uint_t i;
+
+	if (DUK_UNLIKELY(!DUK_TVAL_IS_OBJECT(tv_obj) || !DUK_TVAL_IS_STRING(tv_key))) {
+		return NULL;
+	}
+	obj = DUK_TVAL_GET_OBJECT(tv_obj);
+	key = DUK_TVAL_GET_STRING(tv_key);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(key != NULL);
+	if (DUK_UNLIKELY(DUK_HOBJECT_IS_PROXY(obj))) {
+		return NULL;
+	}
+
+	ic = duk__icache_get_entries(thr, fun, curr_pc);
+	for (i = 0; i < DUK_HCOMPFUNC_ICACHE_WAYS; i++) {
+		entry = ic[i];
+		if (entry >= DUK_HCOMPFUNC_ICACHE_SKIP_MIN) {
+			if (entry == DUK_HCOMPFUNC_ICACHE_NONE) {
+				break;
+			}
+			if (entry > DUK_HCOMPFUNC_ICACHE_SKIP_MIN) {
+				ic[i] = (duk_uint8_t) (entry - 1U);
+				return NULL;
+			}
+			ic[i] = (duk_uint8_t) DUK_HCOMPFUNC_ICACHE_NONE;
+			break;
+		}
+		if (!(entry & DUK_HCOMPFUNC_ICACHE_PROTO)) {
+			if (duk__icache_slot_matches(thr, obj, entry, key, DUK_PROPDESC_FLAG_ACCESSOR, 0)) {
+				return DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, entry);
+			}
+		} else {
+			entry &= DUK_HCOMPFUNC_ICACHE_SLOT_MASK;
+			proto = DUK_HOBJECT_GET_PROTOTYPE(thr->heap, obj);
+			if (proto != NULL &&
+			    duk__icache_slot_matches(thr, proto, entry, key, DUK_PROPDESC_FLAG_ACCESSOR, 0) &&
+			    duk__icache_receiver_lacks_key(thr, obj, key)) {
+				return DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, proto, entry);
+			}
+		}
+	}
+
+	return duk__icache_getprop_miss(thr, ic, obj, key);
+}
+
+/* Return a pointer to an own writable data property value for a PUTPROP
+ * with a constant key, or NULL if the generic path must be used.  Only own
+ * properties are cached: a write to an inherited property creates a new
+ * own property anyway.
+ */
+DUK_LOCAL DUK_EXEC_ALWAYS_INLINE_PERF duk_tval *duk__icache_putprop(duk_hthread *thr, duk_hcompfunc *fun, duk_instr_t *curr_pc, duk_tval *tv_obj, duk_tval *tv_key) {
+	duk_uint8_t *ic;
+	duk_hobject *obj;
+	duk_hstring *key;
+	duk_uint_t entry;
+	duk_small_uint_t i;
+	duk_int_t e_idx;
+
+	if (DUK_UNLIKELY(!DUK_TVAL_IS_OBJECT(tv_obj) || !DUK_TVAL_IS_STRING(tv_key))) {
+		return NULL;
+	}
+	obj = DUK_TVAL_GET_OBJECT(tv_obj);
+	key = DUK_TVAL_GET_STRING(tv_key);
+	DUK_ASSERT(obj != NULL);
+	DUK_ASSERT(key != NULL);
+	if (DUK_UNLIKELY(DUK_HOBJECT_IS_PROXY(obj) || DUK_HEAPHDR_HAS_READONLY((duk_heaphdr *) obj))) {
+		return NULL;
+	}
+
+	ic = duk__icache_get_entries(thr, fun, curr_pc);
+	for (i = 0; i < DUK_HCOMPFUNC_ICACHE_WAYS; i++) {
+		entry = ic[i];
+		if (entry >= DUK_HCOMPFUNC_ICACHE_SKIP_MIN) {
+			if (entry == DUK_HCOMPFUNC_ICACHE_NONE) {
+				break;
+			}
+			if (entry > DUK_HCOMPFUNC_ICACHE_SKIP_MIN) {
+				ic[i] = (duk_uint8_t) (entry - 1U);
+				return NULL;
+			}
+			ic[i] = (duk_uint8_t) DUK_HCOMPFUNC_ICACHE_NONE;
+			break;
+		}
+		DUK_ASSERT((entry & DUK_HCOMPFUNC_ICACHE_PROTO) == 0);
+		if (duk__icache_slot_matches(thr, obj, entry, key,
+		                             DUK_PROPDESC_FLAG_ACCESSOR | DUK_PROPDESC_FLAG_WRITABLE,
+		                             DUK_PROPDESC_FLAG_WRITABLE)) {
+			return DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, entry);
+		}
+	}
+
+	if (DUK_HSTRING_HAS_ARRIDX(key)) {
+		duk__icache_set_skip(ic);
+		return NULL;
+	}
+	e_idx = duk__icache_find_slot(thr, obj, key,
+	                              DUK_PROPDESC_FLAG_ACCESSOR | DUK_PROPDESC_FLAG_WRITABLE,
+	                              DUK_PROPDESC_FLAG_WRITABLE);
+	if (e_idx < 0) {
+		/* Typically a new property (e.g. constructor initializing
+		 * 'this') which goes through the generic path anyway.
+		 */
+		duk__icache_set_skip(ic);
+		return NULL;
+	}
+	duk__icache_insert(ic, (duk_uint_t) e_idx);
+	return DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, obj, e_idx);
+}
+#endif  /* DUK_USE_EXEC_INLINE_CACHE && !DUK_USE_EXEC_PREFER_SIZE */
+
 /*
  *  Call handling helpers.
  */
@@ -2822,6 +3109,53 @@ DUK_LOCAL duk_bool_t duk__executor_handle_call(duk_hthread *thr, duk_idx_t idx,
 		thr->ptr_curr_pc = NULL; \
 	} while (0)
 
+/* Opcode dispatch.  With DUK_USE_EXEC_COMPUTED_GOTO (GCC/Clang "labels as
+ * values") each opcode handler gets a label and the dispatch loop jumps
+ * through a 256-entry label table instead of a switch.  In addition each
+ * handler ends with its own indirect jump to the next handler when no
+ * interrupt is pending, so that the branch predictor can learn opcode
+ * pairs instead of sharing one poorly predicted jump.  The slow path (and
+ * assertion/debug builds, which check state before every opcode) goes
+ * through the top of the dispatch loop.
+ *
+ * __extension__ avoids -pedantic warnings for the non-standard syntax.
+ */
+#if defined(DUK_USE_EXEC_COMPUTED_GOTO) && !defined(DUK_USE_EXEC_PREFER_SIZE)
+#define DUK__COMPUTED_GOTO
+#endif
+
+#if defined(DUK__COMPUTED_GOTO)
+#define DUK__CASE(x)          case x: duk__lbl_##x:
+#define DUK__LBL(x)           __extension__ &&duk__lbl_##x
+#define DUK__JUMP_OP(op)      __extension__ ({ goto *duk__dispatch_table[(op)]; })
+#if defined(DUK_USE_ASSERTIONS) || defined(DUK_USE_DEBUG)
+#define DUK__DISPATCH_NEXT()  { break; }
+#elif defined(DUK_USE_INTERRUPT_COUNTER)
+#define DUK__DISPATCH_NEXT()  { \
+		if (DUK_LIKELY(thr->interrupt_counter > 0)) { \
+			duk_uint8_t duk__op; \
+			thr->interrupt_counter--; \
+			ins = *curr_pc++; \
+			DUK_STATS_INC(thr->heap, stats_exec_opcodes); \
+			duk__op = (duk_uint8_t) DUK_DEC_OP(ins); \
+			DUK__JUMP_OP(duk__op); \
+		} \
+		break; \
+	}
+#else
+#define DUK__DISPATCH_NEXT()  { \
+		duk_uint8_t duk__op; \
+		ins = *curr_pc++; \
+		DUK_STATS_INC(thr->heap, stats_exec_opcodes); \
+		duk__op = (duk_uint8_t) DUK_DEC_OP(ins); \
+		DUK__JUMP_OP(duk__op); \
+	}
+#endif
+#else  /* DUK__COMPUTED_GOTO */
+#define DUK__CASE(x)          case x:
+#define DUK__DISPATCH_NEXT()  { break; }
+#endif  /* DUK__COMPUTED_GOTO */
+
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
 #define DUK__LOOKUP_INDIRECT(idx) do { \
 		(idx) = (duk_uint_fast_t) duk_get_uint(thr, (duk_idx_t) (idx)); \
@@ -3058,6 +3392,140 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 	duk_size_t valstack_top_base;    /* valstack top, should match before interpreting each op (no leftovers) */
 #endif
 
+#if defined(DUK__COMPUTED_GOTO)
+	/* Handler labels indexed by opcode, see DUK__CASE(). */
+	static const void * const duk__dispatch_table[256] = {
+		DUK__LBL(DUK_OP_LDREG), DUK__LBL(DUK_OP_STREG),
+		DUK__LBL(DUK_OP_JUMP), DUK__LBL(DUK_OP_LDCONST),
+		DUK__LBL(DUK_OP_LDINT), DUK__LBL(DUK_OP_LDINTX),
+		DUK__LBL(DUK_OP_LDTHIS), DUK__LBL(DUK_OP_LDUNDEF),
+		DUK__LBL(DUK_OP_LDNULL), DUK__LBL(DUK_OP_LDTRUE),
+		DUK__LBL(DUK_OP_LDFALSE), DUK__LBL(DUK_OP_GETVAR),
+		DUK__LBL(DUK_OP_BNOT), DUK__LBL(DUK_OP_LNOT),
+		DUK__LBL(DUK_OP_UNM), DUK__LBL(DUK_OP_UNP),
+		DUK__LBL(DUK_OP_EQ_RR), DUK__LBL(DUK_OP_EQ_CR),
+		DUK__LBL(DUK_OP_EQ_RC), DUK__LBL(DUK_OP_EQ_CC),
+		DUK__LBL(DUK_OP_NEQ_RR), DUK__LBL(DUK_OP_NEQ_CR),
+		DUK__LBL(DUK_OP_NEQ_RC), DUK__LBL(DUK_OP_NEQ_CC),
+		DUK__LBL(DUK_OP_SEQ_RR), DUK__LBL(DUK_OP_SEQ_CR),
+		DUK__LBL(DUK_OP_SEQ_RC), DUK__LBL(DUK_OP_SEQ_CC),
+		DUK__LBL(DUK_OP_SNEQ_RR), DUK__LBL(DUK_OP_SNEQ_CR),
+		DUK__LBL(DUK_OP_SNEQ_RC), DUK__LBL(DUK_OP_SNEQ_CC),
+		DUK__LBL(DUK_OP_GT_RR), DUK__LBL(DUK_OP_GT_CR),
+		DUK__LBL(DUK_OP_GT_RC), DUK__LBL(DUK_OP_GT_CC),
+		DUK__LBL(DUK_OP_GE_RR), DUK__LBL(DUK_OP_GE_CR),
+		DUK__LBL(DUK_OP_GE_RC), DUK__LBL(DUK_OP_GE_CC),
+		DUK__LBL(DUK_OP_LT_RR), DUK__LBL(DUK_OP_LT_CR),
+		DUK__LBL(DUK_OP_LT_RC), DUK__LBL(DUK_OP_LT_CC),
+		DUK__LBL(DUK_OP_LE_RR), DUK__LBL(DUK_OP_LE_CR),
+		DUK__LBL(DUK_OP_LE_RC), DUK__LBL(DUK_OP_LE_CC),
+		DUK__LBL(DUK_OP_IFTRUE_R), DUK__LBL(DUK_OP_IFTRUE_C),
+		DUK__LBL(DUK_OP_IFFALSE_R), DUK__LBL(DUK_OP_IFFALSE_C),
+		DUK__LBL(DUK_OP_ADD_RR), DUK__LBL(DUK_OP_ADD_CR),
+		DUK__LBL(DUK_OP_ADD_RC), DUK__LBL(DUK_OP_ADD_CC),
+		DUK__LBL(DUK_OP_SUB_RR), DUK__LBL(DUK_OP_SUB_CR),
+		DUK__LBL(DUK_OP_SUB_RC), DUK__LBL(DUK_OP_SUB_CC),
+		DUK__LBL(DUK_OP_MUL_RR), DUK__LBL(DUK_OP_MUL_CR),
+		DUK__LBL(DUK_OP_MUL_RC), DUK__LBL(DUK_OP_MUL_CC),
+		DUK__LBL(DUK_OP_DIV_RR), DUK__LBL(DUK_OP_DIV_CR),
+		DUK__LBL(DUK_OP_DIV_RC), DUK__LBL(DUK_OP_DIV_CC),
+		DUK__LBL(DUK_OP_MOD_RR), DUK__LBL(DUK_OP_MOD_CR),
+		DUK__LBL(DUK_OP_MOD_RC), DUK__LBL(DUK_OP_MOD_CC),
+		DUK__LBL(DUK_OP_EXP_RR), DUK__LBL(DUK_OP_EXP_CR),
+		DUK__LBL(DUK_OP_EXP_RC), DUK__LBL(DUK_OP_EXP_CC),
+		DUK__LBL(DUK_OP_BAND_RR), DUK__LBL(DUK_OP_BAND_CR),
+		DUK__LBL(DUK_OP_BAND_RC), DUK__LBL(DUK_OP_BAND_CC),
+		DUK__LBL(DUK_OP_BOR_RR), DUK__LBL(DUK_OP_BOR_CR),
+		DUK__LBL(DUK_OP_BOR_RC), DUK__LBL(DUK_OP_BOR_CC),
+		DUK__LBL(DUK_OP_BXOR_RR), DUK__LBL(DUK_OP_BXOR_CR),
+		DUK__LBL(DUK_OP_BXOR_RC), DUK__LBL(DUK_OP_BXOR_CC),
+		DUK__LBL(DUK_OP_BASL_RR), DUK__LBL(DUK_OP_BASL_CR),
+		DUK__LBL(DUK_OP_BASL_RC), DUK__LBL(DUK_OP_BASL_CC),
+		DUK__LBL(DUK_OP_BLSR_RR), DUK__LBL(DUK_OP_BLSR_CR),
+		DUK__LBL(DUK_OP_BLSR_RC), DUK__LBL(DUK_OP_BLSR_CC),
+		DUK__LBL(DUK_OP_BASR_RR), DUK__LBL(DUK_OP_BASR_CR),
+		DUK__LBL(DUK_OP_BASR_RC), DUK__LBL(DUK_OP_BASR_CC),
+		DUK__LBL(DUK_OP_INSTOF_RR), DUK__LBL(DUK_OP_INSTOF_CR),
+		DUK__LBL(DUK_OP_INSTOF_RC), DUK__LBL(DUK_OP_INSTOF_CC),
+		DUK__LBL(DUK_OP_IN_RR), DUK__LBL(DUK_OP_IN_CR),
+		DUK__LBL(DUK_OP_IN_RC), DUK__LBL(DUK_OP_IN_CC),
+		DUK__LBL(DUK_OP_GETPROP_RR), DUK__LBL(DUK_OP_GETPROP_CR),
+		DUK__LBL(DUK_OP_GETPROP_RC), DUK__LBL(DUK_OP_GETPROP_CC),
+		DUK__LBL(DUK_OP_PUTPROP_RR), DUK__LBL(DUK_OP_PUTPROP_CR),
+		DUK__LBL(DUK_OP_PUTPROP_RC), DUK__LBL(DUK_OP_PUTPROP_CC),
+		DUK__LBL(DUK_OP_DELPROP_RR), DUK__LBL(DUK_OP_DELPROP_CR_UNUSED),
+		DUK__LBL(DUK_OP_DELPROP_RC), DUK__LBL(DUK_OP_DELPROP_CC_UNUSED),
+		DUK__LBL(DUK_OP_PREINCR), DUK__LBL(DUK_OP_PREDECR),
+		DUK__LBL(DUK_OP_POSTINCR), DUK__LBL(DUK_OP_POSTDECR),
+		DUK__LBL(DUK_OP_PREINCV), DUK__LBL(DUK_OP_PREDECV),
+		DUK__LBL(DUK_OP_POSTINCV), DUK__LBL(DUK_OP_POSTDECV),
+		DUK__LBL(DUK_OP_PREINCP_RR), DUK__LBL(DUK_OP_PREINCP_CR),
+		DUK__LBL(DUK_OP_PREINCP_RC), DUK__LBL(DUK_OP_PREINCP_CC),
+		DUK__LBL(DUK_OP_PREDECP_RR), DUK__LBL(DUK_OP_PREDECP_CR),
+		DUK__LBL(DUK_OP_PREDECP_RC), DUK__LBL(DUK_OP_PREDECP_CC),
+		DUK__LBL(DUK_OP_POSTINCP_RR), DUK__LBL(DUK_OP_POSTINCP_CR),
+		DUK__LBL(DUK_OP_POSTINCP_RC), DUK__LBL(DUK_OP_POSTINCP_CC),
+		DUK__LBL(DUK_OP_POSTDECP_RR), DUK__LBL(DUK_OP_POSTDECP_CR),
+		DUK__LBL(DUK_OP_POSTDECP_RC), DUK__LBL(DUK_OP_POSTDECP_CC),
+		DUK__LBL(DUK_OP_DECLVAR_RR), DUK__LBL(DUK_OP_DECLVAR_CR),
+		DUK__LBL(DUK_OP_DECLVAR_RC), DUK__LBL(DUK_OP_DECLVAR_CC),
+		DUK__LBL(DUK_OP_REGEXP_RR), DUK__LBL(DUK_OP_REGEXP_CR),
+		DUK__LBL(DUK_OP_REGEXP_RC), DUK__LBL(DUK_OP_REGEXP_CC),
+		DUK__LBL(DUK_OP_CLOSURE), DUK__LBL(DUK_OP_TYPEOF),
+		DUK__LBL(DUK_OP_TYPEOFID), DUK__LBL(DUK_OP_PUTVAR),
+		DUK__LBL(DUK_OP_DELVAR), DUK__LBL(DUK_OP_RETREG),
+		DUK__LBL(DUK_OP_RETUNDEF), DUK__LBL(DUK_OP_RETCONST),
+		DUK__LBL(DUK_OP_RETCONSTN), DUK__LBL(DUK_OP_LABEL),
+		DUK__LBL(DUK_OP_ENDLABEL), DUK__LBL(DUK_OP_BREAK),
+		DUK__LBL(DUK_OP_CONTINUE), DUK__LBL(DUK_OP_TRYCATCH),
+		DUK__LBL(DUK_OP_ENDTRY), DUK__LBL(DUK_OP_ENDCATCH),
+		DUK__LBL(DUK_OP_ENDFIN), DUK__LBL(DUK_OP_THROW),
+		DUK__LBL(DUK_OP_INVLHS), DUK__LBL(DUK_OP_CSREG),
+		DUK__LBL(DUK_OP_CSVAR_RR), DUK__LBL(DUK_OP_CSVAR_CR),
+		DUK__LBL(DUK_OP_CSVAR_RC), DUK__LBL(DUK_OP_CSVAR_CC),
+		DUK__LBL(DUK_OP_CALL0), DUK__LBL(DUK_OP_CALL1),
+		DUK__LBL(DUK_OP_CALL2), DUK__LBL(DUK_OP_CALL3),
+		DUK__LBL(DUK_OP_CALL4), DUK__LBL(DUK_OP_CALL5),
+		DUK__LBL(DUK_OP_CALL6), DUK__LBL(DUK_OP_CALL7),
+		DUK__LBL(DUK_OP_CALL8), DUK__LBL(DUK_OP_CALL9),
+		DUK__LBL(DUK_OP_CALL10), DUK__LBL(DUK_OP_CALL11),
+		DUK__LBL(DUK_OP_CALL12), DUK__LBL(DUK_OP_CALL13),
+		DUK__LBL(DUK_OP_CALL14), DUK__LBL(DUK_OP_CALL15),
+		DUK__LBL(DUK_OP_NEWOBJ), DUK__LBL(DUK_OP_NEWARR),
+		DUK__LBL(DUK_OP_MPUTOBJ), DUK__LBL(DUK_OP_MPUTOBJI),
+		DUK__LBL(DUK_OP_INITSET), DUK__LBL(DUK_OP_INITGET),
+		DUK__LBL(DUK_OP_MPUTARR), DUK__LBL(DUK_OP_MPUTARRI),
+		DUK__LBL(DUK_OP_SETALEN), DUK__LBL(DUK_OP_INITENUM),
+		DUK__LBL(DUK_OP_NEXTENUM), DUK__LBL(DUK_OP_NEWTARGET),
+		DUK__LBL(DUK_OP_DEBUGGER), DUK__LBL(DUK_OP_NOP),
+		DUK__LBL(DUK_OP_INVALID), DUK__LBL(DUK_OP_UNUSED207),
+		DUK__LBL(DUK_OP_GETPROPC_RR), DUK__LBL(DUK_OP_GETPROPC_CR),
+		DUK__LBL(DUK_OP_GETPROPC_RC), DUK__LBL(DUK_OP_GETPROPC_CC),
+		DUK__LBL(DUK_OP_ADDT_RR), DUK__LBL(DUK_OP_ADDT_CR),
+		DUK__LBL(DUK_OP_ADDT_RC), DUK__LBL(DUK_OP_ADDT_CC),
+		DUK__LBL(DUK_OP_UNUSED216), DUK__LBL(DUK_OP_UNUSED217),
+		DUK__LBL(DUK_OP_UNUSED218), DUK__LBL(DUK_OP_UNUSED219),
+		DUK__LBL(DUK_OP_UNUSED220), DUK__LBL(DUK_OP_UNUSED221),
+		DUK__LBL(DUK_OP_UNUSED222), DUK__LBL(DUK_OP_UNUSED223),
+		DUK__LBL(DUK_OP_UNUSED224), DUK__LBL(DUK_OP_UNUSED225),
+		DUK__LBL(DUK_OP_UNUSED226), DUK__LBL(DUK_OP_UNUSED227),
+		DUK__LBL(DUK_OP_UNUSED228), DUK__LBL(DUK_OP_UNUSED229),
+		DUK__LBL(DUK_OP_UNUSED230), DUK__LBL(DUK_OP_UNUSED231),
+		DUK__LBL(DUK_OP_UNUSED232), DUK__LBL(DUK_OP_UNUSED233),
+		DUK__LBL(DUK_OP_UNUSED234), DUK__LBL(DUK_OP_UNUSED235),
+		DUK__LBL(DUK_OP_UNUSED236), DUK__LBL(DUK_OP_UNUSED237),
+		DUK__LBL(DUK_OP_UNUSED238), DUK__LBL(DUK_OP_UNUSED239),
+		DUK__LBL(DUK_OP_UNUSED240), DUK__LBL(DUK_OP_UNUSED241),
+		DUK__LBL(DUK_OP_UNUSED242), DUK__LBL(DUK_OP_UNUSED243),
+		DUK__LBL(DUK_OP_UNUSED244), DUK__LBL(DUK_OP_UNUSED245),
+		DUK__LBL(DUK_OP_UNUSED246), DUK__LBL(DUK_OP_UNUSED247),
+		DUK__LBL(DUK_OP_UNUSED248), DUK__LBL(DUK_OP_UNUSED249),
+		DUK__LBL(DUK_OP_UNUSED250), DUK__LBL(DUK_OP_UNUSED251),
+		DUK__LBL(DUK_OP_UNUSED252), DUK__LBL(DUK_OP_UNUSED253),
+		DUK__LBL(DUK_OP_UNUSED254), DUK__LBL(DUK_OP_UNUSED255)
+	};
+#endif
+
 	/* Optimized reg/const access macros assume sizeof(duk_tval) to be
 	 * either 8 or 16.  Heap allocation checks this even without asserts
 	 * enabled now because it can't be autodetected in duk_config.h.
@@ -3287,6 +3755,9 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * will (at least usually) omit a bounds check.
 		 */
 		op = (duk_uint8_t) DUK_DEC_OP(ins);
+#if defined(DUK__COMPUTED_GOTO)
+		DUK__JUMP_OP(op);
+#endif
 		switch (op) {
 
 		/* Some useful macros.  These access inner executor variables
@@ -3303,8 +3774,8 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK__REPLACE_TOP_A_BREAK(); \
 	}
 #else
-#define DUK__REPLACE_TOP_A_BREAK() { DUK__REPLACE_TO_TVPTR(thr, DUK__REGP_A(ins)); break; }
-#define DUK__REPLACE_TOP_BC_BREAK() { DUK__REPLACE_TO_TVPTR(thr, DUK__REGP_BC(ins)); break; }
+#define DUK__REPLACE_TOP_A_BREAK() { DUK__REPLACE_TO_TVPTR(thr, DUK__REGP_A(ins)); DUK__DISPATCH_NEXT(); }
+#define DUK__REPLACE_TOP_BC_BREAK() { DUK__REPLACE_TO_TVPTR(thr, DUK__REGP_BC(ins)); DUK__DISPATCH_NEXT(); }
 #define DUK__REPLACE_BOOL_A_BREAK(bval) { \
 		duk_bool_t duk__bval; \
 		duk_tval *duk__tvdst; \
@@ -3312,7 +3783,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK_ASSERT(duk__bval == 0 || duk__bval == 1); \
 		duk__tvdst = DUK__REGP_A(ins); \
 		DUK_TVAL_SET_BOOLEAN_UPDREF(thr, duk__tvdst, duk__bval); \
-		break; \
+		DUK__DISPATCH_NEXT(); \
 	}
 #endif
 
@@ -3324,31 +3795,31 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * duk_dup() + duk_replace(), but because they're used quite a lot
 		 * they're currently intentionally not size optimized.
 		 */
-		case DUK_OP_LDREG: {
+		DUK__CASE(DUK_OP_LDREG) {
 			duk_tval *tv1, *tv2;
 
 			tv1 = DUK__REGP_A(ins);
 			tv2 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, tv1, tv2);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_STREG: {
+		DUK__CASE(DUK_OP_STREG) {
 			duk_tval *tv1, *tv2;
 
 			tv1 = DUK__REGP_A(ins);
 			tv2 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, tv2, tv1);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_LDCONST: {
+		DUK__CASE(DUK_OP_LDCONST) {
 			duk_tval *tv1, *tv2;
 
 			tv1 = DUK__REGP_A(ins);
 			tv2 = DUK__CONSTP_BC(ins);
 			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, tv1, tv2);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 		/* LDINT and LDINTX are intended to load an arbitrary signed
@@ -3356,14 +3827,14 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * This also guarantees all values remain fastints.
 		 */
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_LDINT: {
+		DUK__CASE(DUK_OP_LDINT) {
 			duk_int32_t val;
 
 			val = (duk_int32_t) DUK_DEC_BC(ins) - (duk_int32_t) DUK_BC_LDINT_BIAS;
 			duk_push_int(thr, val);
 			DUK__REPLACE_TOP_A_BREAK();
 		}
-		case DUK_OP_LDINTX: {
+		DUK__CASE(DUK_OP_LDINTX) {
 			duk_int32_t val;
 
 			val = (duk_int32_t) duk_get_int(thr, DUK_DEC_A(ins));
@@ -3372,16 +3843,16 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_A_BREAK();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_LDINT: {
+		DUK__CASE(DUK_OP_LDINT) {
 			duk_tval *tv1;
 			duk_int32_t val;
 
 			val = (duk_int32_t) DUK_DEC_BC(ins) - (duk_int32_t) DUK_BC_LDINT_BIAS;
 			tv1 = DUK__REGP_A(ins);
 			DUK_TVAL_SET_I32_UPDREF(thr, tv1, val);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDINTX: {
+		DUK__CASE(DUK_OP_LDINTX) {
 			duk_tval *tv1;
 			duk_int32_t val;
 
@@ -3396,33 +3867,33 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #endif
 			val = (duk_int32_t) ((duk_uint32_t) val << DUK_BC_LDINTX_SHIFT) + (duk_int32_t) DUK_DEC_BC(ins);  /* no bias */
 			DUK_TVAL_SET_I32_UPDREF(thr, tv1, val);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_LDTHIS: {
+		DUK__CASE(DUK_OP_LDTHIS) {
 			duk_push_this(thr);
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
-		case DUK_OP_LDUNDEF: {
+		DUK__CASE(DUK_OP_LDUNDEF) {
 			duk_to_undefined(thr, (duk_idx_t) DUK_DEC_BC(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDNULL: {
+		DUK__CASE(DUK_OP_LDNULL) {
 			duk_to_null(thr, (duk_idx_t) DUK_DEC_BC(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDTRUE: {
+		DUK__CASE(DUK_OP_LDTRUE) {
 			duk_push_true(thr);
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
-		case DUK_OP_LDFALSE: {
+		DUK__CASE(DUK_OP_LDFALSE) {
 			duk_push_false(thr);
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_LDTHIS: {
+		DUK__CASE(DUK_OP_LDTHIS) {
 			/* Note: 'this' may be bound to any value, not just an object */
 			duk_tval *tv1, *tv2;
 
@@ -3430,67 +3901,67 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			tv2 = thr->valstack_bottom - 1;  /* 'this binding' is just under bottom */
 			DUK_ASSERT(tv2 >= thr->valstack);
 			DUK_TVAL_SET_TVAL_UPDREF_FAST(thr, tv1, tv2);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDUNDEF: {
+		DUK__CASE(DUK_OP_LDUNDEF) {
 			duk_tval *tv1;
 
 			tv1 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_UNDEFINED_UPDREF(thr, tv1);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDNULL: {
+		DUK__CASE(DUK_OP_LDNULL) {
 			duk_tval *tv1;
 
 			tv1 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_NULL_UPDREF(thr, tv1);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDTRUE: {
+		DUK__CASE(DUK_OP_LDTRUE) {
 			duk_tval *tv1;
 
 			tv1 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv1, 1);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_LDFALSE: {
+		DUK__CASE(DUK_OP_LDFALSE) {
 			duk_tval *tv1;
 
 			tv1 = DUK__REGP_BC(ins);
 			DUK_TVAL_SET_BOOLEAN_UPDREF(thr, tv1, 0);  /* side effects */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
-		case DUK_OP_BNOT: {
+		DUK__CASE(DUK_OP_BNOT) {
 			duk__vm_bitwise_not(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_LNOT: {
+		DUK__CASE(DUK_OP_LNOT) {
 			duk__vm_logical_not(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_UNM:
-		case DUK_OP_UNP: {
+		DUK__CASE(DUK_OP_UNM)
+		DUK__CASE(DUK_OP_UNP) {
 			duk__vm_arith_unary_op(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins), op);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_UNM: {
+		DUK__CASE(DUK_OP_UNM) {
 			duk__vm_arith_unary_op(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins), DUK_OP_UNM);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_UNP: {
+		DUK__CASE(DUK_OP_UNP) {
 			duk__vm_arith_unary_op(thr, DUK_DEC_BC(ins), DUK_DEC_A(ins), DUK_OP_UNP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_TYPEOF: {
+		DUK__CASE(DUK_OP_TYPEOF) {
 			duk_small_uint_t stridx;
 
 			stridx = duk_js_typeof_stridx(DUK__REGP_BC(ins));
@@ -3499,7 +3970,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_A_BREAK();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_TYPEOF: {
+		DUK__CASE(DUK_OP_TYPEOF) {
 			duk_tval *tv;
 			duk_small_uint_t stridx;
 			duk_hstring *h_str;
@@ -3510,11 +3981,11 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			h_str = DUK_HTHREAD_GET_STRING(thr, stridx);
 			tv = DUK__REGP_A(ins);
 			DUK_TVAL_SET_STRING_UPDREF(thr, tv, h_str);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
-		case DUK_OP_TYPEOFID: {
+		DUK__CASE(DUK_OP_TYPEOFID) {
 			duk_small_uint_t stridx;
 #if !defined(DUK_USE_EXEC_PREFER_SIZE)
 			duk_hstring *h_str;
@@ -3550,7 +4021,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			h_str = DUK_HTHREAD_GET_STRING(thr, stridx);
 			tv = DUK__REGP_A(ins);
 			DUK_TVAL_SET_STRING_UPDREF(thr, tv, h_str);
-			break;
+			DUK__DISPATCH_NEXT();
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 		}
 
@@ -3583,58 +4054,58 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK__REPLACE_BOOL_A_BREAK(tmp); \
 	}
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_EQ_RR:
-		case DUK_OP_EQ_CR:
-		case DUK_OP_EQ_RC:
-		case DUK_OP_EQ_CC:
+		DUK__CASE(DUK_OP_EQ_RR)
+		DUK__CASE(DUK_OP_EQ_CR)
+		DUK__CASE(DUK_OP_EQ_RC)
+		DUK__CASE(DUK_OP_EQ_CC)
 			DUK__EQ_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_NEQ_RR:
-		case DUK_OP_NEQ_CR:
-		case DUK_OP_NEQ_RC:
-		case DUK_OP_NEQ_CC:
+		DUK__CASE(DUK_OP_NEQ_RR)
+		DUK__CASE(DUK_OP_NEQ_CR)
+		DUK__CASE(DUK_OP_NEQ_RC)
+		DUK__CASE(DUK_OP_NEQ_CC)
 			DUK__NEQ_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_SEQ_RR:
-		case DUK_OP_SEQ_CR:
-		case DUK_OP_SEQ_RC:
-		case DUK_OP_SEQ_CC:
+		DUK__CASE(DUK_OP_SEQ_RR)
+		DUK__CASE(DUK_OP_SEQ_CR)
+		DUK__CASE(DUK_OP_SEQ_RC)
+		DUK__CASE(DUK_OP_SEQ_CC)
 			DUK__SEQ_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_SNEQ_RR:
-		case DUK_OP_SNEQ_CR:
-		case DUK_OP_SNEQ_RC:
-		case DUK_OP_SNEQ_CC:
+		DUK__CASE(DUK_OP_SNEQ_RR)
+		DUK__CASE(DUK_OP_SNEQ_CR)
+		DUK__CASE(DUK_OP_SNEQ_RC)
+		DUK__CASE(DUK_OP_SNEQ_CC)
 			DUK__SNEQ_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_EQ_RR:
+		DUK__CASE(DUK_OP_EQ_RR)
 			DUK__EQ_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_EQ_CR:
+		DUK__CASE(DUK_OP_EQ_CR)
 			DUK__EQ_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_EQ_RC:
+		DUK__CASE(DUK_OP_EQ_RC)
 			DUK__EQ_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_EQ_CC:
+		DUK__CASE(DUK_OP_EQ_CC)
 			DUK__EQ_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_NEQ_RR:
+		DUK__CASE(DUK_OP_NEQ_RR)
 			DUK__NEQ_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_NEQ_CR:
+		DUK__CASE(DUK_OP_NEQ_CR)
 			DUK__NEQ_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_NEQ_RC:
+		DUK__CASE(DUK_OP_NEQ_RC)
 			DUK__NEQ_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_NEQ_CC:
+		DUK__CASE(DUK_OP_NEQ_CC)
 			DUK__NEQ_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_SEQ_RR:
+		DUK__CASE(DUK_OP_SEQ_RR)
 			DUK__SEQ_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_SEQ_CR:
+		DUK__CASE(DUK_OP_SEQ_CR)
 			DUK__SEQ_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_SEQ_RC:
+		DUK__CASE(DUK_OP_SEQ_RC)
 			DUK__SEQ_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_SEQ_CC:
+		DUK__CASE(DUK_OP_SEQ_CC)
 			DUK__SEQ_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_SNEQ_RR:
+		DUK__CASE(DUK_OP_SNEQ_RR)
 			DUK__SNEQ_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_SNEQ_CR:
+		DUK__CASE(DUK_OP_SNEQ_CR)
 			DUK__SNEQ_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_SNEQ_RC:
+		DUK__CASE(DUK_OP_SNEQ_RC)
 			DUK__SNEQ_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_SNEQ_CC:
+		DUK__CASE(DUK_OP_SNEQ_CC)
 			DUK__SNEQ_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
@@ -3649,353 +4120,377 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #define DUK__LT_BODY(barg,carg) DUK__COMPARE_BODY((barg), (carg), DUK_COMPARE_FLAG_EVAL_LEFT_FIRST)
 #define DUK__LE_BODY(barg,carg) DUK__COMPARE_BODY((carg), (barg), DUK_COMPARE_FLAG_NEGATE)
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_GT_RR:
-		case DUK_OP_GT_CR:
-		case DUK_OP_GT_RC:
-		case DUK_OP_GT_CC:
+		DUK__CASE(DUK_OP_GT_RR)
+		DUK__CASE(DUK_OP_GT_CR)
+		DUK__CASE(DUK_OP_GT_RC)
+		DUK__CASE(DUK_OP_GT_CC)
 			DUK__GT_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_GE_RR:
-		case DUK_OP_GE_CR:
-		case DUK_OP_GE_RC:
-		case DUK_OP_GE_CC:
+		DUK__CASE(DUK_OP_GE_RR)
+		DUK__CASE(DUK_OP_GE_CR)
+		DUK__CASE(DUK_OP_GE_RC)
+		DUK__CASE(DUK_OP_GE_CC)
 			DUK__GE_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_LT_RR:
-		case DUK_OP_LT_CR:
-		case DUK_OP_LT_RC:
-		case DUK_OP_LT_CC:
+		DUK__CASE(DUK_OP_LT_RR)
+		DUK__CASE(DUK_OP_LT_CR)
+		DUK__CASE(DUK_OP_LT_RC)
+		DUK__CASE(DUK_OP_LT_CC)
 			DUK__LT_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_LE_RR:
-		case DUK_OP_LE_CR:
-		case DUK_OP_LE_RC:
-		case DUK_OP_LE_CC:
+		DUK__CASE(DUK_OP_LE_RR)
+		DUK__CASE(DUK_OP_LE_CR)
+		DUK__CASE(DUK_OP_LE_RC)
+		DUK__CASE(DUK_OP_LE_CC)
 			DUK__LE_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_GT_RR:
+		DUK__CASE(DUK_OP_GT_RR)
 			DUK__GT_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GT_CR:
+		DUK__CASE(DUK_OP_GT_CR)
 			DUK__GT_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GT_RC:
+		DUK__CASE(DUK_OP_GT_RC)
 			DUK__GT_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GT_CC:
+		DUK__CASE(DUK_OP_GT_CC)
 			DUK__GT_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GE_RR:
+		DUK__CASE(DUK_OP_GE_RR)
 			DUK__GE_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GE_CR:
+		DUK__CASE(DUK_OP_GE_CR)
 			DUK__GE_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GE_RC:
+		DUK__CASE(DUK_OP_GE_RC)
 			DUK__GE_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GE_CC:
+		DUK__CASE(DUK_OP_GE_CC)
 			DUK__GE_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_LT_RR:
+		DUK__CASE(DUK_OP_LT_RR)
 			DUK__LT_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_LT_CR:
+		DUK__CASE(DUK_OP_LT_CR)
 			DUK__LT_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_LT_RC:
+		DUK__CASE(DUK_OP_LT_RC)
 			DUK__LT_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_LT_CC:
+		DUK__CASE(DUK_OP_LT_CC)
 			DUK__LT_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_LE_RR:
+		DUK__CASE(DUK_OP_LE_RR)
 			DUK__LE_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_LE_CR:
+		DUK__CASE(DUK_OP_LE_CR)
 			DUK__LE_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_LE_RC:
+		DUK__CASE(DUK_OP_LE_RC)
 			DUK__LE_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_LE_CC:
+		DUK__CASE(DUK_OP_LE_CC)
 			DUK__LE_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 		/* No size optimized variant at present for IF. */
-		case DUK_OP_IFTRUE_R: {
+		DUK__CASE(DUK_OP_IFTRUE_R) {
 			if (duk_js_toboolean(DUK__REGP_BC(ins)) != 0) {
 				curr_pc++;
 			}
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_IFTRUE_C: {
+		DUK__CASE(DUK_OP_IFTRUE_C) {
 			if (duk_js_toboolean(DUK__CONSTP_BC(ins)) != 0) {
 				curr_pc++;
 			}
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_IFFALSE_R: {
+		DUK__CASE(DUK_OP_IFFALSE_R) {
 			if (duk_js_toboolean(DUK__REGP_BC(ins)) == 0) {
 				curr_pc++;
 			}
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_IFFALSE_C: {
+		DUK__CASE(DUK_OP_IFFALSE_C) {
 			if (duk_js_toboolean(DUK__CONSTP_BC(ins)) == 0) {
 				curr_pc++;
 			}
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_ADD_RR:
-		case DUK_OP_ADD_CR:
-		case DUK_OP_ADD_RC:
-		case DUK_OP_ADD_CC: {
+		DUK__CASE(DUK_OP_ADD_RR)
+		DUK__CASE(DUK_OP_ADD_CR)
+		DUK__CASE(DUK_OP_ADD_RC)
+		DUK__CASE(DUK_OP_ADD_CC)
+		DUK__CASE(DUK_OP_ADDT_CR)
+		DUK__CASE(DUK_OP_ADDT_CC) {
 			/* XXX: could leave value on stack top and goto replace_top_a; */
 			duk__vm_arith_add(thr, DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
+		}
+		DUK__CASE(DUK_OP_ADDT_RR)
+		DUK__CASE(DUK_OP_ADDT_RC) {
+			duk__vm_arith_add_temp(thr, DUK__REGP_B(ins), DUK__REGCONSTP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_ADD_RR: {
+		DUK__CASE(DUK_OP_ADD_RR) {
 			duk__vm_arith_add(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_ADD_CR: {
+		DUK__CASE(DUK_OP_ADD_CR) {
 			duk__vm_arith_add(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_ADD_RC: {
+		DUK__CASE(DUK_OP_ADD_RC) {
 			duk__vm_arith_add(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_ADD_CC: {
+		DUK__CASE(DUK_OP_ADD_CC) {
 			duk__vm_arith_add(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins));
-			break;
+			DUK__DISPATCH_NEXT();
+		}
+		DUK__CASE(DUK_OP_ADDT_RR) {
+			duk__vm_arith_add_temp(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
+		}
+		DUK__CASE(DUK_OP_ADDT_RC) {
+			duk__vm_arith_add_temp(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
+		}
+		DUK__CASE(DUK_OP_ADDT_CR) {
+			/* Never emitted, B is always a temporary register. */
+			duk__vm_arith_add(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
+		}
+		DUK__CASE(DUK_OP_ADDT_CC) {
+			duk__vm_arith_add(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins));
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_SUB_RR:
-		case DUK_OP_SUB_CR:
-		case DUK_OP_SUB_RC:
-		case DUK_OP_SUB_CC:
-		case DUK_OP_MUL_RR:
-		case DUK_OP_MUL_CR:
-		case DUK_OP_MUL_RC:
-		case DUK_OP_MUL_CC:
-		case DUK_OP_DIV_RR:
-		case DUK_OP_DIV_CR:
-		case DUK_OP_DIV_RC:
-		case DUK_OP_DIV_CC:
-		case DUK_OP_MOD_RR:
-		case DUK_OP_MOD_CR:
-		case DUK_OP_MOD_RC:
-		case DUK_OP_MOD_CC:
+		DUK__CASE(DUK_OP_SUB_RR)
+		DUK__CASE(DUK_OP_SUB_CR)
+		DUK__CASE(DUK_OP_SUB_RC)
+		DUK__CASE(DUK_OP_SUB_CC)
+		DUK__CASE(DUK_OP_MUL_RR)
+		DUK__CASE(DUK_OP_MUL_CR)
+		DUK__CASE(DUK_OP_MUL_RC)
+		DUK__CASE(DUK_OP_MUL_CC)
+		DUK__CASE(DUK_OP_DIV_RR)
+		DUK__CASE(DUK_OP_DIV_CR)
+		DUK__CASE(DUK_OP_DIV_RC)
+		DUK__CASE(DUK_OP_DIV_CC)
+		DUK__CASE(DUK_OP_MOD_RR)
+		DUK__CASE(DUK_OP_MOD_CR)
+		DUK__CASE(DUK_OP_MOD_RC)
+		DUK__CASE(DUK_OP_MOD_CC)
 #if defined(DUK_USE_ES7_EXP_OPERATOR)
-		case DUK_OP_EXP_RR:
-		case DUK_OP_EXP_CR:
-		case DUK_OP_EXP_RC:
-		case DUK_OP_EXP_CC:
+		DUK__CASE(DUK_OP_EXP_RR)
+		DUK__CASE(DUK_OP_EXP_CR)
+		DUK__CASE(DUK_OP_EXP_RC)
+		DUK__CASE(DUK_OP_EXP_CC)
 #endif  /* DUK_USE_ES7_EXP_OPERATOR */
 		{
 			/* XXX: could leave value on stack top and goto replace_top_a; */
 			duk__vm_arith_binary_op(thr, DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins), DUK_DEC_A(ins), op);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_SUB_RR: {
+		DUK__CASE(DUK_OP_SUB_RR) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_SUB);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_SUB_CR: {
+		DUK__CASE(DUK_OP_SUB_CR) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_SUB);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_SUB_RC: {
+		DUK__CASE(DUK_OP_SUB_RC) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_SUB);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_SUB_CC: {
+		DUK__CASE(DUK_OP_SUB_CC) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_SUB);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MUL_RR: {
+		DUK__CASE(DUK_OP_MUL_RR) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_MUL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MUL_CR: {
+		DUK__CASE(DUK_OP_MUL_CR) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_MUL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MUL_RC: {
+		DUK__CASE(DUK_OP_MUL_RC) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_MUL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MUL_CC: {
+		DUK__CASE(DUK_OP_MUL_CC) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_MUL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_DIV_RR: {
+		DUK__CASE(DUK_OP_DIV_RR) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_DIV);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_DIV_CR: {
+		DUK__CASE(DUK_OP_DIV_CR) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_DIV);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_DIV_RC: {
+		DUK__CASE(DUK_OP_DIV_RC) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_DIV);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_DIV_CC: {
+		DUK__CASE(DUK_OP_DIV_CC) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_DIV);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MOD_RR: {
+		DUK__CASE(DUK_OP_MOD_RR) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_MOD);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MOD_CR: {
+		DUK__CASE(DUK_OP_MOD_CR) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_MOD);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MOD_RC: {
+		DUK__CASE(DUK_OP_MOD_RC) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_MOD);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_MOD_CC: {
+		DUK__CASE(DUK_OP_MOD_CC) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_MOD);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #if defined(DUK_USE_ES7_EXP_OPERATOR)
-		case DUK_OP_EXP_RR: {
+		DUK__CASE(DUK_OP_EXP_RR) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_EXP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_EXP_CR: {
+		DUK__CASE(DUK_OP_EXP_CR) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_EXP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_EXP_RC: {
+		DUK__CASE(DUK_OP_EXP_RC) {
 			duk__vm_arith_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_EXP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_EXP_CC: {
+		DUK__CASE(DUK_OP_EXP_CC) {
 			duk__vm_arith_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_EXP);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_ES7_EXP_OPERATOR */
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_BAND_RR:
-		case DUK_OP_BAND_CR:
-		case DUK_OP_BAND_RC:
-		case DUK_OP_BAND_CC:
-		case DUK_OP_BOR_RR:
-		case DUK_OP_BOR_CR:
-		case DUK_OP_BOR_RC:
-		case DUK_OP_BOR_CC:
-		case DUK_OP_BXOR_RR:
-		case DUK_OP_BXOR_CR:
-		case DUK_OP_BXOR_RC:
-		case DUK_OP_BXOR_CC:
-		case DUK_OP_BASL_RR:
-		case DUK_OP_BASL_CR:
-		case DUK_OP_BASL_RC:
-		case DUK_OP_BASL_CC:
-		case DUK_OP_BLSR_RR:
-		case DUK_OP_BLSR_CR:
-		case DUK_OP_BLSR_RC:
-		case DUK_OP_BLSR_CC:
-		case DUK_OP_BASR_RR:
-		case DUK_OP_BASR_CR:
-		case DUK_OP_BASR_RC:
-		case DUK_OP_BASR_CC: {
+		DUK__CASE(DUK_OP_BAND_RR)
+		DUK__CASE(DUK_OP_BAND_CR)
+		DUK__CASE(DUK_OP_BAND_RC)
+		DUK__CASE(DUK_OP_BAND_CC)
+		DUK__CASE(DUK_OP_BOR_RR)
+		DUK__CASE(DUK_OP_BOR_CR)
+		DUK__CASE(DUK_OP_BOR_RC)
+		DUK__CASE(DUK_OP_BOR_CC)
+		DUK__CASE(DUK_OP_BXOR_RR)
+		DUK__CASE(DUK_OP_BXOR_CR)
+		DUK__CASE(DUK_OP_BXOR_RC)
+		DUK__CASE(DUK_OP_BXOR_CC)
+		DUK__CASE(DUK_OP_BASL_RR)
+		DUK__CASE(DUK_OP_BASL_CR)
+		DUK__CASE(DUK_OP_BASL_RC)
+		DUK__CASE(DUK_OP_BASL_CC)
+		DUK__CASE(DUK_OP_BLSR_RR)
+		DUK__CASE(DUK_OP_BLSR_CR)
+		DUK__CASE(DUK_OP_BLSR_RC)
+		DUK__CASE(DUK_OP_BLSR_CC)
+		DUK__CASE(DUK_OP_BASR_RR)
+		DUK__CASE(DUK_OP_BASR_CR)
+		DUK__CASE(DUK_OP_BASR_RC)
+		DUK__CASE(DUK_OP_BASR_CC) {
 			/* XXX: could leave value on stack top and goto replace_top_a; */
 			duk__vm_bitwise_binary_op(thr, DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins), DUK_DEC_A(ins), op);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_BAND_RR: {
+		DUK__CASE(DUK_OP_BAND_RR) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BAND);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BAND_CR: {
+		DUK__CASE(DUK_OP_BAND_CR) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BAND);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BAND_RC: {
+		DUK__CASE(DUK_OP_BAND_RC) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BAND);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BAND_CC: {
+		DUK__CASE(DUK_OP_BAND_CC) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BAND);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BOR_RR: {
+		DUK__CASE(DUK_OP_BOR_RR) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BOR_CR: {
+		DUK__CASE(DUK_OP_BOR_CR) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BOR_RC: {
+		DUK__CASE(DUK_OP_BOR_RC) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BOR_CC: {
+		DUK__CASE(DUK_OP_BOR_CC) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BXOR_RR: {
+		DUK__CASE(DUK_OP_BXOR_RR) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BXOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BXOR_CR: {
+		DUK__CASE(DUK_OP_BXOR_CR) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BXOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BXOR_RC: {
+		DUK__CASE(DUK_OP_BXOR_RC) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BXOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BXOR_CC: {
+		DUK__CASE(DUK_OP_BXOR_CC) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BXOR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASL_RR: {
+		DUK__CASE(DUK_OP_BASL_RR) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BASL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASL_CR: {
+		DUK__CASE(DUK_OP_BASL_CR) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BASL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASL_RC: {
+		DUK__CASE(DUK_OP_BASL_RC) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BASL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASL_CC: {
+		DUK__CASE(DUK_OP_BASL_CC) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BASL);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BLSR_RR: {
+		DUK__CASE(DUK_OP_BLSR_RR) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BLSR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BLSR_CR: {
+		DUK__CASE(DUK_OP_BLSR_CR) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BLSR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BLSR_RC: {
+		DUK__CASE(DUK_OP_BLSR_RC) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BLSR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BLSR_CC: {
+		DUK__CASE(DUK_OP_BLSR_CC) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BLSR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASR_RR: {
+		DUK__CASE(DUK_OP_BASR_RR) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BASR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASR_CR: {
+		DUK__CASE(DUK_OP_BASR_CR) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__REGP_C(ins), DUK_DEC_A(ins), DUK_OP_BASR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASR_RC: {
+		DUK__CASE(DUK_OP_BASR_RC) {
 			duk__vm_bitwise_binary_op(thr, DUK__REGP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BASR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_BASR_CC: {
+		DUK__CASE(DUK_OP_BASR_CC) {
 			duk__vm_bitwise_binary_op(thr, DUK__CONSTP_B(ins), DUK__CONSTP_C(ins), DUK_DEC_A(ins), DUK_OP_BASR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
@@ -4013,104 +4508,104 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK__REPLACE_BOOL_A_BREAK(tmp); \
 	}
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_INSTOF_RR:
-		case DUK_OP_INSTOF_CR:
-		case DUK_OP_INSTOF_RC:
-		case DUK_OP_INSTOF_CC:
+		DUK__CASE(DUK_OP_INSTOF_RR)
+		DUK__CASE(DUK_OP_INSTOF_CR)
+		DUK__CASE(DUK_OP_INSTOF_RC)
+		DUK__CASE(DUK_OP_INSTOF_CC)
 			DUK__INSTOF_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_IN_RR:
-		case DUK_OP_IN_CR:
-		case DUK_OP_IN_RC:
-		case DUK_OP_IN_CC:
+		DUK__CASE(DUK_OP_IN_RR)
+		DUK__CASE(DUK_OP_IN_CR)
+		DUK__CASE(DUK_OP_IN_RC)
+		DUK__CASE(DUK_OP_IN_CC)
 			DUK__IN_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_INSTOF_RR:
+		DUK__CASE(DUK_OP_INSTOF_RR)
 			DUK__INSTOF_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_INSTOF_CR:
+		DUK__CASE(DUK_OP_INSTOF_CR)
 			DUK__INSTOF_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_INSTOF_RC:
+		DUK__CASE(DUK_OP_INSTOF_RC)
 			DUK__INSTOF_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_INSTOF_CC:
+		DUK__CASE(DUK_OP_INSTOF_CC)
 			DUK__INSTOF_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_IN_RR:
+		DUK__CASE(DUK_OP_IN_RR)
 			DUK__IN_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_IN_CR:
+		DUK__CASE(DUK_OP_IN_CR)
 			DUK__IN_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_IN_RC:
+		DUK__CASE(DUK_OP_IN_RC)
 			DUK__IN_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_IN_CC:
+		DUK__CASE(DUK_OP_IN_CC)
 			DUK__IN_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 		/* Pre/post inc/dec for register variables, important for loops. */
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_PREINCR:
-		case DUK_OP_PREDECR:
-		case DUK_OP_POSTINCR:
-		case DUK_OP_POSTDECR: {
+		DUK__CASE(DUK_OP_PREINCR)
+		DUK__CASE(DUK_OP_PREDECR)
+		DUK__CASE(DUK_OP_POSTINCR)
+		DUK__CASE(DUK_OP_POSTDECR) {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), op);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_PREINCV:
-		case DUK_OP_PREDECV:
-		case DUK_OP_POSTINCV:
-		case DUK_OP_POSTDECV: {
+		DUK__CASE(DUK_OP_PREINCV)
+		DUK__CASE(DUK_OP_PREDECV)
+		DUK__CASE(DUK_OP_POSTINCV)
+		DUK__CASE(DUK_OP_POSTDECV) {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), op, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_PREINCR: {
+		DUK__CASE(DUK_OP_PREINCR) {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), DUK_OP_PREINCR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_PREDECR: {
+		DUK__CASE(DUK_OP_PREDECR) {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), DUK_OP_PREDECR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_POSTINCR: {
+		DUK__CASE(DUK_OP_POSTINCR) {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), DUK_OP_POSTINCR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_POSTDECR: {
+		DUK__CASE(DUK_OP_POSTDECR) {
 			duk__prepost_incdec_reg_helper(thr, DUK__REGP_A(ins), DUK__REGP_BC(ins), DUK_OP_POSTDECR);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_PREINCV: {
+		DUK__CASE(DUK_OP_PREINCV) {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), DUK_OP_PREINCV, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_PREDECV: {
+		DUK__CASE(DUK_OP_PREDECV) {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), DUK_OP_PREDECV, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_POSTINCV: {
+		DUK__CASE(DUK_OP_POSTINCV) {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), DUK_OP_POSTINCV, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
-		case DUK_OP_POSTDECV: {
+		DUK__CASE(DUK_OP_POSTDECV) {
 			duk__prepost_incdec_var_helper(thr, DUK_DEC_A(ins), DUK__CONSTP_BC(ins), DUK_OP_POSTDECV, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 		/* XXX: Move to separate helper, optimize for perf/size separately. */
 		/* Preinc/predec for object properties. */
-		case DUK_OP_PREINCP_RR:
-		case DUK_OP_PREINCP_CR:
-		case DUK_OP_PREINCP_RC:
-		case DUK_OP_PREINCP_CC:
-		case DUK_OP_PREDECP_RR:
-		case DUK_OP_PREDECP_CR:
-		case DUK_OP_PREDECP_RC:
-		case DUK_OP_PREDECP_CC:
-		case DUK_OP_POSTINCP_RR:
-		case DUK_OP_POSTINCP_CR:
-		case DUK_OP_POSTINCP_RC:
-		case DUK_OP_POSTINCP_CC:
-		case DUK_OP_POSTDECP_RR:
-		case DUK_OP_POSTDECP_CR:
-		case DUK_OP_POSTDECP_RC:
-		case DUK_OP_POSTDECP_CC: {
+		DUK__CASE(DUK_OP_PREINCP_RR)
+		DUK__CASE(DUK_OP_PREINCP_CR)
+		DUK__CASE(DUK_OP_PREINCP_RC)
+		DUK__CASE(DUK_OP_PREINCP_CC)
+		DUK__CASE(DUK_OP_PREDECP_RR)
+		DUK__CASE(DUK_OP_PREDECP_CR)
+		DUK__CASE(DUK_OP_PREDECP_RC)
+		DUK__CASE(DUK_OP_PREDECP_CC)
+		DUK__CASE(DUK_OP_POSTINCP_RR)
+		DUK__CASE(DUK_OP_POSTINCP_CR)
+		DUK__CASE(DUK_OP_POSTINCP_RC)
+		DUK__CASE(DUK_OP_POSTINCP_CC)
+		DUK__CASE(DUK_OP_POSTDECP_RR)
+		DUK__CASE(DUK_OP_POSTDECP_CR)
+		DUK__CASE(DUK_OP_POSTDECP_RC)
+		DUK__CASE(DUK_OP_POSTDECP_CC) {
 			duk_tval *tv_obj;
 			duk_tval *tv_key;
 			duk_tval *tv_val;
@@ -4172,7 +4667,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #else
 			tv_dst = DUK__REGP_A(ins);
 			DUK_TVAL_SET_NUMBER_UPDREF(thr, tv_dst, z);
-			break;
+			DUK__DISPATCH_NEXT();
 #endif
 		}
 
@@ -4212,8 +4707,44 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * of e.g. GETPROP; 'A' must contain a register-only value. \
 		 */ \
 		(void) duk_hobject_putprop(thr, (aarg), (barg), (carg), DUK__STRICT()); \
-		break; \
+		DUK__DISPATCH_NEXT(); \
+	}
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+		/* Constant key variants: on an inline cache hit read or write
+		 * the property slot directly, otherwise use the generic body.
+		 */
+#define DUK__GETPROP_IC_BODY(barg,carg) { \
+		duk_tval *tv__ic; \
+		tv__ic = duk__icache_getprop(thr, DUK__FUN(), curr_pc, (barg), (carg)); \
+		if (DUK_LIKELY(tv__ic != NULL)) { \
+			DUK_TVAL_SET_TVAL_UPDREF(thr, DUK__REGP_A(ins), tv__ic); \
+			DUK__DISPATCH_NEXT(); \
+		} \
+		DUK__GETPROP_BODY((barg), (carg)); \
 	}
+#define DUK__GETPROPC_IC_BODY(barg,carg) { \
+		duk_tval *tv__ic; \
+		tv__ic = duk__icache_getprop(thr, DUK__FUN(), curr_pc, (barg), (carg)); \
+		if (DUK_LIKELY(tv__ic != NULL && duk_is_callable_tval(thr, tv__ic))) { \
+			DUK_TVAL_SET_TVAL_UPDREF(thr, DUK__REGP_A(ins), tv__ic); \
+			DUK__DISPATCH_NEXT(); \
+		} \
+		DUK__GETPROPC_BODY((barg), (carg)); \
+	}
+#define DUK__PUTPROP_IC_BODY(aarg,barg,carg) { \
+		duk_tval *tv__ic; \
+		tv__ic = duk__icache_putprop(thr, DUK__FUN(), curr_pc, (aarg), (barg)); \
+		if (DUK_LIKELY(tv__ic != NULL)) { \
+			DUK_TVAL_SET_TVAL_UPDREF(thr, tv__ic, (carg)); \
+			DUK__DISPATCH_NEXT(); \
+		} \
+		DUK__PUTPROP_BODY((aarg), (barg), (carg)); \
+	}
+#else
+#define DUK__GETPROP_IC_BODY(barg,carg) DUK__GETPROP_BODY((barg), (carg))
+#define DUK__GETPROPC_IC_BODY(barg,carg) DUK__GETPROPC_BODY((barg), (carg))
+#define DUK__PUTPROP_IC_BODY(aarg,barg,carg) DUK__PUTPROP_BODY((aarg), (barg), (carg))
+#endif  /* DUK_USE_EXEC_INLINE_CACHE */
 #define DUK__DELPROP_BODY(barg,carg) { \
 		/* A -> result reg \
 		 * B -> object reg \
@@ -4225,64 +4756,64 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		DUK__REPLACE_BOOL_A_BREAK(rc); \
 	}
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_GETPROP_RR:
-		case DUK_OP_GETPROP_CR:
-		case DUK_OP_GETPROP_RC:
-		case DUK_OP_GETPROP_CC:
+		DUK__CASE(DUK_OP_GETPROP_RR)
+		DUK__CASE(DUK_OP_GETPROP_CR)
+		DUK__CASE(DUK_OP_GETPROP_RC)
+		DUK__CASE(DUK_OP_GETPROP_CC)
 			DUK__GETPROP_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #if defined(DUK_USE_VERBOSE_ERRORS)
-		case DUK_OP_GETPROPC_RR:
-		case DUK_OP_GETPROPC_CR:
-		case DUK_OP_GETPROPC_RC:
-		case DUK_OP_GETPROPC_CC:
+		DUK__CASE(DUK_OP_GETPROPC_RR)
+		DUK__CASE(DUK_OP_GETPROPC_CR)
+		DUK__CASE(DUK_OP_GETPROPC_RC)
+		DUK__CASE(DUK_OP_GETPROPC_CC)
 			DUK__GETPROPC_BODY(DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
 #endif
-		case DUK_OP_PUTPROP_RR:
-		case DUK_OP_PUTPROP_CR:
-		case DUK_OP_PUTPROP_RC:
-		case DUK_OP_PUTPROP_CC:
+		DUK__CASE(DUK_OP_PUTPROP_RR)
+		DUK__CASE(DUK_OP_PUTPROP_CR)
+		DUK__CASE(DUK_OP_PUTPROP_RC)
+		DUK__CASE(DUK_OP_PUTPROP_CC)
 			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__REGCONSTP_B(ins), DUK__REGCONSTP_C(ins));
-		case DUK_OP_DELPROP_RR:
-		case DUK_OP_DELPROP_RC:  /* B is always reg */
+		DUK__CASE(DUK_OP_DELPROP_RR)
+		DUK__CASE(DUK_OP_DELPROP_RC)  /* B is always reg */
 			DUK__DELPROP_BODY(DUK__REGP_B(ins), DUK__REGCONSTP_C(ins));
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_GETPROP_RR:
+		DUK__CASE(DUK_OP_GETPROP_RR)
 			DUK__GETPROP_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GETPROP_CR:
+		DUK__CASE(DUK_OP_GETPROP_CR)
 			DUK__GETPROP_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GETPROP_RC:
-			DUK__GETPROP_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GETPROP_CC:
-			DUK__GETPROP_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
+		DUK__CASE(DUK_OP_GETPROP_RC)
+			DUK__GETPROP_IC_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
+		DUK__CASE(DUK_OP_GETPROP_CC)
+			DUK__GETPROP_IC_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #if defined(DUK_USE_VERBOSE_ERRORS)
-		case DUK_OP_GETPROPC_RR:
+		DUK__CASE(DUK_OP_GETPROPC_RR)
 			DUK__GETPROPC_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GETPROPC_CR:
+		DUK__CASE(DUK_OP_GETPROPC_CR)
 			DUK__GETPROPC_BODY(DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_GETPROPC_RC:
-			DUK__GETPROPC_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_GETPROPC_CC:
-			DUK__GETPROPC_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
+		DUK__CASE(DUK_OP_GETPROPC_RC)
+			DUK__GETPROPC_IC_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
+		DUK__CASE(DUK_OP_GETPROPC_CC)
+			DUK__GETPROPC_IC_BODY(DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
 #endif
-		case DUK_OP_PUTPROP_RR:
+		DUK__CASE(DUK_OP_PUTPROP_RR)
 			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_PUTPROP_CR:
-			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__CONSTP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_PUTPROP_RC:
+		DUK__CASE(DUK_OP_PUTPROP_CR)
+			DUK__PUTPROP_IC_BODY(DUK__REGP_A(ins), DUK__CONSTP_B(ins), DUK__REGP_C(ins));
+		DUK__CASE(DUK_OP_PUTPROP_RC)
 			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__REGP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_PUTPROP_CC:
-			DUK__PUTPROP_BODY(DUK__REGP_A(ins), DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
-		case DUK_OP_DELPROP_RR:  /* B is always reg */
+		DUK__CASE(DUK_OP_PUTPROP_CC)
+			DUK__PUTPROP_IC_BODY(DUK__REGP_A(ins), DUK__CONSTP_B(ins), DUK__CONSTP_C(ins));
+		DUK__CASE(DUK_OP_DELPROP_RR)  /* B is always reg */
 			DUK__DELPROP_BODY(DUK__REGP_B(ins), DUK__REGP_C(ins));
-		case DUK_OP_DELPROP_RC:
+		DUK__CASE(DUK_OP_DELPROP_RC)
 			DUK__DELPROP_BODY(DUK__REGP_B(ins), DUK__CONSTP_C(ins));
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
 		/* No fast path for DECLVAR now, it's quite a rare instruction. */
-		case DUK_OP_DECLVAR_RR:
-		case DUK_OP_DECLVAR_CR:
-		case DUK_OP_DECLVAR_RC:
-		case DUK_OP_DECLVAR_CC: {
+		DUK__CASE(DUK_OP_DECLVAR_RR)
+		DUK__CASE(DUK_OP_DECLVAR_CR)
+		DUK__CASE(DUK_OP_DECLVAR_RC)
+		DUK__CASE(DUK_OP_DECLVAR_CC) {
 			duk_activation *act;
 			duk_small_uint_fast_t a = DUK_DEC_A(ins);
 			duk_tval *tv1;
@@ -4328,17 +4859,17 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			}
 
 			duk_pop_unsafe(thr);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #if defined(DUK_USE_REGEXP_SUPPORT)
 		/* The compiler should never emit DUK_OP_REGEXP if there is no
 		 * regexp support.
 		 */
-		case DUK_OP_REGEXP_RR:
-		case DUK_OP_REGEXP_CR:
-		case DUK_OP_REGEXP_RC:
-		case DUK_OP_REGEXP_CC: {
+		DUK__CASE(DUK_OP_REGEXP_RR)
+		DUK__CASE(DUK_OP_REGEXP_CR)
+		DUK__CASE(DUK_OP_REGEXP_RC)
+		DUK__CASE(DUK_OP_REGEXP_CC) {
 			/* A -> target register
 			 * B -> bytecode (also contains flags)
 			 * C -> escaped source
@@ -4352,10 +4883,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #endif  /* DUK_USE_REGEXP_SUPPORT */
 
 		/* XXX: 'c' is unused, use whole BC, etc. */
-		case DUK_OP_CSVAR_RR:
-		case DUK_OP_CSVAR_CR:
-		case DUK_OP_CSVAR_RC:
-		case DUK_OP_CSVAR_CC: {
+		DUK__CASE(DUK_OP_CSVAR_RR)
+		DUK__CASE(DUK_OP_CSVAR_CR)
+		DUK__CASE(DUK_OP_CSVAR_RC)
+		DUK__CASE(DUK_OP_CSVAR_CC) {
 			/* The speciality of calling through a variable binding is that the
 			 * 'this' value may be provided by the variable lookup: E5 Section 6.b.i.
 			 *
@@ -4385,10 +4916,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			/* Could add direct value stack handling. */
 			duk_replace(thr, (duk_idx_t) (idx + 1));  /* 'this' binding */
 			duk_replace(thr, (duk_idx_t) idx);        /* variable value (function, we hope, not checked here) */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_CLOSURE: {
+		DUK__CASE(DUK_OP_CLOSURE) {
 			duk_activation *act;
 			duk_hcompfunc *fun_act;
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
@@ -4433,7 +4964,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_A_BREAK();
 		}
 
-		case DUK_OP_GETVAR: {
+		DUK__CASE(DUK_OP_GETVAR) {
 			duk_activation *act;
 			duk_tval *tv1;
 			duk_hstring *name;
@@ -4449,7 +4980,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_A_BREAK();
 		}
 
-		case DUK_OP_PUTVAR: {
+		DUK__CASE(DUK_OP_PUTVAR) {
 			duk_activation *act;
 			duk_tval *tv1;
 			duk_hstring *name;
@@ -4466,10 +4997,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			tv1 = DUK__REGP_A(ins);  /* val */
 			act = thr->callstack_curr;
 			duk_js_putvar_activation(thr, act, name, tv1, DUK__STRICT());
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_DELVAR: {
+		DUK__CASE(DUK_OP_DELVAR) {
 			duk_activation *act;
 			duk_tval *tv1;
 			duk_hstring *name;
@@ -4484,13 +5015,13 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_BOOL_A_BREAK(rc);
 		}
 
-		case DUK_OP_JUMP: {
+		DUK__CASE(DUK_OP_JUMP) {
 			/* Note: without explicit cast to signed, MSVC will
 			 * apparently generate a large positive jump when the
 			 * bias-corrected value would normally be negative.
 			 */
 			curr_pc += (duk_int_fast_t) DUK_DEC_ABC(ins) - (duk_int_fast_t) DUK_BC_JUMP_BIAS;
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #define DUK__RETURN_SHARED() do { \
@@ -4508,10 +5039,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		return; \
 	} while (0)
 #if defined(DUK_USE_EXEC_PREFER_SIZE)
-		case DUK_OP_RETREG:
-		case DUK_OP_RETCONST:
-		case DUK_OP_RETCONSTN:
-		case DUK_OP_RETUNDEF: {
+		DUK__CASE(DUK_OP_RETREG)
+		DUK__CASE(DUK_OP_RETCONST)
+		DUK__CASE(DUK_OP_RETCONSTN)
+		DUK__CASE(DUK_OP_RETUNDEF) {
 			 /* BC -> return value reg/const */
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -4529,7 +5060,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__RETURN_SHARED();
 		}
 #else  /* DUK_USE_EXEC_PREFER_SIZE */
-		case DUK_OP_RETREG: {
+		DUK__CASE(DUK_OP_RETREG) {
 			duk_tval *tv;
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -4540,7 +5071,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__RETURN_SHARED();
 		}
 		/* This will be unused without refcounting. */
-		case DUK_OP_RETCONST: {
+		DUK__CASE(DUK_OP_RETCONST) {
 			duk_tval *tv;
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -4550,7 +5081,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			thr->valstack_top++;
 			DUK__RETURN_SHARED();
 		}
-		case DUK_OP_RETCONSTN: {
+		DUK__CASE(DUK_OP_RETCONSTN) {
 			duk_tval *tv;
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -4563,7 +5094,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			thr->valstack_top++;
 			DUK__RETURN_SHARED();
 		}
-		case DUK_OP_RETUNDEF: {
+		DUK__CASE(DUK_OP_RETUNDEF) {
 			DUK__SYNC_AND_NULL_CURR_PC();
 			thr->valstack_top++;  /* value at valstack top is already undefined by valstack policy */
 			DUK_ASSERT(DUK_TVAL_IS_UNDEFINED(thr->valstack_top));
@@ -4571,7 +5102,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		}
 #endif  /* DUK_USE_EXEC_PREFER_SIZE */
 
-		case DUK_OP_LABEL: {
+		DUK__CASE(DUK_OP_LABEL) {
 			duk_activation *act;
 			duk_catcher *cat;
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
@@ -4597,10 +5128,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			                     (long) cat->idx_base, (duk_heaphdr *) cat->h_varname, (long) DUK_CAT_GET_LABEL(cat)));
 
 			curr_pc += 2;  /* skip jump slots */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_ENDLABEL: {
+		DUK__CASE(DUK_OP_ENDLABEL) {
 			duk_activation *act;
 #if (defined(DUK_USE_DEBUG_LEVEL) && (DUK_USE_DEBUG_LEVEL >= 2)) || defined(DUK_USE_ASSERTIONS)
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
@@ -4616,10 +5147,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			duk_hthread_catcher_unwind_nolexenv_norz(thr, act);
 
 			/* no need to unwind callstack */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_BREAK: {
+		DUK__CASE(DUK_OP_BREAK) {
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -4627,7 +5158,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			goto restart_execution;
 		}
 
-		case DUK_OP_CONTINUE: {
+		DUK__CASE(DUK_OP_CONTINUE) {
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
 
 			DUK__SYNC_AND_NULL_CURR_PC();
@@ -4636,23 +5167,23 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		}
 
 		/* XXX: move to helper, too large to be inline here */
-		case DUK_OP_TRYCATCH: {
+		DUK__CASE(DUK_OP_TRYCATCH) {
 			duk__handle_op_trycatch(thr, ins, curr_pc);
 			curr_pc += 2;  /* skip jump slots */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_ENDTRY: {
+		DUK__CASE(DUK_OP_ENDTRY) {
 			curr_pc = duk__handle_op_endtry(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_ENDCATCH: {
+		DUK__CASE(DUK_OP_ENDCATCH) {
 			duk__handle_op_endcatch(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_ENDFIN: {
+		DUK__CASE(DUK_OP_ENDFIN) {
 			/* Sync and NULL early. */
 			DUK__SYNC_AND_NULL_CURR_PC();
 
@@ -4664,7 +5195,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			goto restart_execution;
 		}
 
-		case DUK_OP_THROW: {
+		DUK__CASE(DUK_OP_THROW) {
 			duk_small_uint_fast_t bc = DUK_DEC_BC(ins);
 
 			/* Note: errors are augmented when they are created, not
@@ -4695,10 +5226,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK_ASSERT(thr->heap->lj.jmpbuf_ptr != NULL);  /* always in executor */
 			duk_err_longjmp(thr);
 			DUK_UNREACHABLE();
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_CSREG: {
+		DUK__CASE(DUK_OP_CSREG) {
 			/*
 			 *  Assuming a register binds to a variable declared within this
 			 *  function (a declarative binding), the 'this' for the call
@@ -4734,7 +5265,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK_TVAL_DECREF(thr, &tv_tmp1);
 			DUK_TVAL_DECREF(thr, &tv_tmp2);
 #endif
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 
@@ -4744,14 +5275,14 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 		 * stack resize would be large).
 		 */
 
-		case DUK_OP_CALL0:
-		case DUK_OP_CALL1:
-		case DUK_OP_CALL2:
-		case DUK_OP_CALL3:
-		case DUK_OP_CALL4:
-		case DUK_OP_CALL5:
-		case DUK_OP_CALL6:
-		case DUK_OP_CALL7: {
+		DUK__CASE(DUK_OP_CALL0)
+		DUK__CASE(DUK_OP_CALL1)
+		DUK__CASE(DUK_OP_CALL2)
+		DUK__CASE(DUK_OP_CALL3)
+		DUK__CASE(DUK_OP_CALL4)
+		DUK__CASE(DUK_OP_CALL5)
+		DUK__CASE(DUK_OP_CALL6)
+		DUK__CASE(DUK_OP_CALL7) {
 			/* Opcode packs 4 flag bits: 1 for indirect, 3 map
 			 * 1:1 to three lowest call handling flags.
 			 *
@@ -4795,17 +5326,17 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			 * status after returning.  This is now handled by call handling
 			 * and heap->dbg_force_restart.
 			 */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_CALL8:
-		case DUK_OP_CALL9:
-		case DUK_OP_CALL10:
-		case DUK_OP_CALL11:
-		case DUK_OP_CALL12:
-		case DUK_OP_CALL13:
-		case DUK_OP_CALL14:
-		case DUK_OP_CALL15: {
+		DUK__CASE(DUK_OP_CALL8)
+		DUK__CASE(DUK_OP_CALL9)
+		DUK__CASE(DUK_OP_CALL10)
+		DUK__CASE(DUK_OP_CALL11)
+		DUK__CASE(DUK_OP_CALL12)
+		DUK__CASE(DUK_OP_CALL13)
+		DUK__CASE(DUK_OP_CALL14)
+		DUK__CASE(DUK_OP_CALL15) {
 			/* Indirect variant. */
 			duk_uint_fast_t nargs;
 			duk_idx_t idx;
@@ -4832,10 +5363,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			fun = DUK__FUN();
 #endif
 			duk_set_top_unsafe(thr, (duk_idx_t) fun->nregs);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_NEWOBJ: {
+		DUK__CASE(DUK_OP_NEWOBJ) {
 			duk_push_object(thr);
 #if defined(DUK_USE_ASSERTIONS)
 			{
@@ -4854,7 +5385,7 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
 
-		case DUK_OP_NEWARR: {
+		DUK__CASE(DUK_OP_NEWARR) {
 			duk_push_array(thr);
 #if defined(DUK_USE_ASSERTIONS)
 			{
@@ -4881,8 +5412,8 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
 
-		case DUK_OP_MPUTOBJ:
-		case DUK_OP_MPUTOBJI: {
+		DUK__CASE(DUK_OP_MPUTOBJ)
+		DUK__CASE(DUK_OP_MPUTOBJI) {
 			duk_idx_t obj_idx;
 			duk_uint_fast_t idx, idx_end;
 			duk_small_uint_fast_t count;
@@ -4934,17 +5465,17 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 				                           DUK_DEFPROP_SET_CONFIGURABLE);
 				idx += 2;
 			} while (idx < idx_end);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_INITSET:
-		case DUK_OP_INITGET: {
+		DUK__CASE(DUK_OP_INITSET)
+		DUK__CASE(DUK_OP_INITGET) {
 			duk__handle_op_initset_initget(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_MPUTARR:
-		case DUK_OP_MPUTARRI: {
+		DUK__CASE(DUK_OP_MPUTARR)
+		DUK__CASE(DUK_OP_MPUTARRI) {
 			duk_idx_t obj_idx;
 			duk_uint_fast_t idx, idx_end;
 			duk_small_uint_fast_t count;
@@ -5012,10 +5543,10 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			 * 'arr_idx' type.
 			 */
 			duk_set_length(thr, obj_idx, (duk_size_t) (duk_uarridx_t) arr_idx);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_SETALEN: {
+		DUK__CASE(DUK_OP_SETALEN) {
 			duk_tval *tv1;
 			duk_hobject *h;
 			duk_uint32_t len;
@@ -5034,26 +5565,26 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 			len = (duk_uint32_t) DUK_TVAL_GET_NUMBER(tv1);
 #endif
 			((duk_harray *) h)->length = len;
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_INITENUM: {
+		DUK__CASE(DUK_OP_INITENUM) {
 			duk__handle_op_initenum(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_NEXTENUM: {
+		DUK__CASE(DUK_OP_NEXTENUM) {
 			curr_pc += duk__handle_op_nextenum(thr, ins);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_INVLHS: {
+		DUK__CASE(DUK_OP_INVLHS) {
 			DUK_ERROR_REFERENCE(thr, DUK_STR_INVALID_LVALUE);
 			DUK_WO_NORETURN(return;);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_DEBUGGER: {
+		DUK__CASE(DUK_OP_DEBUGGER) {
 			/* Opcode only emitted by compiler when debugger
 			 * support is enabled.  Ignore it silently without
 			 * debugger support, in case it has been loaded
@@ -5072,24 +5603,24 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 #else
 			DUK_D(DUK_DPRINT("DEBUGGER statement ignored, no debugger support"));
 #endif
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_NOP: {
+		DUK__CASE(DUK_OP_NOP) {
 			/* Nop, ignored, but ABC fields may carry a value e.g.
 			 * for indirect opcode handling.
 			 */
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
-		case DUK_OP_INVALID: {
+		DUK__CASE(DUK_OP_INVALID) {
 			DUK_ERROR_FMT1(thr, DUK_ERR_ERROR, "INVALID opcode (%ld)", (long) DUK_DEC_ABC(ins));
 			DUK_WO_NORETURN(return;);
-			break;
+			DUK__DISPATCH_NEXT();
 		}
 
 #if defined(DUK_USE_ES6)
-		case DUK_OP_NEWTARGET: {
+		DUK__CASE(DUK_OP_NEWTARGET) {
 			duk_push_new_target(thr);
 			DUK__REPLACE_TOP_BC_BREAK();
 		}
@@ -5097,65 +5628,63 @@ DUK_LOCAL DUK_NOINLINE DUK_HOT void duk__js_execute_bytecode_inner(duk_hthread *
 
 #if !defined(DUK_USE_EXEC_PREFER_SIZE)
 #if !defined(DUK_USE_ES7_EXP_OPERATOR)
-		case DUK_OP_EXP_RR:
-		case DUK_OP_EXP_CR:
-		case DUK_OP_EXP_RC:
-		case DUK_OP_EXP_CC:
+		DUK__CASE(DUK_OP_EXP_RR)
+		DUK__CASE(DUK_OP_EXP_CR)
+		DUK__CASE(DUK_OP_EXP_RC)
+		DUK__CASE(DUK_OP_EXP_CC)
 #endif
 #if !defined(DUK_USE_ES6)
-		case DUK_OP_NEWTARGET:
+		DUK__CASE(DUK_OP_NEWTARGET)
 #endif
 #if !defined(DUK_USE_VERBOSE_ERRORS)
-		case DUK_OP_GETPROPC_RR:
-		case DUK_OP_GETPROPC_CR:
-		case DUK_OP_GETPROPC_RC:
-		case DUK_OP_GETPROPC_CC:
+		DUK__CASE(DUK_OP_GETPROPC_RR)
+		DUK__CASE(DUK_OP_GETPROPC_CR)
+		DUK__CASE(DUK_OP_GETPROPC_RC)
+		DUK__CASE(DUK_OP_GETPROPC_CC)
 #endif
-		case DUK_OP_UNUSED207:
-		case DUK_OP_UNUSED212:
-		case DUK_OP_UNUSED213:
-		case DUK_OP_UNUSED214:
-		case DUK_OP_UNUSED215:
-		case DUK_OP_UNUSED216:
-		case DUK_OP_UNUSED217:
-		case DUK_OP_UNUSED218:
-		case DUK_OP_UNUSED219:
-		case DUK_OP_UNUSED220:
-		case DUK_OP_UNUSED221:
-		case DUK_OP_UNUSED222:
-		case DUK_OP_UNUSED223:
-		case DUK_OP_UNUSED224:
-		case DUK_OP_UNUSED225:
-		case DUK_OP_UNUSED226:
-		case DUK_OP_UNUSED227:
-		case DUK_OP_UNUSED228:
-		case DUK_OP_UNUSED229:
-		case DUK_OP_UNUSED230:
-		case DUK_OP_UNUSED231:
-		case DUK_OP_UNUSED232:
-		case DUK_OP_UNUSED233:
-		case DUK_OP_UNUSED234:
-		case DUK_OP_UNUSED235:
-		case DUK_OP_UNUSED236:
-		case DUK_OP_UNUSED237:
-		case DUK_OP_UNUSED238:
-		case DUK_OP_UNUSED239:
-		case DUK_OP_UNUSED240:
-		case DUK_OP_UNUSED241:
-		case DUK_OP_UNUSED242:
-		case DUK_OP_UNUSED243:
-		case DUK_OP_UNUSED244:
-		case DUK_OP_UNUSED245:
-		case DUK_OP_UNUSED246:
-		case DUK_OP_UNUSED247:
-		case DUK_OP_UNUSED248:
-		case DUK_OP_UNUSED249:
-		case DUK_OP_UNUSED250:
-		case DUK_OP_UNUSED251:
-		case DUK_OP_UNUSED252:
-		case DUK_OP_UNUSED253:
-		case DUK_OP_UNUSED254:
-		case DUK_OP_UNUSED255:
+		DUK__CASE(DUK_OP_DELPROP_CR_UNUSED)
+		DUK__CASE(DUK_OP_DELPROP_CC_UNUSED)
+		DUK__CASE(DUK_OP_UNUSED207)
+		DUK__CASE(DUK_OP_UNUSED216)
+		DUK__CASE(DUK_OP_UNUSED217)
+		DUK__CASE(DUK_OP_UNUSED218)
+		DUK__CASE(DUK_OP_UNUSED219)
+		DUK__CASE(DUK_OP_UNUSED220)
+		DUK__CASE(DUK_OP_UNUSED221)
+		DUK__CASE(DUK_OP_UNUSED222)
+		DUK__CASE(DUK_OP_UNUSED223)
+		DUK__CASE(DUK_OP_UNUSED224)
+		DUK__CASE(DUK_OP_UNUSED225)
+		DUK__CASE(DUK_OP_UNUSED226)
+		DUK__CASE(DUK_OP_UNUSED227)
+		DUK__CASE(DUK_OP_UNUSED228)
+		DUK__CASE(DUK_OP_UNUSED229)
+		DUK__CASE(DUK_OP_UNUSED230)
+		DUK__CASE(DUK_OP_UNUSED231)
+		DUK__CASE(DUK_OP_UNUSED232)
+		DUK__CASE(DUK_OP_UNUSED233)
+		DUK__CASE(DUK_OP_UNUSED234)
+		DUK__CASE(DUK_OP_UNUSED235)
+		DUK__CASE(DUK_OP_UNUSED236)
+		DUK__CASE(DUK_OP_UNUSED237)
+		DUK__CASE(DUK_OP_UNUSED238)
+		DUK__CASE(DUK_OP_UNUSED239)
+		DUK__CASE(DUK_OP_UNUSED240)
+		DUK__CASE(DUK_OP_UNUSED241)
+		DUK__CASE(DUK_OP_UNUSED242)
+		DUK__CASE(DUK_OP_UNUSED243)
+		DUK__CASE(DUK_OP_UNUSED244)
+		DUK__CASE(DUK_OP_UNUSED245)
+		DUK__CASE(DUK_OP_UNUSED246)
+		DUK__CASE(DUK_OP_UNUSED247)
+		DUK__CASE(DUK_OP_UNUSED248)
+		DUK__CASE(DUK_OP_UNUSED249)
+		DUK__CASE(DUK_OP_UNUSED250)
+		DUK__CASE(DUK_OP_UNUSED251)
+		DUK__CASE(DUK_OP_UNUSED252)
+		DUK__CASE(DUK_OP_UNUSED253)
+		DUK__CASE(DUK_OP_UNUSED254)
+		DUK__CASE(DUK_OP_UNUSED255)
 		/* Force all case clauses to map to an actual handler
 		 * so that the compiler can emit a jump without a bounds
 		 * check: the switch argument is a duk_uint8_t so that
@@ -575,7 +575,29 @@ DUK_INTERNAL duk_bool_t duk_js_equals_helper(duk_hthread *thr, duk_tval *tv_x, d
 		case DUK_TAG_POINTER: {
 			return DUK_TVAL_GET_POINTER(tv_x) == DUK_TVAL_GET_POINTER(tv_y);
 		}
+#if defined(DUK_USE_HSTRING_UNINTERNED)
+		case DUK_TAG_STRING: {
+			duk_hstring *h_x = DUK_TVAL_GET_STRING(tv_x);
+			duk_hstring *h_y = DUK_TVAL_GET_STRING(tv_y);
+
+			/* Interned strings are equal only if they're the same
+			 * string.  An uninterned string may have an equal copy,
+			 * so compare its contents.
+			 */
+			if (h_x == h_y) {
+				return 1;
+			}
+			if (DUK_UNLIKELY(DUK_HSTRING_HAS_UNINTERNED(h_x) || DUK_HSTRING_HAS_UNINTERNED(h_y))) {
+				return (DUK_HSTRING_GET_BYTELEN(h_x) == DUK_HSTRING_GET_BYTELEN(h_y) &&
+				        duk_memcmp((const void *) DUK_HSTRING_GET_DATA(h_x),
+				                   (const void *) DUK_HSTRING_GET_DATA(h_y),
+				                   (size_t) DUK_HSTRING_GET_BYTELEN(h_x)) == 0);
+			}
+			return 0;
+		}
+#else
 		case DUK_TAG_STRING:
+#endif
 		case DUK_TAG_OBJECT: {
 			/* Heap pointer comparison suffices for strings and objects.
 			 * Symbols compare equal if they have the same internal
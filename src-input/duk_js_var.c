@@ -155,6 +155,9 @@ void duk_js_push_closure(duk_hthread *thr,
 	DUK_HCOMPFUNC_SET_DATA(thr->heap, fun_clos, DUK_HCOMPFUNC_GET_DATA(thr->heap, fun_temp));
 	DUK_HCOMPFUNC_SET_FUNCS(thr->heap, fun_clos, DUK_HCOMPFUNC_GET_FUNCS(thr->heap, fun_temp));
 	DUK_HCOMPFUNC_SET_BYTECODE(thr->heap, fun_clos, DUK_HCOMPFUNC_GET_BYTECODE(thr->heap, fun_temp));
+#if defined(DUK_USE_EXEC_INLINE_CACHE)
+	DUK_HCOMPFUNC_SET_ICACHE(thr->heap, fun_clos, DUK_HCOMPFUNC_GET_ICACHE(thr->heap, fun_temp));
+#endif
 
 	/* Note: all references inside 'data' need to get their refcounts
 	 * upped too.  This is the case because refcounts are decreased
@@ -190,8 +193,15 @@ void duk_js_push_closure(duk_hthread *thr,
 	 * separately if necessary.
 	 */
 
-	/* DUK_HEAPHDR_SET_FLAGS() masks changes to non-duk_heaphdr flags only. */
-	DUK_HEAPHDR_SET_FLAGS((duk_heaphdr *) fun_clos, DUK_HEAPHDR_GET_FLAGS_RAW((duk_heaphdr *) fun_temp));
+	/* DUK_HEAPHDR_SET_FLAGS() masks changes to non-duk_heaphdr flags only.
+	 * Mark-and-sweep flags must not be copied: with incremental
+	 * mark-and-sweep the template may already be marked when the
+	 * closure is created.
+	 */
+	DUK_HEAPHDR_SET_FLAGS((duk_heaphdr *) fun_clos,
+	                      DUK_HEAPHDR_GET_FLAGS_RAW((duk_heaphdr *) fun_temp) &
+	                      ~(DUK_HEAPHDR_FLAG_REACHABLE | DUK_HEAPHDR_FLAG_TEMPROOT |
+	                        DUK_HEAPHDR_FLAG_FINALIZABLE | DUK_HEAPHDR_FLAG_FINALIZED));
 	DUK_DD(DUK_DDPRINT("fun_temp heaphdr flags: 0x%08lx, fun_clos heaphdr flags: 0x%08lx",
 	                   (unsigned long) DUK_HEAPHDR_GET_FLAGS_RAW((duk_heaphdr *) fun_temp),
 	                   (unsigned long) DUK_HEAPHDR_GET_FLAGS_RAW((duk_heaphdr *) fun_clos)));
@@ -1693,7 +1703,10 @@ duk_bool_t duk__declvar_helper(duk_hthread *thr,
 			tv = DUK_HOBJECT_E_GET_VALUE_TVAL_PTR(thr->heap, holder, e_idx);
 			DUK_TVAL_SET_TVAL(tv, val);
 			DUK_TVAL_INCREF(thr, tv);
-			DUK_HOBJECT_E_SET_FLAGS(thr->heap, holder, e_idx, prop_flags);
+			if (DUK_HOBJECT_E_GET_FLAGS(thr->heap, holder, e_idx) != prop_flags) {
+				DUK_HOBJECT_UNSHAPE(thr, holder);  /* e_idx is preserved */
+				DUK_HOBJECT_E_SET_FLAGS(thr->heap, holder, e_idx, prop_flags);
+			}
 
 			DUK_DDD(DUK_DDDPRINT("updated global binding, final result: "
 			                     "value -> %!T, prop_flags=0x%08lx",
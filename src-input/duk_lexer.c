@@ -566,7 +566,7 @@ DUK_LOCAL duk_hstring *duk__internbuffer(duk_lexer_ctx *lex_ctx, duk_idx_t valst
 
 	DUK_BW_PUSH_AS_STRING(lex_ctx->thr, &lex_ctx->bw);
 	duk_replace(lex_ctx->thr, valstack_idx);
-	return duk_known_hstring(lex_ctx->thr, valstack_idx);
+	return duk_to_interned_hstring(lex_ctx->thr, valstack_idx);
 }
 
 /*
@@ -2,12 +2,35 @@
  *  Reference counting helper macros.  The macros take a thread argument
  *  and must thus always be executed in a specific thread context.  The
  *  thread argument is not really needed anymore: DECREF can operate with
- *  a heap pointer only, and INCREF needs neither.
+ *  a heap pointer only, and INCREF only needs the heap for the incremental
+ *  mark-and-sweep write barrier.
  */
 
 #if !defined(DUK_REFCOUNT_H_INCLUDED)
 #define DUK_REFCOUNT_H_INCLUDED
 
+/* Write barrier for incremental mark-and-sweep: a heap object gaining a new
+ * reference while marking is in progress is marked (grayed) so that it can't
+ * be hidden from the marker behind an already processed object.  Applied by
+ * all INCREF variants, and explicitly by code which moves values between
+ * value stacks and objects without refcount updates.
+ */
+#if defined(DUK_USE_MARK_AND_SWEEP_INCREMENTAL)
+#define DUK_HEAPHDR_MARK_BARRIER(thr,h) do { \
+		if (DUK_UNLIKELY((thr)->heap->ms_incr_phase == DUK_HEAP_MS_INCR_MARK)) { \
+			duk_heap_mark_barrier((thr)->heap, (duk_heaphdr *) (h)); \
+		} \
+	} while (0)
+#define DUK_TVALS_MARK_BARRIER(thr,tv,count) do { \
+		if (DUK_UNLIKELY((thr)->heap->ms_incr_phase == DUK_HEAP_MS_INCR_MARK)) { \
+			duk_heap_mark_barrier_tvals((thr)->heap, (tv), (duk_size_t) (count)); \
+		} \
+	} while (0)
+#else
+#define DUK_HEAPHDR_MARK_BARRIER(thr,h) do {} while (0)
+#define DUK_TVALS_MARK_BARRIER(thr,tv,count) do {} while (0)
+#endif
+
 #if defined(DUK_USE_REFERENCE_COUNTING)
 
 #if defined(DUK_USE_ROM_OBJECTS)
@@ -38,6 +61,7 @@
 			DUK_ASSERT(DUK_HEAPHDR_HTYPE_VALID(duk__h)); \
 			DUK_HEAPHDR_PREINC_REFCOUNT(duk__h); \
 			DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT(duk__h) != 0);  /* No wrapping. */ \
+			DUK_HEAPHDR_MARK_BARRIER((thr), duk__h); \
 		} \
 	} while (0)
 #define DUK_TVAL_DECREF_FAST(thr,tv) do { \
@@ -73,6 +97,7 @@
 		if (DUK_HEAPHDR_NEEDS_REFCOUNT_UPDATE(duk__h)) { \
 			DUK_HEAPHDR_PREINC_REFCOUNT(duk__h); \
 			DUK_ASSERT(DUK_HEAPHDR_GET_REFCOUNT(duk__h) != 0);  /* No wrapping. */ \
+			DUK_HEAPHDR_MARK_BARRIER((thr), duk__h); \
 		} \
 	} while (0)
 #define DUK_HEAPHDR_DECREF_FAST_RAW(thr,h,rzcall,rzcast) do { \
@@ -94,19 +119,19 @@
 /* Slow variants, call to a helper to reduce code size.
  * Can be used explicitly when size is always more important than speed.
  */
-#define DUK_TVAL_INCREF_SLOW(thr,tv)         do { duk_tval_incref((tv)); } while (0)
+#define DUK_TVAL_INCREF_SLOW(thr,tv)         do { duk_tval_incref((thr), (tv)); } while (0)
 #define DUK_TVAL_DECREF_SLOW(thr,tv)         do { duk_tval_decref((thr), (tv)); } while (0)
 #define DUK_TVAL_DECREF_NORZ_SLOW(thr,tv)    do { duk_tval_decref_norz((thr), (tv)); } while (0)
-#define DUK_HEAPHDR_INCREF_SLOW(thr,h)       do { duk_heaphdr_incref((duk_heaphdr *) (h)); } while (0)
+#define DUK_HEAPHDR_INCREF_SLOW(thr,h)       do { duk_heaphdr_incref((thr), (duk_heaphdr *) (h)); } while (0)
 #define DUK_HEAPHDR_DECREF_SLOW(thr,h)       do { duk_heaphdr_decref((thr), (duk_heaphdr *) (h)); } while (0)
 #define DUK_HEAPHDR_DECREF_NORZ_SLOW(thr,h)  do { duk_heaphdr_decref_norz((thr), (duk_heaphdr *) (h)); } while (0)
-#define DUK_HSTRING_INCREF_SLOW(thr,h)       do { duk_heaphdr_incref((duk_heaphdr *) (h)); } while (0)
+#define DUK_HSTRING_INCREF_SLOW(thr,h)       do { duk_heaphdr_incref((thr), (duk_heaphdr *) (h)); } while (0)
 #define DUK_HSTRING_DECREF_SLOW(thr,h)       do { duk_heaphdr_decref((thr), (duk_heaphdr *) (h)); } while (0)
 #define DUK_HSTRING_DECREF_NORZ_SLOW(thr,h)  do { duk_heaphdr_decref_norz((thr), (duk_heaphdr *) (h)); } while (0)
-#define DUK_HBUFFER_INCREF_SLOW(thr,h)       do { duk_heaphdr_incref((duk_heaphdr *) (h)); } while (0)
+#define DUK_HBUFFER_INCREF_SLOW(thr,h)       do { duk_heaphdr_incref((thr), (duk_heaphdr *) (h)); } while (0)
 #define DUK_HBUFFER_DECREF_SLOW(thr,h)       do { duk_heaphdr_decref((thr), (duk_heaphdr *) (h)); } while (0)
 #define DUK_HBUFFER_DECREF_NORZ_SLOW(thr,h)  do { duk_heaphdr_decref_norz((thr), (duk_heaphdr *) (h)); } while (0)
-#define DUK_HOBJECT_INCREF_SLOW(thr,h)       do { duk_heaphdr_incref((duk_heaphdr *) (h)); } while (0)
+#define DUK_HOBJECT_INCREF_SLOW(thr,h)       do { duk_heaphdr_incref((thr), (duk_heaphdr *) (h)); } while (0)
 #define DUK_HOBJECT_DECREF_SLOW(thr,h)       do { duk_heaphdr_decref((thr), (duk_heaphdr *) (h)); } while (0)
 #define DUK_HOBJECT_DECREF_NORZ_SLOW(thr,h)  do { duk_heaphdr_decref_norz((thr), (duk_heaphdr *) (h)); } while (0)
 
@@ -711,10 +736,10 @@ DUK_INTERNAL_DECL void duk_hbuffer_refzero(duk_hthread *thr, duk_hbuffer *h);  /
 DUK_INTERNAL_DECL void duk_hobject_refzero(duk_hthread *thr, duk_hobject *h);
 DUK_INTERNAL_DECL void duk_hobject_refzero_norz(duk_hthread *thr, duk_hobject *h);
 #else
-DUK_INTERNAL_DECL void duk_tval_incref(duk_tval *tv);
+DUK_INTERNAL_DECL void duk_tval_incref(duk_hthread *thr, duk_tval *tv);
 DUK_INTERNAL_DECL void duk_tval_decref(duk_hthread *thr, duk_tval *tv);
 DUK_INTERNAL_DECL void duk_tval_decref_norz(duk_hthread *thr, duk_tval *tv);
-DUK_INTERNAL_DECL void duk_heaphdr_incref(duk_heaphdr *h);
+DUK_INTERNAL_DECL void duk_heaphdr_incref(duk_hthread *thr, duk_heaphdr *h);
 DUK_INTERNAL_DECL void duk_heaphdr_decref(duk_hthread *thr, duk_heaphdr *h);
 DUK_INTERNAL_DECL void duk_heaphdr_decref_norz(duk_hthread *thr, duk_heaphdr *h);
 #endif
@@ -40,6 +40,24 @@
 #define DUK_RE_FLAG_IGNORE_CASE            (1U << 1)
 #define DUK_RE_FLAG_MULTILINE              (1U << 2)
 
+/* start hints (DUK_USE_REGEXP_START_HINTS) */
+#define DUK_RE_HINT_ANCHORED               (1U << 0)  /* can only match at input start */
+#define DUK_RE_HINT_FIRSTSET               (1U << 1)  /* bitmap of possible ASCII first bytes follows */
+#define DUK_RE_HINT_PREFIX                 (1U << 2)  /* literal ASCII prefix follows */
+#define DUK_RE_HINT_FIRSTSET_BYTES         16         /* bitmap size, one bit per ASCII byte */
+#define DUK_RE_HINT_PREFIX_MAXLEN          32
+
+/* NFA executor limits (DUK_USE_REGEXP_NFA); patterns exceeding these use
+ * the backtracking executor.
+ */
+#define DUK_RE_NFA_MAX_BYTECODE            65536L  /* bytecode size incl. expanded quantifiers */
+#define DUK_RE_NFA_MAX_SLOTS               65536L  /* thread count * (nsaved + 2) */
+
+/* Backtracking steps allowed per input byte and NFA thread before a match
+ * attempt is finished with the NFA executor (DUK_USE_REGEXP_NFA).
+ */
+#define DUK_RE_NFA_BACKTRACK_STEPS         4L
+
 struct duk_re_matcher_ctx {
 	duk_hthread *thr;
 
@@ -54,6 +72,16 @@ struct duk_re_matcher_ctx {
 	duk_uint32_t recursion_limit;
 	duk_uint32_t steps_count;
 	duk_uint32_t steps_limit;
+#if defined(DUK_USE_REGEXP_START_HINTS)
+	duk_uint32_t hints;
+	const duk_uint8_t *hint_first_set;
+	const duk_uint8_t *hint_prefix;
+	duk_size_t hint_prefix_len;
+	duk_bool_t input_ascii;
+#endif
+#if defined(DUK_USE_REGEXP_NFA)
+	duk_bool_t nfa_fallback;  /* steps and recursion limits end backtracking instead of throwing */
+#endif
 };
 
 struct duk_re_compiler_ctx {
@@ -68,6 +96,9 @@ struct duk_re_compiler_ctx {
 	duk_uint32_t recursion_depth;
 	duk_uint32_t recursion_limit;
 	duk_uint32_t nranges;  /* internal temporary value, used for char classes */
+#if defined(DUK_USE_REGEXP_NFA)
+	duk_bool_t nfa_unsupported;  /* bytecode can't be executed by the NFA executor */
+#endif
 };
 
 /*
@@ -597,6 +597,8 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 			break;
 		}
 		case DUK_RETOK_QUANTIFIER: {
+			duk_bool_t simple;
+
 			if (atom_start_offset < 0) {
 				DUK_ERROR_SYNTAX(re_ctx->thr, DUK_STR_INVALID_QUANTIFIER_NO_ATOM);
 				DUK_WO_NORETURN(return;);
@@ -605,7 +607,31 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 				DUK_ERROR_SYNTAX(re_ctx->thr, DUK_STR_INVALID_QUANTIFIER_VALUES);
 				DUK_WO_NORETURN(return;);
 			}
-			if (atom_char_length >= 0) {
+			simple = (atom_char_length >= 0);
+#if defined(DUK_USE_REGEXP_NFA)
+			if (simple && atom_char_length > 0 && !re_ctx->nfa_unsupported &&
+			    (re_ctx->curr_token.qmin > 1 ||
+			     (re_ctx->curr_token.qmax > 1 && re_ctx->curr_token.qmax != DUK_RE_QUANTIFIER_INFINITE))) {
+				/* The NFA matcher supports simple quantifiers without
+				 * counters only, i.e. '*', '+', '?' and their minimal
+				 * variants.  Other counts are expanded like complex
+				 * atoms if the result stays reasonably small.  The
+				 * result is also valid for the backtracking matcher.
+				 */
+				duk_uint32_t atom_copies;
+
+				atom_copies = (re_ctx->curr_token.qmax == DUK_RE_QUANTIFIER_INFINITE) ?
+				              re_ctx->curr_token.qmin + 1 : re_ctx->curr_token.qmax;
+				if (atom_copies <= DUK_RE_MAX_ATOM_COPIES &&
+				    DUK__RE_BUFLEN(re_ctx) + (duk_size_t) atom_copies * (DUK__RE_BUFLEN(re_ctx) - (duk_size_t) atom_start_offset + 6U) <=
+				    (duk_size_t) DUK_RE_NFA_MAX_BYTECODE) {
+					simple = 0;
+				} else {
+					re_ctx->nfa_unsupported = 1;
+				}
+			}
+#endif
+			if (simple) {
 				/*
 				 *  Simple atom
 				 *
@@ -785,6 +811,9 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 			duk_uint32_t opcode = (re_ctx->curr_token.t == DUK_RETOK_ASSERT_START_POS_LOOKAHEAD) ?
 			                      DUK_REOP_LOOKPOS : DUK_REOP_LOOKNEG;
 
+#if defined(DUK_USE_REGEXP_NFA)
+			re_ctx->nfa_unsupported = 1;
+#endif
 			offset = (duk_uint32_t) DUK__RE_BUFLEN(re_ctx);
 			duk__parse_disjunction(re_ctx, 0, &tmp_disj);
 			duk__append_reop(re_ctx, DUK_REOP_MATCH);
@@ -862,6 +891,9 @@ DUK_LOCAL void duk__parse_disjunction(duk_re_compiler_ctx *re_ctx, duk_bool_t ex
 			if (backref > re_ctx->highest_backref) {
 				re_ctx->highest_backref = backref;
 			}
+#if defined(DUK_USE_REGEXP_NFA)
+			re_ctx->nfa_unsupported = 1;
+#endif
 			new_atom_char_length = -1;   /* mark as complex */
 			new_atom_start_offset = (duk_int32_t) DUK__RE_BUFLEN(re_ctx);
 			duk__append_reop(re_ctx, DUK_REOP_BACKREFERENCE);
@@ -1113,6 +1145,396 @@ DUK_LOCAL void duk__create_escaped_source(duk_hthread *thr, int idx_pattern) {
 	/* [ ... escaped_source ] */
 }
 
+/*
+ *  Start hints.
+ *
+ *  Unanchored matching tries the backtracking matcher at every input offset,
+ *  and most attempts fail right away when scanning through long inputs.  The
+ *  compiled body bytecode is analyzed here to find out where a match can
+ *  start, and the result is stored into the bytecode header for the executor
+ *  to skip offsets which can't start a match:
+ *
+ *    - DUK_RE_HINT_ANCHORED: the body starts with '^' without the multiline
+ *      flag so only the start of input can match.
+ *
+ *    - DUK_RE_HINT_FIRSTSET: every match consumes at least one character
+ *      and the set of possible ASCII first characters is known.  Non-ASCII
+ *      characters are always considered possible; this keeps the analysis
+ *      simple and also deals with non-shortest encodings in the input.
+ *
+ *    - DUK_RE_HINT_PREFIX: every match begins with a known ASCII literal
+ *      (only for case sensitive matching).
+ *
+ *  The analysis is conservative: if something is not understood, no hint is
+ *  emitted and the executor behaves as before.
+ */
+
+#if defined(DUK_USE_REGEXP_START_HINTS)
+#define DUK__RE_HINT_BUDGET     1000  /* maximum number of opcodes analyzed */
+#define DUK__RE_HINT_MAX_DEPTH  16    /* maximum branch recursion depth */
+
+typedef struct {
+	duk_re_compiler_ctx *re_ctx;
+	const duk_uint8_t *bc;
+	const duk_uint8_t *bc_end;
+	duk_int_t budget;
+	duk_uint8_t canon[0x80];  /* ASCII input char -> char compared against bytecode */
+	duk_uint8_t set[DUK_RE_HINT_FIRSTSET_BYTES];
+} duk__re_hint_ctx;
+
+DUK_LOCAL duk_uint32_t duk__re_hint_get_u32(duk__re_hint_ctx *hc, const duk_uint8_t **pc) {
+	return (duk_uint32_t) duk_unicode_decode_xutf8_checked(hc->re_ctx->thr, pc, hc->bc, hc->bc_end);
+}
+
+DUK_LOCAL duk_int32_t duk__re_hint_get_i32(duk__re_hint_ctx *hc, const duk_uint8_t **pc) {
+	duk_uint32_t t;
+
+	t = duk__re_hint_get_u32(hc, pc);
+	if (t & 1) {
+		return -((duk_int32_t) (t >> 1));
+	} else {
+		return (duk_int32_t) (t >> 1);
+	}
+}
+
+/* Add the ASCII characters matched by a single character atom to the first
+ * character set.  'pc' points to the operands of 'op'.
+ */
+DUK_LOCAL void duk__re_hint_add_atom(duk__re_hint_ctx *hc, duk_small_uint_t op, const duk_uint8_t *pc) {
+	duk_uint8_t tmp[DUK_RE_HINT_FIRSTSET_BYTES];
+	duk_uint32_t n;
+	duk_uint32_t r1, r2;
+	duk_small_uint_t i;
+
+	duk_memzero((void *) tmp, sizeof(tmp));
+
+	switch (op) {
+	case DUK_REOP_CHAR: {
+		r1 = duk__re_hint_get_u32(hc, &pc);
+		for (i = 0; i < 0x80U; i++) {
+			if ((duk_uint32_t) hc->canon[i] == r1) {
+				tmp[i >> 3] |= (duk_uint8_t) (1U << (i & 0x07U));
+			}
+		}
+		break;
+	}
+	case DUK_REOP_PERIOD: {
+		duk_memset((void *) tmp, 0xff, sizeof(tmp));
+		tmp[0x0a >> 3] &= (duk_uint8_t) ~(1U << (0x0a & 0x07U));
+		tmp[0x0d >> 3] &= (duk_uint8_t) ~(1U << (0x0d & 0x07U));
+		break;
+	}
+	default: {
+		DUK_ASSERT(op == DUK_REOP_RANGES || op == DUK_REOP_INVRANGES);
+		n = duk__re_hint_get_u32(hc, &pc);
+		while (n-- > 0) {
+			r1 = duk__re_hint_get_u32(hc, &pc);
+			r2 = duk__re_hint_get_u32(hc, &pc);
+			for (i = 0; i < 0x80U; i++) {
+				if ((duk_uint32_t) hc->canon[i] >= r1 && (duk_uint32_t) hc->canon[i] <= r2) {
+					tmp[i >> 3] |= (duk_uint8_t) (1U << (i & 0x07U));
+				}
+			}
+		}
+		if (op == DUK_REOP_INVRANGES) {
+			for (i = 0; i < DUK_RE_HINT_FIRSTSET_BYTES; i++) {
+				tmp[i] = (duk_uint8_t) ~tmp[i];
+			}
+		}
+		break;
+	}
+	}
+
+	for (i = 0; i < DUK_RE_HINT_FIRSTSET_BYTES; i++) {
+		hc->set[i] |= tmp[i];
+	}
+}
+
+/* Add the possible first characters of matches starting at 'pc' to the set.
+ * Returns 1 if every match starting at 'pc' consumes at least one character,
+ * i.e. the set is complete, 0 otherwise.  'pc_cont' is where matching
+ * continues when a simple quantifier atom ends in a MATCH, NULL outside of
+ * such atoms.
+ */
+DUK_LOCAL duk_bool_t duk__re_hint_first(duk__re_hint_ctx *hc, const duk_uint8_t *pc, const duk_uint8_t *pc_cont, duk_small_uint_t depth) {
+	for (;;) {
+		duk_small_uint_t op;
+		duk_int32_t skip;
+		duk_uint32_t qmin;
+		duk_uint32_t qmax;
+
+		if (--hc->budget < 0 || pc < hc->bc || pc >= hc->bc_end) {
+			return 0;
+		}
+		op = *pc++;
+
+		switch (op) {
+		case DUK_REOP_CHAR:
+		case DUK_REOP_PERIOD:
+		case DUK_REOP_RANGES:
+		case DUK_REOP_INVRANGES: {
+			duk__re_hint_add_atom(hc, op, pc);
+			return 1;
+		}
+		case DUK_REOP_MATCH: {
+			if (pc_cont == NULL) {
+				return 0;  /* empty match possible */
+			}
+			pc = pc_cont;
+			pc_cont = NULL;
+			break;
+		}
+		case DUK_REOP_JUMP: {
+			skip = duk__re_hint_get_i32(hc, &pc);
+			pc += skip;
+			break;
+		}
+		case DUK_REOP_SPLIT1:
+		case DUK_REOP_SPLIT2: {
+			skip = duk__re_hint_get_i32(hc, &pc);
+			if (depth >= DUK__RE_HINT_MAX_DEPTH ||
+			    !duk__re_hint_first(hc, pc + skip, pc_cont, depth + 1)) {
+				return 0;
+			}
+			break;
+		}
+		case DUK_REOP_SQMINIMAL:
+		case DUK_REOP_SQGREEDY: {
+			qmin = duk__re_hint_get_u32(hc, &pc);
+			qmax = duk__re_hint_get_u32(hc, &pc);
+			if (op == DUK_REOP_SQGREEDY) {
+				(void) duk__re_hint_get_u32(hc, &pc);  /* atomlen */
+			}
+			skip = duk__re_hint_get_i32(hc, &pc);
+			if (pc_cont != NULL) {
+				return 0;  /* not expected, simple atoms don't nest */
+			}
+			if (qmax == 0) {
+				pc += skip;
+				break;
+			}
+			if (qmin == 0) {
+				if (depth >= DUK__RE_HINT_MAX_DEPTH ||
+				    !duk__re_hint_first(hc, pc + skip, NULL, depth + 1)) {
+					return 0;
+				}
+			}
+			pc_cont = pc + skip;
+			break;
+		}
+		case DUK_REOP_SAVE: {
+			(void) duk__re_hint_get_u32(hc, &pc);
+			break;
+		}
+		case DUK_REOP_WIPERANGE: {
+			(void) duk__re_hint_get_u32(hc, &pc);
+			(void) duk__re_hint_get_u32(hc, &pc);
+			break;
+		}
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
+		case DUK_REOP_ASSERT_WORD_BOUNDARY:
+		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
+			/* Zero width, only restricts matches. */
+			break;
+		}
+		case DUK_REOP_LOOKPOS:
+		case DUK_REOP_LOOKNEG: {
+			/* Zero width, skip the lookahead body. */
+			skip = duk__re_hint_get_i32(hc, &pc);
+			pc += skip;
+			break;
+		}
+		default: {
+			/* Backreferences may match an empty string. */
+			return 0;
+		}
+		}
+	}
+}
+
+/* Analyze the body bytecode in the compile buffer and insert the start hints
+ * to the beginning of the buffer:
+ *
+ *   uint   hints (DUK_RE_HINT_*)
+ *   byte[] first character bitmap (if DUK_RE_HINT_FIRSTSET)
+ *   uint   prefix length (if DUK_RE_HINT_PREFIX)
+ *   byte[] prefix (if DUK_RE_HINT_PREFIX)
+ */
+DUK_LOCAL void duk__regexp_emit_start_hints(duk_re_compiler_ctx *re_ctx) {
+	duk__re_hint_ctx hc;
+	duk_uint8_t buf[1 + DUK_RE_HINT_FIRSTSET_BYTES + 1 + DUK_RE_HINT_PREFIX_MAXLEN];
+	duk_uint8_t prefix[DUK_RE_HINT_PREFIX_MAXLEN];
+	duk_small_uint_t prefix_len = 0;
+	duk_small_uint_t hints = 0;
+	duk_small_uint_t i;
+	duk_uint8_t *q;
+	const duk_uint8_t *pc;
+	duk_uint32_t ch;
+
+	duk_memzero((void *) &hc, sizeof(hc));
+	hc.re_ctx = re_ctx;
+	hc.bc = DUK_BW_GET_BASEPTR(re_ctx->thr, &re_ctx->bw);
+	hc.bc_end = hc.bc + DUK__RE_BUFLEN(re_ctx);
+	hc.budget = DUK__RE_HINT_BUDGET;
+	for (i = 0; i < 0x80U; i++) {
+		hc.canon[i] = (duk_uint8_t) i;
+		if (re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) {
+			/* ASCII canonicalizes to ASCII. */
+			hc.canon[i] = (duk_uint8_t) duk_unicode_re_canonicalize_char(re_ctx->thr, (duk_codepoint_t) i);
+		}
+	}
+
+	/* Body always begins with SAVE 0. */
+	pc = hc.bc;
+	DUK_ASSERT(pc[0] == DUK_REOP_SAVE && pc[1] == 0);
+	pc += 2;
+
+	if (pc[0] == DUK_REOP_ASSERT_START && (re_ctx->re_flags & DUK_RE_FLAG_MULTILINE) == 0) {
+		hints |= DUK_RE_HINT_ANCHORED;
+	} else {
+		if (duk__re_hint_first(&hc, hc.bc, NULL, 0)) {
+			hints |= DUK_RE_HINT_FIRSTSET;
+		}
+
+		/* Leading CHARs are always matched, quantified atoms are
+		 * preceded by their quantifier instruction.
+		 */
+		while ((re_ctx->re_flags & DUK_RE_FLAG_IGNORE_CASE) == 0 &&
+		       prefix_len < DUK_RE_HINT_PREFIX_MAXLEN &&
+		       pc < hc.bc_end && *pc == DUK_REOP_CHAR) {
+			pc++;
+			ch = duk__re_hint_get_u32(&hc, &pc);
+			if (ch >= 0x80U) {
+				break;
+			}
+			prefix[prefix_len++] = (duk_uint8_t) ch;
+		}
+		if (prefix_len > 0) {
+			hints |= DUK_RE_HINT_PREFIX;
+		}
+	}
+
+	DUK_DD(DUK_DDPRINT("regexp start hints: 0x%02lx, prefix length %ld",
+	                   (unsigned long) hints, (long) prefix_len));
+
+	/* All values are 7-bit so they encode as single bytes. */
+	q = buf;
+	*q++ = (duk_uint8_t) hints;
+	if (hints & DUK_RE_HINT_FIRSTSET) {
+		duk_memcpy((void *) q, (const void *) hc.set, DUK_RE_HINT_FIRSTSET_BYTES);
+		q += DUK_RE_HINT_FIRSTSET_BYTES;
+	}
+	if (hints & DUK_RE_HINT_PREFIX) {
+		DUK_ASSERT(prefix_len <= 0x7fU);
+		*q++ = (duk_uint8_t) prefix_len;
+		duk_memcpy((void *) q, (const void *) prefix, (duk_size_t) prefix_len);
+		q += prefix_len;
+	}
+	DUK_BW_INSERT_ENSURE_BYTES(re_ctx->thr, &re_ctx->bw, 0, buf, (duk_size_t) (q - buf));
+}
+#endif  /* DUK_USE_REGEXP_START_HINTS */
+
+/*
+ *  NFA executor support.
+ *
+ *  Bytecode without backreferences and lookaheads, and with simple
+ *  quantifiers limited to counts the NFA executor can handle without
+ *  counters, can also be executed by the non-backtracking NFA executor,
+ *  see duk_regexp_executor.c.  The executor needs one thread slot per
+ *  character matcher and MATCH instruction; the count is stored into the
+ *  bytecode header, zero meaning only the backtracking executor is used.
+ */
+
+#if defined(DUK_USE_REGEXP_NFA)
+DUK_LOCAL duk_uint32_t duk__regexp_nfa_count_threads(duk_re_compiler_ctx *re_ctx) {
+	const duk_uint8_t *bc;
+	const duk_uint8_t *bc_end;
+	const duk_uint8_t *pc;
+	duk_uint32_t nthreads = 0;
+	duk_uint32_t n;
+	duk_uint32_t qmin, qmax;
+	duk_small_uint_t op;
+
+	if (re_ctx->nfa_unsupported || DUK__RE_BUFLEN(re_ctx) > (duk_size_t) DUK_RE_NFA_MAX_BYTECODE) {
+		return 0;
+	}
+
+	bc = DUK_BW_GET_BASEPTR(re_ctx->thr, &re_ctx->bw);
+	bc_end = bc + DUK__RE_BUFLEN(re_ctx);
+	pc = bc;
+	while (pc < bc_end) {
+		op = *pc++;
+		switch (op) {
+		case DUK_REOP_MATCH:
+		case DUK_REOP_PERIOD: {
+			nthreads++;
+			break;
+		}
+		case DUK_REOP_CHAR: {
+			(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			nthreads++;
+			break;
+		}
+		case DUK_REOP_RANGES:
+		case DUK_REOP_INVRANGES: {
+			n = (duk_uint32_t) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			while (n-- > 0) {
+				(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+				(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			}
+			nthreads++;
+			break;
+		}
+		case DUK_REOP_JUMP:
+		case DUK_REOP_SPLIT1:
+		case DUK_REOP_SPLIT2:
+		case DUK_REOP_SAVE: {
+			(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			break;
+		}
+		case DUK_REOP_WIPERANGE: {
+			(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			break;
+		}
+		case DUK_REOP_SQMINIMAL:
+		case DUK_REOP_SQGREEDY: {
+			qmin = (duk_uint32_t) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			qmax = (duk_uint32_t) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			if (op == DUK_REOP_SQGREEDY) {
+				(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			}
+			(void) duk_unicode_decode_xutf8_checked(re_ctx->thr, &pc, bc, bc_end);
+			DUK_ASSERT(qmin <= 1 && (qmax <= 1 || qmax == DUK_RE_QUANTIFIER_INFINITE));
+			DUK_UNREF(qmin);
+			DUK_UNREF(qmax);
+			break;
+		}
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
+		case DUK_REOP_ASSERT_WORD_BOUNDARY:
+		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
+			break;
+		}
+		default: {
+			/* Lookaheads and backreferences are flagged as
+			 * unsupported while parsing.
+			 */
+			DUK_D(DUK_DPRINT("unexpected opcode in nfa bytecode: %ld", (long) op));
+			DUK_ASSERT(0);
+			return 0;
+		}
+		}
+	}
+
+	if ((duk_size_t) nthreads * ((re_ctx->captures + 1) * 2 + 2) > (duk_size_t) DUK_RE_NFA_MAX_SLOTS) {
+		return 0;
+	}
+	return nthreads;
+}
+#endif  /* DUK_USE_REGEXP_NFA */
+
 /*
  *  Exposed regexp compilation primitive.
  *
@@ -1134,6 +1556,9 @@ DUK_INTERNAL void duk_regexp_compile(duk_hthread *thr) {
 	duk_hstring *h_pattern;
 	duk_hstring *h_flags;
 	duk__re_disjunction_info ign_disj;
+#if defined(DUK_USE_REGEXP_NFA)
+	duk_uint32_t nfa_threads;
+#endif
 
 	DUK_ASSERT(thr != NULL);
 
@@ -1212,10 +1637,19 @@ DUK_INTERNAL void duk_regexp_compile(duk_hthread *thr) {
 	}
 
 	/*
-	 *  Emit compiled regexp header: flags, ncaptures
-	 *  (insertion order inverted on purpose)
+	 *  Emit compiled regexp header: flags, ncaptures, nfa thread count,
+	 *  start hints (insertion order inverted on purpose)
 	 */
 
+#if defined(DUK_USE_REGEXP_NFA)
+	nfa_threads = duk__regexp_nfa_count_threads(&re_ctx);  /* before anything is inserted */
+#endif
+#if defined(DUK_USE_REGEXP_START_HINTS)
+	duk__regexp_emit_start_hints(&re_ctx);
+#endif
+#if defined(DUK_USE_REGEXP_NFA)
+	duk__insert_u32(&re_ctx, 0, nfa_threads);
+#endif
 	duk__insert_u32(&re_ctx, 0, (re_ctx.captures + 1) * 2);
 	duk__insert_u32(&re_ctx, 0, re_ctx.re_flags);
 
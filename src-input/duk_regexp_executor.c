@@ -134,6 +134,67 @@ DUK_LOCAL duk_codepoint_t duk__inp_get_prev_cp(duk_re_matcher_ctx *re_ctx, const
 	return duk__inp_get_cp(re_ctx, &sp);
 }
 
+/* Check a zero width assertion (DUK_REOP_ASSERT_xxx) at 'sp'. */
+DUK_LOCAL duk_bool_t duk__match_assertion(duk_re_matcher_ctx *re_ctx, duk_small_int_t op, const duk_uint8_t *sp) {
+	duk_codepoint_t c;
+
+	switch (op) {
+	case DUK_REOP_ASSERT_START: {
+		if (sp <= re_ctx->input) {
+			return 1;
+		}
+		if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
+			return 0;
+		}
+		c = duk__inp_get_prev_cp(re_ctx, sp);
+		/* E5 Sections 15.10.2.8, 7.3 */
+		return (duk_unicode_is_line_terminator(c) != 0);
+	}
+	case DUK_REOP_ASSERT_END: {
+		c = duk__inp_get_cp(re_ctx, &sp);
+		if (c < 0) {
+			return 1;
+		}
+		if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
+			return 0;
+		}
+		/* E5 Sections 15.10.2.8, 7.3 */
+		return (duk_unicode_is_line_terminator(c) != 0);
+	}
+	default: {
+		/*
+		 *  E5 Section 15.10.2.6.  The previous and current character
+		 *  should -not- be canonicalized as they are now.  However,
+		 *  canonicalization does not affect the result of IsWordChar()
+		 *  (which depends on Unicode characters never canonicalizing
+		 *  into ASCII characters) so this does not matter.
+		 */
+		duk_small_int_t w1, w2;
+
+		DUK_ASSERT(op == DUK_REOP_ASSERT_WORD_BOUNDARY || op == DUK_REOP_ASSERT_NOT_WORD_BOUNDARY);
+
+		if (sp <= re_ctx->input) {
+			w1 = 0;  /* not a wordchar */
+		} else {
+			c = duk__inp_get_prev_cp(re_ctx, sp);
+			w1 = duk_unicode_re_is_wordchar(c);
+		}
+		if (sp >= re_ctx->input_end) {
+			w2 = 0;  /* not a wordchar */
+		} else {
+			c = duk__inp_get_cp(re_ctx, &sp);  /* 'sp' is a copy, caller's value not updated */
+			w2 = duk_unicode_re_is_wordchar(c);
+		}
+
+		if (op == DUK_REOP_ASSERT_WORD_BOUNDARY) {
+			return w1 != w2;
+		} else {
+			return w1 == w2;
+		}
+	}
+	}
+}
+
 /*
  *  Regexp recursive matching function.
  *
@@ -148,6 +209,15 @@ DUK_LOCAL duk_codepoint_t duk__inp_get_prev_cp(duk_re_matcher_ctx *re_ctx, const
 DUK_LOCAL const duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, const duk_uint8_t *pc, const duk_uint8_t *sp) {
 	duk_native_stack_check(re_ctx->thr);
 	if (re_ctx->recursion_depth >= re_ctx->recursion_limit) {
+#if defined(DUK_USE_REGEXP_NFA)
+		if (re_ctx->nfa_fallback) {
+			/* Exhaust the step budget so that the match attempt
+			 * unwinds quickly; the caller then uses the NFA matcher.
+			 */
+			re_ctx->steps_count = re_ctx->steps_limit;
+			return NULL;
+		}
+#endif
 		DUK_ERROR_RANGE(re_ctx->thr, DUK_STR_REGEXP_EXECUTOR_RECURSION_LIMIT);
 		DUK_WO_NORETURN(return NULL;);
 	}
@@ -157,6 +227,11 @@ DUK_LOCAL const duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, const
 		duk_small_int_t op;
 
 		if (re_ctx->steps_count >= re_ctx->steps_limit) {
+#if defined(DUK_USE_REGEXP_NFA)
+			if (re_ctx->nfa_fallback) {
+				goto fail;
+			}
+#endif
 			DUK_ERROR_RANGE(re_ctx->thr, DUK_STR_REGEXP_EXECUTOR_STEP_LIMIT);
 			DUK_WO_NORETURN(return NULL;);
 		}
@@ -270,76 +345,12 @@ DUK_LOCAL const duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, const
 			}
 			break;
 		}
-		case DUK_REOP_ASSERT_START: {
-			duk_codepoint_t c;
-
-			if (sp <= re_ctx->input) {
-				break;
-			}
-			if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
-				goto fail;
-			}
-			c = duk__inp_get_prev_cp(re_ctx, sp);
-			if (duk_unicode_is_line_terminator(c)) {
-				/* E5 Sections 15.10.2.8, 7.3 */
-				break;
-			}
-			goto fail;
-		}
-		case DUK_REOP_ASSERT_END: {
-			duk_codepoint_t c;
-			const duk_uint8_t *tmp_sp;
-
-			tmp_sp = sp;
-			c = duk__inp_get_cp(re_ctx, &tmp_sp);
-			if (c < 0) {
-				break;
-			}
-			if (!(re_ctx->re_flags & DUK_RE_FLAG_MULTILINE)) {
-				goto fail;
-			}
-			if (duk_unicode_is_line_terminator(c)) {
-				/* E5 Sections 15.10.2.8, 7.3 */
-				break;
-			}
-			goto fail;
-		}
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
 		case DUK_REOP_ASSERT_WORD_BOUNDARY:
 		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
-			/*
-			 *  E5 Section 15.10.2.6.  The previous and current character
-			 *  should -not- be canonicalized as they are now.  However,
-			 *  canonicalization does not affect the result of IsWordChar()
-			 *  (which depends on Unicode characters never canonicalizing
-			 *  into ASCII characters) so this does not matter.
-			 */
-			duk_small_int_t w1, w2;
-
-			if (sp <= re_ctx->input) {
-				w1 = 0;  /* not a wordchar */
-			} else {
-				duk_codepoint_t c;
-				c = duk__inp_get_prev_cp(re_ctx, sp);
-				w1 = duk_unicode_re_is_wordchar(c);
-			}
-			if (sp >= re_ctx->input_end) {
-				w2 = 0;  /* not a wordchar */
-			} else {
-				const duk_uint8_t *tmp_sp = sp;  /* dummy so sp won't get updated */
-				duk_codepoint_t c;
-				c = duk__inp_get_cp(re_ctx, &tmp_sp);
-				w2 = duk_unicode_re_is_wordchar(c);
-			}
-
-			if (op == DUK_REOP_ASSERT_WORD_BOUNDARY) {
-				if (w1 == w2) {
-					goto fail;
-				}
-			} else {
-				DUK_ASSERT(op == DUK_REOP_ASSERT_NOT_WORD_BOUNDARY);
-				if (w1 != w2) {
-					goto fail;
-				}
+			if (!duk__match_assertion(re_ctx, op, sp)) {
+				goto fail;
 			}
 			break;
 		}
@@ -671,6 +682,484 @@ DUK_LOCAL const duk_uint8_t *duk__match_regexp(duk_re_matcher_ctx *re_ctx, const
 	DUK_WO_NORETURN(return NULL;);
 }
 
+#if defined(DUK_USE_REGEXP_START_HINTS)
+/* Skip input offsets which can't start a match based on the start hints
+ * computed by the regexp compiler.  Returns the next candidate offset or
+ * NULL if no match is possible at or after 'sp'.  Only ASCII bytes are
+ * skipped so the number of skipped characters is the number of skipped
+ * bytes.  The literal prefix is only used for ASCII input because non-ASCII
+ * input might contain non-shortest encodings of ASCII characters.
+ */
+DUK_LOCAL const duk_uint8_t *duk__regexp_scan_start(duk_re_matcher_ctx *re_ctx, const duk_uint8_t *sp) {
+	const duk_uint8_t *sp_end;
+	const duk_uint8_t *prefix;
+	const duk_uint8_t *first_set;
+	const duk_uint8_t *p;
+	duk_size_t prefix_len;
+	duk_small_uint_t b;
+
+	sp_end = re_ctx->input_end;
+	prefix = re_ctx->hint_prefix;
+	prefix_len = re_ctx->hint_prefix_len;
+	if (prefix != NULL && re_ctx->input_ascii) {
+		DUK_ASSERT(prefix_len > 0);
+		for (;;) {
+			if ((duk_size_t) (sp_end - sp) < prefix_len) {
+				return NULL;
+			}
+			p = (const duk_uint8_t *) duk_memchr((const void *) sp, (duk_small_uint_t) prefix[0], (duk_size_t) (sp_end - sp) - prefix_len + 1);
+			if (p == NULL) {
+				return NULL;
+			}
+			if (duk_memcmp_unsafe((const void *) (p + 1), (const void *) (prefix + 1), prefix_len - 1) == 0) {
+				return p;
+			}
+			sp = p + 1;
+		}
+	}
+
+	first_set = re_ctx->hint_first_set;
+	if (first_set != NULL) {
+		while (sp < sp_end) {
+			b = (duk_small_uint_t) *sp;
+			if (b >= 0x80U || (first_set[b >> 3] & (1U << (b & 0x07U))) != 0) {
+				return sp;
+			}
+			sp++;
+		}
+		return NULL;
+	}
+
+	return sp;
+}
+#endif  /* DUK_USE_REGEXP_START_HINTS */
+
+#if defined(DUK_USE_REGEXP_NFA)
+/*
+ *  Non-backtracking matcher.
+ *
+ *  Executes the same bytecode as duk__match_regexp() in a single pass over
+ *  the input by simulating all backtracking alternatives in parallel as
+ *  threads (a "Pike VM").  Threads are kept in the order the backtracking
+ *  matcher would try them, so the match and its captures are the same as
+ *  with backtracking.  A thread reaching an instruction another thread has
+ *  already visited at the same input position is dropped: the earlier,
+ *  higher priority thread has the same future.  Matching time is thus
+ *  linear in input length times bytecode size, and there's no C recursion
+ *  per input character.
+ *
+ *  This requires bytecode without backreferences and lookaheads, and with
+ *  simple quantifiers whose state doesn't need an iteration counter: qmin
+ *  is 0 or 1 and qmax is 0, 1, or infinite.  A simple quantifier atom has
+ *  no quantifiers of its own so a thread inside one only needs to remember
+ *  the quantifier instruction to know where the atom's MATCH continues.
+ *  The compiler expands other counts when possible, and indicates usable
+ *  bytecode with a nonzero thread count in the bytecode header.
+ *
+ *  The backtracking matcher is still used first because it's faster for
+ *  typical patterns; the NFA matcher takes over if backtracking exceeds a
+ *  step budget proportional to input length and pattern size, or the
+ *  recursion limit.
+ */
+
+typedef struct {
+	const duk_uint8_t **pc;     /* per thread: character matcher or MATCH */
+	const duk_uint8_t **sq;     /* per thread: enclosing simple quantifier or NULL */
+	const duk_uint8_t **saved;  /* per thread: nsaved capture pointers */
+	duk_uint32_t count;
+} duk__re_nfa_list;
+
+typedef struct {
+	duk_re_matcher_ctx *re_ctx;
+	duk_uint32_t nthreads;      /* capacity of each thread list */
+	duk_uint32_t gen;           /* generation, bumped for each input position */
+	duk_uint32_t *marks;        /* per bytecode byte, generation of last visit */
+	const duk_uint8_t **saved;  /* captures of the thread being added */
+	const duk_uint8_t **empty;  /* captures for a new thread, all NULL */
+	duk__re_nfa_list list[2];
+} duk__re_nfa_ctx;
+
+/* Decode a simple quantifier instruction at 'pc'; returns the atom start. */
+DUK_LOCAL const duk_uint8_t *duk__re_nfa_decode_sq(duk_re_matcher_ctx *re_ctx,
+                                                   const duk_uint8_t *pc,
+                                                   duk_uint32_t *out_qmin,
+                                                   duk_uint32_t *out_qmax,
+                                                   const duk_uint8_t **out_cont) {
+	duk_small_int_t op;
+	duk_int32_t skip;
+
+	op = *pc++;
+	*out_qmin = duk__bc_get_u32(re_ctx, &pc);
+	*out_qmax = duk__bc_get_u32(re_ctx, &pc);
+	if (op == DUK_REOP_SQGREEDY) {
+		(void) duk__bc_get_u32(re_ctx, &pc);  /* atomlen */
+	}
+	skip = duk__bc_get_i32(re_ctx, &pc);
+	*out_cont = pc + skip;
+	if (*out_qmin > 1 || (*out_qmax > 1 && *out_qmax != DUK_RE_QUANTIFIER_INFINITE)) {
+		DUK_ERROR_INTERNAL(re_ctx->thr);
+		DUK_WO_NORETURN(return NULL;);
+	}
+	return pc;
+}
+
+/* Add a thread for 'pc' at input position 'sp' to 'list', following jumps,
+ * splits, and zero width instructions until a character matcher or MATCH
+ * is reached.  'sq' is the simple quantifier whose atom 'pc' is in, or NULL.
+ * Thread captures are in nc->saved and are restored before returning.
+ */
+DUK_LOCAL void duk__re_nfa_add(duk__re_nfa_ctx *nc, duk__re_nfa_list *list, const duk_uint8_t *pc, const duk_uint8_t *sq, const duk_uint8_t *sp) {
+	duk_re_matcher_ctx *re_ctx;
+	duk_small_int_t op;
+	duk_int32_t skip;
+	const duk_uint8_t *atom;
+	const duk_uint8_t *cont;
+	duk_uint32_t qmin, qmax;
+
+	re_ctx = nc->re_ctx;
+	duk_native_stack_check(re_ctx->thr);
+	if (re_ctx->recursion_depth >= re_ctx->recursion_limit) {
+		DUK_ERROR_RANGE(re_ctx->thr, DUK_STR_REGEXP_EXECUTOR_RECURSION_LIMIT);
+		DUK_WO_NORETURN(return;);
+	}
+	re_ctx->recursion_depth++;
+
+	for (;;) {
+		if (pc < re_ctx->bytecode || pc >= re_ctx->bytecode_end) {
+			goto internal_error;
+		}
+		if (nc->marks[pc - re_ctx->bytecode] == nc->gen) {
+			goto done;
+		}
+		nc->marks[pc - re_ctx->bytecode] = nc->gen;
+
+		op = *pc;
+		if (op == DUK_REOP_MATCH && sq != NULL) {
+			/* End of a simple quantifier atom: iterate again or
+			 * continue after the quantifier.
+			 */
+			atom = duk__re_nfa_decode_sq(re_ctx, sq, &qmin, &qmax, &cont);
+			if (qmax != DUK_RE_QUANTIFIER_INFINITE) {
+				pc = cont;
+				sq = NULL;
+				continue;
+			}
+			goto sq_split;
+		}
+		switch (op) {
+		case DUK_REOP_MATCH:
+		case DUK_REOP_CHAR:
+		case DUK_REOP_PERIOD:
+		case DUK_REOP_RANGES:
+		case DUK_REOP_INVRANGES: {
+			if (list->count >= nc->nthreads) {
+				goto internal_error;
+			}
+			list->pc[list->count] = pc;
+			list->sq[list->count] = sq;
+			duk_memcpy((void *) (list->saved + list->count * re_ctx->nsaved),
+			           (const void *) nc->saved,
+			           sizeof(duk_uint8_t *) * re_ctx->nsaved);
+			list->count++;
+			goto done;
+		}
+		case DUK_REOP_JUMP: {
+			pc++;
+			skip = duk__bc_get_i32(re_ctx, &pc);
+			pc += skip;
+			break;
+		}
+		case DUK_REOP_SPLIT1: {
+			/* split1: prefer direct execution (no jump) */
+			pc++;
+			skip = duk__bc_get_i32(re_ctx, &pc);
+			duk__re_nfa_add(nc, list, pc, sq, sp);
+			pc += skip;
+			break;
+		}
+		case DUK_REOP_SPLIT2: {
+			/* split2: prefer jump execution (not direct) */
+			pc++;
+			skip = duk__bc_get_i32(re_ctx, &pc);
+			duk__re_nfa_add(nc, list, pc + skip, sq, sp);
+			break;
+		}
+		case DUK_REOP_SQMINIMAL:
+		case DUK_REOP_SQGREEDY: {
+			if (sq != NULL) {
+				goto internal_error;
+			}
+			sq = pc;
+			atom = duk__re_nfa_decode_sq(re_ctx, sq, &qmin, &qmax, &cont);
+			if (qmax == 0) {
+				pc = cont;
+				sq = NULL;
+				break;
+			}
+			if (qmin > 0) {
+				pc = atom;
+				break;
+			}
+			goto sq_split;
+		}
+		case DUK_REOP_SAVE: {
+			duk_uint32_t idx;
+			const duk_uint8_t *old;
+
+			pc++;
+			idx = duk__bc_get_u32(re_ctx, &pc);
+			if (idx >= re_ctx->nsaved) {
+				goto internal_error;
+			}
+			old = nc->saved[idx];
+			nc->saved[idx] = sp;
+			duk__re_nfa_add(nc, list, pc, sq, sp);
+			nc->saved[idx] = old;
+			goto done;
+		}
+		case DUK_REOP_WIPERANGE: {
+			duk_uint32_t idx_start, idx_count, idx;
+			const duk_uint8_t **range_save;
+
+			pc++;
+			idx_start = duk__bc_get_u32(re_ctx, &pc);
+			idx_count = duk__bc_get_u32(re_ctx, &pc);
+			if (idx_start + idx_count > re_ctx->nsaved || idx_count == 0) {
+				goto internal_error;
+			}
+
+			duk_require_stack(re_ctx->thr, 1);
+			range_save = (const duk_uint8_t **) duk_push_fixed_buffer_nozero(re_ctx->thr,
+			                                                                 sizeof(duk_uint8_t *) * idx_count);
+			DUK_ASSERT(range_save != NULL);
+			duk_memcpy((void *) range_save, (const void *) (nc->saved + idx_start), sizeof(duk_uint8_t *) * idx_count);
+			for (idx = idx_start; idx < idx_start + idx_count; idx++) {
+				nc->saved[idx] = NULL;
+			}
+			duk__re_nfa_add(nc, list, pc, sq, sp);
+			duk_memcpy((void *) (nc->saved + idx_start), (const void *) range_save, sizeof(duk_uint8_t *) * idx_count);
+			duk_pop_unsafe(re_ctx->thr);
+			goto done;
+		}
+		case DUK_REOP_ASSERT_START:
+		case DUK_REOP_ASSERT_END:
+		case DUK_REOP_ASSERT_WORD_BOUNDARY:
+		case DUK_REOP_ASSERT_NOT_WORD_BOUNDARY: {
+			if (!duk__match_assertion(re_ctx, op, sp)) {
+				goto done;
+			}
+			pc++;
+			break;
+		}
+		default: {
+			DUK_D(DUK_DPRINT("internal error, unexpected opcode for nfa matcher: %ld", (long) op));
+			goto internal_error;
+		}
+		}
+		continue;
+
+	 sq_split:
+		/* Either another atom iteration or continue after the
+		 * quantifier, in the backtracking matcher's order.
+		 */
+		if (*sq == DUK_REOP_SQGREEDY) {
+			duk__re_nfa_add(nc, list, atom, sq, sp);
+			pc = cont;
+			sq = NULL;
+		} else {
+			duk__re_nfa_add(nc, list, cont, NULL, sp);
+			pc = atom;
+		}
+	}
+
+ done:
+	re_ctx->recursion_depth--;
+	return;
+
+ internal_error:
+	DUK_ERROR_INTERNAL(re_ctx->thr);
+	DUK_WO_NORETURN(return;);
+}
+
+/* Match input character 'c' (canonicalized if necessary) against the
+ * character matcher at 'pc'.  Returns the next instruction or NULL.
+ */
+DUK_LOCAL const duk_uint8_t *duk__re_nfa_step(duk_re_matcher_ctx *re_ctx, const duk_uint8_t *pc, duk_codepoint_t c) {
+	duk_small_int_t op;
+	duk_uint32_t n;
+	duk_small_int_t match;
+
+	DUK_ASSERT(c >= 0);
+
+	op = *pc++;
+	switch (op) {
+	case DUK_REOP_CHAR: {
+		if ((duk_codepoint_t) duk__bc_get_u32(re_ctx, &pc) != c) {
+			return NULL;
+		}
+		return pc;
+	}
+	case DUK_REOP_PERIOD: {
+		if (duk_unicode_is_line_terminator(c)) {
+			/* E5 Sections 15.10.2.8, 7.3 */
+			return NULL;
+		}
+		return pc;
+	}
+	default: {
+		DUK_ASSERT(op == DUK_REOP_RANGES || op == DUK_REOP_INVRANGES);
+		n = duk__bc_get_u32(re_ctx, &pc);
+		match = 0;
+		while (n) {
+			duk_codepoint_t r1, r2;
+			r1 = (duk_codepoint_t) duk__bc_get_u32(re_ctx, &pc);
+			r2 = (duk_codepoint_t) duk__bc_get_u32(re_ctx, &pc);
+			if (c >= r1 && c <= r2) {
+				/* Read all ranges, 'pc' must end up after them. */
+				match = 1;
+			}
+			n--;
+		}
+		if (match != (op == DUK_REOP_RANGES)) {
+			return NULL;
+		}
+		return pc;
+	}
+	}
+}
+
+/* Find the first match starting at or after 'sp'.  On a match, the captures
+ * are copied to re_ctx->saved and 1 is returned; saved[0] is the match start.
+ */
+DUK_LOCAL duk_bool_t duk__match_regexp_nfa(duk_re_matcher_ctx *re_ctx, duk_uint32_t nthreads, const duk_uint8_t *sp) {
+	duk__re_nfa_ctx nc;
+	duk__re_nfa_list *clist;
+	duk__re_nfa_list *nlist;
+	duk__re_nfa_list *tmp;
+	const duk_uint8_t **p;
+	const duk_uint8_t *sp_next;
+	const duk_uint8_t *pc;
+	duk_size_t nsaved;
+	duk_codepoint_t c;
+	duk_uint32_t i;
+	duk_bool_t matched = 0;
+
+	/* Single buffer for the thread lists, captures, and visit marks;
+	 * pointers first for alignment.
+	 */
+	nsaved = (duk_size_t) re_ctx->nsaved;
+	duk_require_stack(re_ctx->thr, 1);
+	p = (const duk_uint8_t **) duk_push_fixed_buffer_zero(re_ctx->thr,
+	                                                      sizeof(duk_uint8_t *) * (nsaved + 2 * (duk_size_t) nthreads * (nsaved + 2)) +
+	                                                      sizeof(duk_uint32_t) * (duk_size_t) (re_ctx->bytecode_end - re_ctx->bytecode));
+	DUK_ASSERT(p != NULL);
+
+	nc.re_ctx = re_ctx;
+	nc.nthreads = nthreads;
+	nc.gen = 1;
+	nc.empty = p;
+	p += nsaved;
+	for (i = 0; i < 2; i++) {
+		nc.list[i].pc = p;
+		p += nthreads;
+		nc.list[i].sq = p;
+		p += nthreads;
+		nc.list[i].saved = p;
+		p += (duk_size_t) nthreads * nsaved;
+		nc.list[i].count = 0;
+	}
+	nc.marks = (duk_uint32_t *) (void *) p;
+#if defined(DUK_USE_EXPLICIT_NULL_INIT)
+	for (i = 0; i < nsaved; i++) {
+		nc.empty[i] = NULL;
+	}
+#endif
+
+	clist = &nc.list[0];
+	nlist = &nc.list[1];
+
+	for (;;) {
+		/* Until a match is found, start a new lowest priority thread
+		 * at each input position.
+		 */
+		if (!matched) {
+			duk_bool_t start = 1;
+
+#if defined(DUK_USE_REGEXP_START_HINTS)
+			if (re_ctx->hints & DUK_RE_HINT_ANCHORED) {
+				start = (sp == re_ctx->input);
+			} else if (clist->count == 0 && (re_ctx->hints & (DUK_RE_HINT_FIRSTSET | DUK_RE_HINT_PREFIX))) {
+				sp_next = duk__regexp_scan_start(re_ctx, sp);
+				if (sp_next == NULL) {
+					break;
+				}
+				if (sp_next != sp) {
+					sp = sp_next;
+					nc.gen++;  /* invalidate marks left by failed threads */
+				}
+			}
+#endif
+			if (start) {
+				nc.saved = nc.empty;
+				duk__re_nfa_add(&nc, clist, re_ctx->bytecode, NULL, sp);
+			}
+		}
+		if (clist->count == 0) {
+			/* No live threads: done if a match was found or no match
+			 * can start later, otherwise retry at the next position.
+			 */
+			if (matched || sp >= re_ctx->input_end) {
+				break;
+			}
+#if defined(DUK_USE_REGEXP_START_HINTS)
+			if (re_ctx->hints & DUK_RE_HINT_ANCHORED) {
+				break;
+			}
+#endif
+			(void) duk__utf8_advance(re_ctx->thr, &sp, re_ctx->input, re_ctx->input_end, (duk_uint_fast32_t) 1);
+			nc.gen++;
+			continue;
+		}
+
+		/* Advance all threads over the current character, in priority
+		 * order.  A thread reaching MATCH cuts off lower priority threads.
+		 */
+		sp_next = sp;
+		c = duk__inp_get_cp(re_ctx, &sp_next);  /* < 0 at end of input */
+		nc.gen++;
+		nlist->count = 0;
+		for (i = 0; i < clist->count; i++) {
+			pc = clist->pc[i];
+			if (*pc == DUK_REOP_MATCH) {
+				duk_memcpy((void *) re_ctx->saved,
+				           (const void *) (clist->saved + i * nsaved),
+				           sizeof(duk_uint8_t *) * nsaved);
+				matched = 1;
+				break;
+			}
+			if (c >= 0) {
+				pc = duk__re_nfa_step(re_ctx, pc, c);
+				if (pc != NULL) {
+					nc.saved = clist->saved + i * nsaved;
+					duk__re_nfa_add(&nc, nlist, pc, clist->sq[i], sp_next);
+				}
+			}
+		}
+		if (c < 0) {
+			break;
+		}
+
+		tmp = clist;
+		clist = nlist;
+		nlist = tmp;
+		sp = sp_next;
+	}
+
+	duk_pop_unsafe(re_ctx->thr);
+	return matched;
+}
+#endif  /* DUK_USE_REGEXP_NFA */
+
 /*
  *  Exposed matcher function which provides the semantics of RegExp.prototype.exec().
  *
@@ -696,6 +1185,9 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 	duk_uint_fast32_t i;
 	double d;
 	duk_uint32_t char_offset;
+#if defined(DUK_USE_REGEXP_NFA)
+	duk_uint32_t nfa_threads;
+#endif
 
 	DUK_ASSERT(thr != NULL);
 
@@ -730,6 +1222,10 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 	 *
 	 *    uint   flags
 	 *    uint   nsaved (even, 2n+2 where n = num captures)
+	 *    uint   NFA thread count, 0 if backtracking is needed
+	 *           (if DUK_USE_REGEXP_NFA)
+	 *    uint   start hints, followed by optional hint data
+	 *           (if DUK_USE_REGEXP_START_HINTS)
 	 */
 
 	/* [ ... re_obj input bc ] */
@@ -749,6 +1245,29 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 	pc = re_ctx.bytecode;
 	re_ctx.re_flags = duk__bc_get_u32(&re_ctx, &pc);
 	re_ctx.nsaved = duk__bc_get_u32(&re_ctx, &pc);
+#if defined(DUK_USE_REGEXP_NFA)
+	nfa_threads = duk__bc_get_u32(&re_ctx, &pc);
+#endif
+#if defined(DUK_USE_REGEXP_START_HINTS)
+	re_ctx.hints = duk__bc_get_u32(&re_ctx, &pc);
+	if (re_ctx.hints & DUK_RE_HINT_FIRSTSET) {
+		if (re_ctx.bytecode_end - pc < DUK_RE_HINT_FIRSTSET_BYTES) {
+			DUK_ERROR_INTERNAL(thr);
+			DUK_WO_NORETURN(return;);
+		}
+		re_ctx.hint_first_set = pc;
+		pc += DUK_RE_HINT_FIRSTSET_BYTES;
+	}
+	if (re_ctx.hints & DUK_RE_HINT_PREFIX) {
+		re_ctx.hint_prefix_len = (duk_size_t) duk__bc_get_u32(&re_ctx, &pc);
+		if (re_ctx.hint_prefix_len == 0 || (duk_size_t) (re_ctx.bytecode_end - pc) < re_ctx.hint_prefix_len) {
+			DUK_ERROR_INTERNAL(thr);
+			DUK_WO_NORETURN(return;);
+		}
+		re_ctx.hint_prefix = pc;
+		pc += re_ctx.hint_prefix_len;
+	}
+#endif
 	re_ctx.bytecode = pc;
 
 	DUK_ASSERT(DUK_RE_FLAG_GLOBAL < 0x10000UL);  /* must fit into duk_small_int_t */
@@ -821,6 +1340,28 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 
 	DUK_ASSERT(char_offset <= DUK_HSTRING_GET_CHARLEN(h_input));
 	sp = re_ctx.input + duk_heap_strcache_offset_char2byte(thr, h_input, char_offset);
+#if defined(DUK_USE_REGEXP_START_HINTS)
+	re_ctx.input_ascii = (DUK_HSTRING_GET_CHARLEN(h_input) == DUK_HSTRING_GET_BYTELEN(h_input));
+#endif
+
+#if defined(DUK_USE_REGEXP_NFA)
+	if (nfa_threads > 0) {
+		/* Backtrack with a step budget proportional to the work the
+		 * NFA matcher would do, and switch to the NFA matcher if the
+		 * budget runs out.
+		 */
+		duk_size_t budget;
+
+		budget = (duk_size_t) (re_ctx.input_end - sp) + 1U;
+		if (budget > (duk_size_t) (DUK_RE_EXECUTE_STEPS_LIMIT / DUK_RE_NFA_BACKTRACK_STEPS) / (duk_size_t) nfa_threads) {
+			budget = (duk_size_t) DUK_RE_EXECUTE_STEPS_LIMIT;
+		} else {
+			budget *= (duk_size_t) DUK_RE_NFA_BACKTRACK_STEPS * (duk_size_t) nfa_threads;
+		}
+		re_ctx.steps_limit = (duk_uint32_t) budget;
+		re_ctx.nfa_fallback = 1;
+	}
+#endif
 
 	/*
 	 *  Match loop.
@@ -840,6 +1381,25 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 		/* Note: re_ctx.steps is intentionally not reset, it applies to the entire unanchored match */
 		DUK_ASSERT(re_ctx.recursion_depth == 0);
 
+#if defined(DUK_USE_REGEXP_START_HINTS)
+		if (re_ctx.hints & DUK_RE_HINT_ANCHORED) {
+			if (sp != re_ctx.input) {
+				DUK_DDD(DUK_DDDPRINT("anchored regexp, no match after input start"));
+				break;
+			}
+		} else if (re_ctx.hints & (DUK_RE_HINT_FIRSTSET | DUK_RE_HINT_PREFIX)) {
+			const duk_uint8_t *sp_next;
+
+			sp_next = duk__regexp_scan_start(&re_ctx, sp);
+			if (sp_next == NULL) {
+				DUK_DDD(DUK_DDDPRINT("no possible match start after char offset %ld", (long) char_offset));
+				break;
+			}
+			char_offset += (duk_uint32_t) (sp_next - sp);
+			sp = sp_next;
+		}
+#endif
+
 		DUK_DDD(DUK_DDDPRINT("attempt match at char offset %ld; %p [%p,%p]",
 		                     (long) char_offset, (const void *) sp,
 		                     (const void *) re_ctx.input, (const void *) re_ctx.input_end));
@@ -855,12 +1415,9 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 		 *    - Backtracking also rewinds re_ctx.recursion back to zero, unless an
 		 *      internal/limit error occurs (which causes a longjmp())
 		 *
-		 *    - If we supported anchored matches, we would break out here
-		 *      unconditionally; however, ECMAScript regexps don't have anchored
-		 *      matches.  It might make sense to implement a fast bail-out if
-		 *      the regexp begins with '^' and sp is not 0: currently we'll just
-		 *      run through the entire input string, trivially failing the match
-		 *      at every non-zero offset.
+		 *    - Patterns beginning with '^' (without the multiline flag) only
+		 *      attempt a match at input start, and offsets which can't start
+		 *      a match are skipped above, see DUK_USE_REGEXP_START_HINTS.
 		 */
 
 		if (duk__match_regexp(&re_ctx, re_ctx.bytecode, sp) != NULL) {
@@ -869,6 +1426,28 @@ DUK_LOCAL void duk__regexp_match_helper(duk_hthread *thr, duk_small_int_t force_
 			break;
 		}
 
+#if defined(DUK_USE_REGEXP_NFA)
+		if (re_ctx.steps_count >= re_ctx.steps_limit) {
+			/* Backtracking budget exhausted, earlier offsets have
+			 * been ruled out so the NFA matcher continues from 'sp'
+			 * and the match start character offset is computed
+			 * afterwards.
+			 */
+			DUK_ASSERT(re_ctx.nfa_fallback);
+			DUK_ASSERT(re_ctx.recursion_depth == 0);
+			DUK_DDD(DUK_DDDPRINT("backtracking steps exhausted at offset %ld, use nfa matcher", (long) char_offset));
+			if (duk__match_regexp_nfa(&re_ctx, nfa_threads, sp)) {
+				if (re_ctx.saved[0] == NULL || re_ctx.saved[0] < sp || re_ctx.saved[0] > re_ctx.input_end) {
+					DUK_ERROR_INTERNAL(thr);
+					DUK_WO_NORETURN(return;);
+				}
+				char_offset += (duk_uint32_t) duk_unicode_unvalidated_utf8_length(sp, (duk_size_t) (re_ctx.saved[0] - sp));
+				match = 1;
+			}
+			break;
+		}
+#endif
+
 		/* advance by one character (code point) and one char_offset */
 		char_offset++;
 		if (char_offset > DUK_HSTRING_GET_CHARLEN(h_input)) {
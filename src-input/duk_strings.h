@@ -68,6 +68,8 @@
 #define DUK_STR_BASE64_DECODE_FAILED             "base64 decode failed"
 #define DUK_STR_HEX_DECODE_FAILED                "hex decode failed"
 #define DUK_STR_INVALID_BYTECODE                 "invalid bytecode"
+#define DUK_STR_INVALID_HEAP_IMAGE               "invalid heap image"
+#define DUK_STR_UNDUMPABLE_VALUE                 "undumpable value"
 #define DUK_STR_NO_SOURCECODE                    "no sourcecode"
 #define DUK_STR_RESULT_TOO_LONG                  "result too long"
 #define DUK_STR_INVALID_CFUNC_RC                 "invalid C function rc"
@@ -283,6 +283,98 @@ DUK_INTERNAL duk_ucodepoint_t duk_unicode_decode_xutf8_checked(duk_hthread *thr,
 	DUK_WO_NORETURN(return 0;);
 }
 
+/*
+ *  Vectorized byte scanning helpers
+ *
+ *  Count continuation bytes ([0x80,0xbf]) in full vector sized blocks,
+ *  leaving the remaining tail (if any) for the caller.  Continuation bytes
+ *  are exactly the bytes below 0xc0 when compared as signed 8-bit values,
+ *  i.e. [-128,-65].  Per-lane 8-bit counters are accumulated for at most
+ *  255 blocks at a time before being summed to avoid overflow.
+ */
+
+#if !defined(DUK_USE_PREFER_SIZE)
+#if defined(DUK_USE_SIMD_AVX2)
+DUK_LOCAL const duk_uint8_t *duk__utf8_count_cont_avx2(const duk_uint8_t *p, const duk_uint8_t *p_end, duk_size_t *out_ncont) {
+	const __m256i limit = _mm256_set1_epi8((char) -64);
+	const __m256i zero = _mm256_setzero_si256();
+	duk_size_t ncont = 0;
+
+	while ((duk_size_t) (p_end - p) >= 32) {
+		__m256i acc = zero;
+		__m128i sum;
+		duk_small_uint_t n = 0;
+
+		do {
+			__m256i v = _mm256_loadu_si256((const __m256i *) (const void *) p);
+			acc = _mm256_sub_epi8(acc, _mm256_cmpgt_epi8(limit, v));
+			p += 32;
+		} while (++n < 255 && (duk_size_t) (p_end - p) >= 32);
+
+		acc = _mm256_sad_epu8(acc, zero);
+		sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+		ncont += (duk_size_t) (duk_uint32_t) _mm_cvtsi128_si32(sum) +
+		         (duk_size_t) (duk_uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(sum, 8));
+	}
+
+	*out_ncont += ncont;
+	return p;
+}
+#endif  /* DUK_USE_SIMD_AVX2 */
+
+#if defined(DUK_USE_SIMD_SSE2)
+DUK_LOCAL const duk_uint8_t *duk__utf8_count_cont_sse2(const duk_uint8_t *p, const duk_uint8_t *p_end, duk_size_t *out_ncont) {
+	const __m128i limit = _mm_set1_epi8((char) -64);
+	const __m128i zero = _mm_setzero_si128();
+	duk_size_t ncont = 0;
+
+	while ((duk_size_t) (p_end - p) >= 16) {
+		__m128i acc = zero;
+		duk_small_uint_t n = 0;
+
+		do {
+			__m128i v = _mm_loadu_si128((const __m128i *) (const void *) p);
+			acc = _mm_sub_epi8(acc, _mm_cmplt_epi8(v, limit));
+			p += 16;
+		} while (++n < 255 && (duk_size_t) (p_end - p) >= 16);
+
+		acc = _mm_sad_epu8(acc, zero);
+		ncont += (duk_size_t) (duk_uint32_t) _mm_cvtsi128_si32(acc) +
+		         (duk_size_t) (duk_uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(acc, 8));
+	}
+
+	*out_ncont += ncont;
+	return p;
+}
+#endif  /* DUK_USE_SIMD_SSE2 */
+
+#if defined(DUK_USE_SIMD_NEON)
+DUK_LOCAL const duk_uint8_t *duk__utf8_count_cont_neon(const duk_uint8_t *p, const duk_uint8_t *p_end, duk_size_t *out_ncont) {
+	const int8x16_t limit = vdupq_n_s8(-64);
+	duk_size_t ncont = 0;
+
+	while ((duk_size_t) (p_end - p) >= 16) {
+		uint8x16_t acc = vdupq_n_u8(0);
+		uint32x4_t sum;
+		duk_small_uint_t n = 0;
+
+		do {
+			int8x16_t v = vreinterpretq_s8_u8(vld1q_u8(p));
+			acc = vsubq_u8(acc, vcltq_s8(v, limit));
+			p += 16;
+		} while (++n < 255 && (duk_size_t) (p_end - p) >= 16);
+
+		sum = vpaddlq_u16(vpaddlq_u8(acc));
+		ncont += (duk_size_t) vgetq_lane_u32(sum, 0) + (duk_size_t) vgetq_lane_u32(sum, 1) +
+		         (duk_size_t) vgetq_lane_u32(sum, 2) + (duk_size_t) vgetq_lane_u32(sum, 3);
+	}
+
+	*out_ncont += ncont;
+	return p;
+}
+#endif  /* DUK_USE_SIMD_NEON */
+#endif  /* !DUK_USE_PREFER_SIZE */
+
 /* Compute (extended) utf-8 length without codepoint encoding validation,
  * used for string interning.
  *
@@ -335,7 +427,20 @@ DUK_INTERNAL duk_size_t duk_unicode_unvalidated_utf8_length(const duk_uint8_t *d
 	ncont = 0;  /* number of continuation (non-initial) bytes in [0x80,0xbf] */
 	p = data;
 	p_end = data + blen;
-	if (blen < 16) {
+
+	/* Vector paths leave at most one vector's worth of bytes for the
+	 * portable code below.
+	 */
+#if defined(DUK_USE_SIMD_AVX2)
+	p = duk__utf8_count_cont_avx2(p, p_end, &ncont);
+#endif
+#if defined(DUK_USE_SIMD_SSE2)
+	p = duk__utf8_count_cont_sse2(p, p_end, &ncont);
+#elif defined(DUK_USE_SIMD_NEON)
+	p = duk__utf8_count_cont_neon(p, p_end, &ncont);
+#endif
+
+	if ((duk_size_t) (p_end - p) < 16) {
 		goto skip_fastpath;
 	}
 
@@ -397,31 +502,68 @@ DUK_INTERNAL duk_size_t duk_unicode_unvalidated_utf8_length(const duk_uint8_t *d
 }
 #endif  /* DUK_USE_PREFER_SIZE */
 
-/* Check whether a string is UTF-8 compatible or not. */
-DUK_INTERNAL duk_bool_t duk_unicode_is_utf8_compatible(const duk_uint8_t *buf, duk_size_t len) {
-	duk_size_t i = 0;
-#if !defined(DUK_USE_PREFER_SIZE)
-	duk_size_t len_safe;
-#endif
+/* Length of the initial pure ASCII ([0x00,0x7f]) part of a byte sequence.
+ * Many practical strings are ASCII only, so the fast variant checks chunks
+ * of bytes at once with minimal branch cost.
+ */
+DUK_INTERNAL duk_size_t duk_unicode_ascii_prefix_length(const duk_uint8_t *data, duk_size_t blen) {
+	const duk_uint8_t *p;
+	const duk_uint8_t *p_end;
+
+	p = data;
+	p_end = data + blen;
 
-	/* Many practical strings are ASCII only, so use a fast path check
-	 * to check chunks of bytes at once with minimal branch cost.
-	 */
 #if !defined(DUK_USE_PREFER_SIZE)
-	len_safe = len & ~0x03UL;
-	for (; i < len_safe; i += 4) {
-		duk_uint8_t t = buf[i] | buf[i + 1] | buf[i + 2] | buf[i + 3];
-		if (DUK_UNLIKELY((t & 0x80U) != 0U)) {
-			/* At least one byte was outside 0x00-0x7f, break
-			 * out to slow path (and remain there).
-			 *
-			 * XXX: We could also deal with the problem character
-			 * and resume fast path later.
-			 */
+#if defined(DUK_USE_SIMD_AVX2)
+	while ((duk_size_t) (p_end - p) >= 32) {
+		__m256i v = _mm256_loadu_si256((const __m256i *) (const void *) p);
+		if (_mm256_movemask_epi8(v) != 0) {
 			break;
 		}
+		p += 32;
 	}
 #endif
+#if defined(DUK_USE_SIMD_SSE2)
+	while ((duk_size_t) (p_end - p) >= 16) {
+		__m128i v = _mm_loadu_si128((const __m128i *) (const void *) p);
+		if (_mm_movemask_epi8(v) != 0) {
+			break;
+		}
+		p += 16;
+	}
+#elif defined(DUK_USE_SIMD_NEON)
+	while ((duk_size_t) (p_end - p) >= 16) {
+		uint8x16_t v = vld1q_u8(p);
+		uint32x2_t t = vreinterpret_u32_u8(vorr_u8(vget_low_u8(v), vget_high_u8(v)));
+		if (((vget_lane_u32(t, 0) | vget_lane_u32(t, 1)) & 0x80808080UL) != 0) {
+			break;
+		}
+		p += 16;
+	}
+#endif
+	while ((duk_size_t) (p_end - p) >= 4) {
+		if (DUK_UNLIKELY(((p[0] | p[1] | p[2] | p[3]) & 0x80U) != 0U)) {
+			break;
+		}
+		p += 4;
+	}
+#endif  /* !DUK_USE_PREFER_SIZE */
+
+	/* Locate the exact position within the last chunk. */
+	while (p != p_end && *p < 0x80U) {
+		p++;
+	}
+	return (duk_size_t) (p - data);
+}
+
+/* Check whether a string is UTF-8 compatible or not. */
+DUK_INTERNAL duk_bool_t duk_unicode_is_utf8_compatible(const duk_uint8_t *buf, duk_size_t len) {
+	duk_size_t i;
+
+	/* Skip initial ASCII part quickly, remain in the slow path after
+	 * the first non-ASCII character.
+	 */
+	i = duk_unicode_ascii_prefix_length(buf, len);
 
 	for (; i < len;) {
 		duk_uint8_t t;
@@ -34,3 +34,8 @@ DUK_INTERNAL DUK_INLINE duk_small_int_t duk_memcmp(const void *s1, const void *s
 	return DUK_MEMCMP(s1, s2, (size_t) len);
 }
 #endif  /* DUK_USE_ALLOW_UNDEFINED_BEHAVIOR */
+
+DUK_INTERNAL DUK_INLINE const void *duk_memchr(const void *s, duk_small_uint_t c, duk_size_t len) {
+	DUK_ASSERT(s != NULL);
+	return (const void *) DUK_MEMCHR(s, (int) c, (size_t) len);
+}
@@ -68,6 +68,7 @@ static duk_ret_t test_func(duk_context *ctx, void *udata) {
 	(void) duk_del_prop(ctx, 0);
 	(void) duk_destroy_heap(ctx);
 	(void) duk_dump_function(ctx);
+	(void) duk_dump_heap(ctx);
 	(void) duk_dup_top(ctx);
 	(void) duk_dup(ctx, 0);
 	(void) duk_enum(ctx, 0, 0);
@@ -188,6 +189,7 @@ static duk_ret_t test_func(duk_context *ctx, void *udata) {
 	(void) duk_json_decode(ctx, 0);
 	(void) duk_json_encode(ctx, 0);
 	(void) duk_load_function(ctx);
+	(void) duk_load_heap(ctx);
 	(void) duk_map_string(ctx, 0, NULL, NULL);
 	(void) duk_new(ctx, 0);
 	(void) duk_next(ctx, 0, 0);
@@ -238,6 +240,7 @@ static duk_ret_t test_func(duk_context *ctx, void *udata) {
 	(void) duk_push_error_object_va(ctx, 0, NULL, NULL);
 	(void) duk_push_error_object(ctx, 0, "dummy");
 	(void) duk_push_external_buffer(ctx);
+	(void) duk_push_external_lstring(ctx, "dummy", 0, NULL, NULL);
 	(void) duk_push_false(ctx);
 	(void) duk_push_fixed_buffer(ctx, 0);
 	(void) duk_push_global_object(ctx);
@@ -0,0 +1,265 @@
+/*
+ *  Heap dump/load
+ */
+
+#define INIT_SOURCE ( \
+	"var counter = (function () {\n" \
+	"    var n = 0;\n" \
+	"    return function counter() { return ++n; };\n" \
+	"})();\n" \
+	"function Point(x, y) { this.x = x; this.y = y; }\n" \
+	"Point.prototype.len = function () { return Math.sqrt(this.x * this.x + this.y * this.y); };\n" \
+	"var pts = [ new Point(3, 4), new Point(6, 8) ];\n" \
+	"pts[10] = 'sparse';\n" \
+	"var obj = { get twice() { return this.v * 2; }, v: 21 };\n" \
+	"Object.defineProperty(obj, 'fixed', { value: 'ro', writable: false, enumerable: false });\n" \
+	"obj.self = obj;\n" \
+	"var frozen = Object.freeze({ a: 1 });\n" \
+	"var add5 = function (a, b) { return a + b; }.bind(null, 5);\n" \
+	"var bytes = new Uint8Array([ 1, 2, 3, 4 ]);\n" \
+	"var view = bytes.subarray(1, 3);\n" \
+	"var plain = Uint8Array.allocPlain(3); plain[0] = 0xfe;\n" \
+	"var proxy = new Proxy({}, { get: function (t, k) { return 'trap:' + String(k); } });\n" \
+	"var sym = Symbol('tag');\n" \
+	"var withSym = {}; withSym[sym] = 'symval';\n" \
+	"var str = new String('abc');\n" \
+	"var re = /a(b+)c/g;\n" \
+	"var date = new Date(0);\n" \
+	"var err = new RangeError('saved error');\n" \
+	"with (obj) { var readV = function () { return v; }; }\n" \
+	"counter(); counter();\n" \
+	"Math.extra = 'patched builtin';\n" \
+	"delete Array.prototype.lastIndexOf;\n" \
+	)
+
+#define CHECK_SOURCE ( \
+	"print(counter(), counter());\n" \
+	"print(pts[0].len(), pts[1].len(), pts.length, pts[10], 5 in pts, pts[1] instanceof Point);\n" \
+	"print(obj.twice, obj.fixed, Object.keys(obj).join(','), obj.self === obj);\n" \
+	"print(Object.isFrozen(frozen), Object.isFrozen(obj));\n" \
+	"print(add5(10), add5.length);\n" \
+	"var join = Array.prototype.join;\n" \
+	"print(join.call(bytes), join.call(view), view.byteOffset, plain[0]);\n" \
+	"view[0] = 99; print(bytes[1]);\n" \
+	"print(proxy.foo);\n" \
+	"print(String(sym), withSym[sym], Object.getOwnPropertySymbols(withSym)[0] === sym, Symbol('tag') !== sym);\n" \
+	"print(str.length, str[1], typeof str);\n" \
+	"print(re.exec('xabbbc')[1], re.lastIndex);\n" \
+	"print(date.getTime(), err.name, err.message, err instanceof RangeError);\n" \
+	"print(readV());\n" \
+	"print(Math.extra, typeof Array.prototype.lastIndexOf, typeof Array.prototype.indexOf);\n" \
+	"print(JSON.stringify({ a: [1, 2, { b: 'c' }] }));\n" \
+	)
+
+static duk_context *new_heap(void) {
+	duk_context *ctx;
+
+	ctx = duk_create_heap_default();
+	if (!ctx) {
+		printf("failed to create heap\n");
+		exit(1);
+	}
+	return ctx;
+}
+
+/* Copy the image at stack top of 'ctx' into a new heap and load it there. */
+static duk_context *clone_heap(duk_context *ctx) {
+	duk_context *new_ctx;
+	const void *src;
+	void *dst;
+	duk_size_t sz;
+
+	src = duk_require_buffer(ctx, -1, &sz);
+	new_ctx = new_heap();
+	dst = duk_push_fixed_buffer(new_ctx, sz);
+	memcpy(dst, src, sz);
+	duk_load_heap(new_ctx);
+	return new_ctx;
+}
+
+/*===
+*** test_basic (duk_safe_call)
+dump result type: 7
+load top: 0
+3 4
+5 10 11 sparse false true
+42 ro twice,v,self true
+true false
+15 1
+1,2,3,4 2,3 1 254
+99
+trap:foo
+Symbol(tag) symval true true
+3 b object
+bbb 6
+0 RangeError saved error true
+21
+patched builtin undefined function
+{"a":[1,2,{"b":"c"}]}
+second clone: 3 4
+original: 3 4
+final top: 1
+==> rc=0, result='undefined'
+===*/
+
+static duk_ret_t test_basic(duk_context *ctx, void *udata) {
+	duk_context *ctx2;
+	duk_context *ctx3;
+
+	(void) udata;
+
+	duk_eval_string_noresult(ctx, INIT_SOURCE);
+	duk_dump_heap(ctx);
+	printf("dump result type: %d\n", (int) duk_get_type(ctx, -1));
+	fflush(stdout);
+
+	ctx2 = clone_heap(ctx);
+	printf("load top: %ld\n", (long) duk_get_top(ctx2));
+	fflush(stdout);
+	duk_eval_string_noresult(ctx2, CHECK_SOURCE);
+	duk_gc(ctx2, 0);
+
+	/* Each clone is independent of the original and of other clones. */
+	ctx3 = clone_heap(ctx);
+	duk_eval_string_noresult(ctx3, "print('second clone:', counter(), counter());");
+	duk_destroy_heap(ctx3);
+	duk_destroy_heap(ctx2);
+	duk_eval_string_noresult(ctx, "print('original:', counter(), counter());");
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+/*===
+*** test_stash (duk_safe_call)
+global stash: global stash value
+heap stash: heap stash value
+thread stash: thread stash value
+==> rc=0, result='undefined'
+===*/
+
+static duk_ret_t test_stash(duk_context *ctx, void *udata) {
+	duk_context *ctx2;
+
+	(void) udata;
+
+	duk_push_global_stash(ctx);
+	duk_push_string(ctx, "global stash value");
+	duk_put_prop_string(ctx, -2, "key");
+	duk_push_heap_stash(ctx);
+	duk_push_string(ctx, "heap stash value");
+	duk_put_prop_string(ctx, -2, "key");
+	duk_push_thread_stash(ctx, ctx);
+	duk_push_string(ctx, "thread stash value");
+	duk_put_prop_string(ctx, -2, "key");
+	duk_pop_3(ctx);
+
+	duk_dump_heap(ctx);
+	ctx2 = clone_heap(ctx);
+	duk_pop(ctx);
+
+	duk_push_global_stash(ctx2);
+	duk_get_prop_string(ctx2, -1, "key");
+	printf("global stash: %s\n", duk_get_string(ctx2, -1));
+	duk_push_heap_stash(ctx2);
+	duk_get_prop_string(ctx2, -1, "key");
+	printf("heap stash: %s\n", duk_get_string(ctx2, -1));
+	duk_push_thread_stash(ctx2, ctx2);
+	duk_get_prop_string(ctx2, -1, "key");
+	printf("thread stash: %s\n", duk_get_string(ctx2, -1));
+	duk_destroy_heap(ctx2);
+	return 0;
+}
+
+/*===
+*** test_finalizer (duk_safe_call)
+finalizer in clone: true
+finalizer in original: false
+==> rc=0, result='undefined'
+===*/
+
+static duk_ret_t test_finalizer(duk_context *ctx, void *udata) {
+	duk_context *ctx2;
+
+	(void) udata;
+
+	duk_eval_string_noresult(ctx,
+		"var where = 'original';\n"
+		"var fin = { };\n"
+		"Duktape.fin(fin, function (o, heapDestruct) { print('finalizer in ' + where + ':', heapDestruct); });\n");
+	duk_dump_heap(ctx);
+	ctx2 = clone_heap(ctx);
+	duk_pop(ctx);
+	duk_eval_string_noresult(ctx2, "where = 'clone';");
+	duk_destroy_heap(ctx2);
+
+	/* Original finalizer runs when the test harness destroys the heap,
+	 * remove it to keep output predictable.
+	 */
+	duk_eval_string_noresult(ctx, "where = 'original'; fin = null; Duktape.gc();");
+	return 0;
+}
+
+/*===
+*** test_invalid_image (duk_safe_call)
+bad marker: TypeError: invalid heap image
+truncated: TypeError: invalid heap image
+==> rc=0, result='undefined'
+===*/
+
+static duk_ret_t test_invalid_image_raw(duk_context *ctx, void *udata) {
+	(void) udata;
+	duk_load_heap(ctx);
+	return 0;
+}
+
+static duk_ret_t test_invalid_image(duk_context *ctx, void *udata) {
+	duk_context *ctx2;
+	unsigned char *p;
+	duk_size_t sz;
+
+	(void) udata;
+
+	duk_dump_heap(ctx);
+	p = (unsigned char *) duk_require_buffer(ctx, -1, &sz);
+
+	ctx2 = new_heap();
+	duk_push_fixed_buffer(ctx2, sz);
+	memcpy(duk_get_buffer(ctx2, -1, NULL), p, sz);
+	((unsigned char *) duk_get_buffer(ctx2, -1, NULL))[0] = 0x00;
+	(void) duk_safe_call(ctx2, test_invalid_image_raw, NULL, 1, 1);
+	printf("bad marker: %s\n", duk_safe_to_string(ctx2, -1));
+	duk_destroy_heap(ctx2);
+
+	ctx2 = new_heap();
+	duk_push_fixed_buffer(ctx2, 30);
+	memcpy(duk_get_buffer(ctx2, -1, NULL), p, 30);
+	(void) duk_safe_call(ctx2, test_invalid_image_raw, NULL, 1, 1);
+	printf("truncated: %s\n", duk_safe_to_string(ctx2, -1));
+	duk_destroy_heap(ctx2);
+
+	duk_pop(ctx);
+	return 0;
+}
+
+/*===
+*** test_thread_unsupported (duk_safe_call)
+==> rc=1, result='TypeError: undumpable value'
+===*/
+
+static duk_ret_t test_thread_unsupported(duk_context *ctx, void *udata) {
+	(void) udata;
+
+	duk_eval_string_noresult(ctx, "var coroutine = new Duktape.Thread(function () {});");
+	duk_dump_heap(ctx);
+	printf("never here\n");
+	return 0;
+}
+
+void test(duk_context *ctx) {
+	TEST_SAFE_CALL(test_basic);
+	TEST_SAFE_CALL(test_stash);
+	TEST_SAFE_CALL(test_finalizer);
+	TEST_SAFE_CALL(test_invalid_image);
+	TEST_SAFE_CALL(test_thread_unsupported);
+}
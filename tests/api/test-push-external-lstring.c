@@ -0,0 +1,220 @@
+/*
+ *  duk_push_external_lstring()
+ *
+ *  Depending on config options the data is either referenced directly or
+ *  copied, so the output must not depend on when the release callback is
+ *  called, only that it's called once the string is no longer reachable.
+ */
+
+/*===
+*** test_basic (duk_safe_call)
+length: 300
+equals copy: 1
+key lookup: 123
+300 true true 301 ab
+data intact: 1
+released: 1 1
+final top: 0
+==> rc=0, result='undefined'
+*** test_short (duk_safe_call)
+value: short
+released: 1 1
+final top: 0
+==> rc=0, result='undefined'
+*** test_null (duk_safe_call)
+length: 0
+released: 0
+final top: 0
+==> rc=0, result='undefined'
+*** test_no_free_func (duk_safe_call)
+length: 400
+final top: 0
+==> rc=0, result='undefined'
+*** test_heap_destroy (duk_safe_call)
+before destroy: 500
+released: 1 1
+==> rc=0, result='undefined'
+*** test_symbol (duk_safe_call)
+is symbol: 1
+released: 1 1
+final top: 0
+==> rc=0, result='undefined'
+===*/
+
+static char ext_data[1024];
+static int release_count;
+static int release_args_ok;
+static duk_size_t expected_len;
+
+static void init_data(duk_size_t len) {
+	duk_size_t i;
+
+	for (i = 0; i < len; i++) {
+		ext_data[i] = (char) ('a' + (i % 2));
+	}
+	ext_data[len] = '\0';
+}
+
+static int check_data(duk_size_t len) {
+	duk_size_t i;
+
+	for (i = 0; i < len; i++) {
+		if (ext_data[i] != (char) ('a' + (i % 2))) {
+			return 0;
+		}
+	}
+	return ext_data[len] == '\0';
+}
+
+static void my_release(void *udata, const char *str, duk_size_t len) {
+	release_count++;
+	if (udata == (void *) &release_count && str == ext_data && len == expected_len) {
+		release_args_ok++;
+	}
+}
+
+static const char *push_ext(duk_context *ctx, const char *str, duk_size_t len) {
+	expected_len = len;
+	return duk_push_external_lstring(ctx, str, len, my_release, (void *) &release_count);
+}
+
+static duk_ret_t test_basic(duk_context *ctx, void *udata) {
+	(void) udata;
+
+	release_count = 0;
+	release_args_ok = 0;
+	init_data(300);
+
+	push_ext(ctx, ext_data, 300);
+	printf("length: %ld\n", (long) duk_get_length(ctx, -1));
+
+	duk_push_lstring(ctx, ext_data, 300);
+	printf("equals copy: %d\n", (int) duk_strict_equals(ctx, -1, -2));
+
+	/* Use the interned copy as a key and look it up with the external
+	 * string.
+	 */
+	duk_push_object(ctx);
+	duk_dup(ctx, -2);
+	duk_push_int(ctx, 123);
+	duk_put_prop(ctx, -3);
+	duk_dup(ctx, -3);
+	duk_get_prop(ctx, -2);
+	printf("key lookup: %ld\n", (long) duk_get_int(ctx, -1));
+	duk_pop_3(ctx);
+
+	/* Appending must create a new string and not write to the
+	 * caller's data.
+	 */
+	duk_eval_string(ctx,
+		"(function (s) {\n"
+		"    var t = s;\n"
+		"    var o = {};\n"
+		"    o[s] = true;\n"
+		"    t += 'x';\n"
+		"    print(s.length, s === 'ab'.repeat(150), o['ab'.repeat(150)], t.length, s.substring(10, 12));\n"
+		"})");
+	duk_dup(ctx, -2);
+	duk_call(ctx, 1);
+	duk_pop(ctx);
+	printf("data intact: %d\n", check_data(300));
+
+	duk_pop(ctx);
+	duk_gc(ctx, 0);
+	printf("released: %d %d\n", release_count, release_args_ok);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_short(duk_context *ctx, void *udata) {
+	(void) udata;
+
+	release_count = 0;
+	release_args_ok = 0;
+	memcpy((void *) ext_data, (const void *) "short", 6);
+
+	push_ext(ctx, ext_data, 5);
+	printf("value: %s\n", duk_get_string(ctx, -1));
+	duk_pop(ctx);
+	duk_gc(ctx, 0);
+	printf("released: %d %d\n", release_count, release_args_ok);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_null(duk_context *ctx, void *udata) {
+	(void) udata;
+
+	release_count = 0;
+	duk_push_external_lstring(ctx, NULL, 10, my_release, NULL);
+	printf("length: %ld\n", (long) duk_get_length(ctx, -1));
+	duk_pop(ctx);
+	duk_gc(ctx, 0);
+	printf("released: %d\n", release_count);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_no_free_func(duk_context *ctx, void *udata) {
+	(void) udata;
+
+	init_data(400);
+	duk_push_external_lstring(ctx, ext_data, 400, NULL, NULL);
+	printf("length: %ld\n", (long) duk_get_length(ctx, -1));
+	duk_pop(ctx);
+	duk_gc(ctx, 0);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+static duk_ret_t test_heap_destroy(duk_context *ctx, void *udata) {
+	duk_context *ctx2;
+
+	(void) ctx;
+	(void) udata;
+
+	release_count = 0;
+	release_args_ok = 0;
+	init_data(500);
+
+	ctx2 = duk_create_heap_default();
+	push_ext(ctx2, ext_data, 500);
+	duk_put_global_string(ctx2, "ext");
+	duk_eval_string(ctx2, "ext.length");
+	printf("before destroy: %ld\n", (long) duk_get_int(ctx2, -1));
+	duk_destroy_heap(ctx2);
+	printf("released: %d %d\n", release_count, release_args_ok);
+	return 0;
+}
+
+static duk_ret_t test_symbol(duk_context *ctx, void *udata) {
+	(void) udata;
+
+	/* Symbol representation is always interned, i.e. copied. */
+	release_count = 0;
+	release_args_ok = 0;
+	init_data(300);
+	ext_data[0] = (char) 0x80;
+
+	push_ext(ctx, ext_data, 300);
+	printf("is symbol: %ld\n", (long) duk_is_symbol(ctx, -1));
+	duk_pop(ctx);
+	duk_gc(ctx, 0);
+	printf("released: %d %d\n", release_count, release_args_ok);
+
+	printf("final top: %ld\n", (long) duk_get_top(ctx));
+	return 0;
+}
+
+void test(duk_context *ctx) {
+	TEST_SAFE_CALL(test_basic);
+	TEST_SAFE_CALL(test_short);
+	TEST_SAFE_CALL(test_null);
+	TEST_SAFE_CALL(test_no_free_func);
+	TEST_SAFE_CALL(test_heap_destroy);
+	TEST_SAFE_CALL(test_symbol);
+}
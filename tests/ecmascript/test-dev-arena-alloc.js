@@ -0,0 +1,154 @@
+/*
+ *  Allocation patterns for the arena allocator (DUK_USE_ALLOC_ARENA):
+ *  blocks of every size class up to and past the large block limit,
+ *  blocks growing in place and being moved, freed blocks being reused,
+ *  and finalizers running both before and during heap destruction.  The
+ *  results must be the same whether or not the arena is enabled.
+ */
+
+/*===
+sizes
+true
+grow
+100000 4999950000
+abcabcabca 30000
+large
+8192 16384 4100 100 20000 20000 0 true
+reuse
+20000 4000
+finalizers
+100 true
+done
+finalizer during heap destruction: true
+===*/
+
+function testSizes() {
+    var arr = [], i, j, ok = true;
+
+    // Buffer data sizes 0..5000 cover all classes and the switch to large
+    // blocks at 4kB.
+    for (i = 0; i <= 5000; i += 7) {
+        arr.push(new Uint8Array(i));
+        for (j = 0; j < i; j += 97) {
+            arr[arr.length - 1][j] = (i + j) & 0xff;
+        }
+    }
+    for (i = 0; i < arr.length; i++) {
+        for (j = 0; j < arr[i].length; j += 97) {
+            if (arr[i][j] !== ((i * 7 + j) & 0xff)) {
+                ok = false;
+            }
+        }
+    }
+    print(ok);
+}
+
+function testGrow() {
+    var arr = [], i, sum = 0, str = '';
+
+    // Array part and value stack growth, interleaved and not.
+    for (i = 0; i < 100000; i++) {
+        arr.push(i);
+    }
+    for (i = 0; i < arr.length; i++) {
+        sum += arr[i];
+    }
+    print(arr.length, sum);
+
+    for (i = 0; i < 10000; i++) {
+        str += 'abc';
+    }
+    print(str.substring(0, 10), str.length);
+}
+
+function testLarge() {
+    var res = [], b, i, ok = true;
+
+    // Buffers on both sides of the large block limit, string building
+    // growing a temporary buffer past the limit.
+    b = Uint8Array.allocPlain(8192);
+    res.push(b.length);
+    b = Uint8Array.allocPlain(16384);
+    res.push(b.length);
+    for (i = 0; i < 4100; i++) {
+        b[i] = i & 0xff;
+    }
+    b = new Uint8Array(b.subarray(0, 4100));
+    res.push(b.length);
+    for (i = 0; i < b.length; i++) {
+        if (b[i] !== (i & 0xff)) {
+            ok = false;
+        }
+    }
+    b = new Uint8Array(b.subarray(0, 100));
+    res.push(b.length);
+    res.push(new Array(10001).join('xy').length);
+
+    // Many large blocks alive at once, then all freed.
+    b = [];
+    for (i = 0; i < 20; i++) {
+        b.push(new Uint8Array(1000 * (i + 5)));
+    }
+    res.push(b[15].length);
+    b = null;
+    res.push(0);
+    print(res.join(' '), ok);
+}
+
+function testReuse() {
+    var i, j, o, keep = [];
+
+    // Lots of short-lived garbage, both refcount and cycle collected;
+    // freed blocks must be reused and stay intact.
+    for (i = 0; i < 20000; i++) {
+        o = { a: i, b: [ i, i + 1 ], c: 'str' + i };
+        o.self = o;
+        if ((i % 5) === 0) {
+            keep.push(o);
+        }
+    }
+    Duktape.gc();
+    for (j = 0; j < 1000; j++) {
+        o = { x: new Array(j % 50) };
+    }
+    for (i = 0; i < keep.length; i++) {
+        if (keep[i].a !== i * 5 || keep[i].b[1] !== i * 5 + 1 || keep[i].c !== 'str' + (i * 5)) {
+            throw new Error('mismatch at ' + i);
+        }
+    }
+    print(i * 5, keep.length);
+}
+
+function testFinalizers() {
+    var count = 0, i, o;
+
+    for (i = 0; i < 100; i++) {
+        o = { id: i };
+        Duktape.fin(o, function () { count++; });
+    }
+    o = null;
+    Duktape.gc();
+    print(count, count === 100);
+
+    o = { live: true };
+    Duktape.fin(o, function (v, heapDestruct) {
+        print('finalizer during heap destruction:', heapDestruct);
+    });
+    globalThis.keepAlive = o;
+}
+
+try {
+    print('sizes');
+    testSizes();
+    print('grow');
+    testGrow();
+    print('large');
+    testLarge();
+    print('reuse');
+    testReuse();
+    print('finalizers');
+    testFinalizers();
+} catch (e) {
+    print(e.stack || e);
+}
+print('done');
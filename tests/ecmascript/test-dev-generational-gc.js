@@ -0,0 +1,215 @@
+/*
+ *  Exercise heap patterns which a generational mark-and-sweep
+ *  (DUK_USE_MARK_AND_SWEEP_GENERATIONAL) must handle: references from old
+ *  objects to young ones, young and mixed cycles, promoted objects dying,
+ *  finalizers, threads, and explicit GC requests between minor collections.
+ *  The results must be the same whether or not generational collection is
+ *  enabled.
+ */
+
+/*===
+old to young
+10000 49995000
+young cycles
+99 1999
+promoted garbage
+true
+mixed cycles
+true
+finalizers
+true
+rescue
+2 true
+threads
+55
+explicit gc
+5000 yes
+done
+===*/
+
+// Allocate short lived garbage so that minor collections run often.
+function churn(n) {
+    var i, t;
+    for (i = 0; i < n; i++) {
+        t = { x: i, y: [ i ], z: 'churn' + (i % 100) };
+        t.self = t;
+    }
+}
+
+function testOldToYoung() {
+    var old = [], holder = {}, i, sum = 0;
+
+    // Make 'old' and 'holder' survive several collections first.
+    for (i = 0; i < 10; i++) {
+        old.push({ i: i });
+        churn(2000);
+    }
+
+    // New objects are only referenced from old objects.
+    for (i = 0; i < 10000; i++) {
+        holder['k' + i] = { v: i };
+        if ((i % 100) === 0) {
+            churn(100);
+        }
+    }
+    churn(5000);
+    for (i = 0; i < 10000; i++) {
+        sum += holder['k' + i].v;
+    }
+    print(i, sum);
+}
+
+function testYoungCycles() {
+    var head = null, node, i, count = 0;
+
+    for (i = 0; i < 2000; i++) {
+        node = { next: head, id: i };
+        node.self = node;
+        head = node;
+        if ((i % 100) === 0) {
+            head = null;
+            churn(100);
+        }
+    }
+    churn(5000);
+    for (node = head; node !== null; node = node.next) {
+        count++;
+    }
+    print(count, head.id);
+}
+
+function testPromotedGarbage() {
+    var arr = [], i, ok = true;
+
+    // Let a cyclic structure become old, then drop it.  Only a full
+    // collection can free it, and it must not affect live objects.
+    for (i = 0; i < 3000; i++) {
+        arr.push({ id: i, arr: arr });
+    }
+    churn(10000);
+    arr = null;
+    churn(10000);
+    Duktape.gc();
+    arr = [];
+    for (i = 0; i < 1000; i++) {
+        arr.push({ id: i });
+        churn(10);
+    }
+    for (i = 0; i < 1000; i++) {
+        if (arr[i].id !== i) {
+            ok = false;
+        }
+    }
+    print(ok);
+}
+
+function testMixedCycles() {
+    var old = { name: 'old' }, young, i, finalized = 0;
+
+    churn(10000);
+
+    // A young object referenced by an old garbage object survives minor
+    // collections but is reclaimed by a full collection.
+    for (i = 0; i < 100; i++) {
+        young = { back: old };
+        Duktape.fin(young, function () { finalized++; });
+        old['y' + i] = young;
+        churn(50);
+    }
+    young = null;
+    old = null;
+    Duktape.gc();
+    Duktape.gc();
+    print(finalized === 100);
+}
+
+function testFinalizers() {
+    var finalized = 0, i, o;
+
+    for (i = 0; i < 500; i++) {
+        o = { id: i };
+        o.self = o;
+        Duktape.fin(o, function () { finalized++; });
+        churn(10);
+    }
+    o = null;
+    churn(5000);
+    Duktape.gc();
+    Duktape.gc();
+    print(finalized === 500);
+}
+
+function testRescue() {
+    var saved = [], count = 0, i, o;
+
+    for (i = 0; i < 2; i++) {
+        o = { id: i };
+        o.self = o;
+        Duktape.fin(o, function (obj) {
+            count++;
+            saved.push(obj);
+        });
+    }
+    o = null;
+    churn(5000);
+    Duktape.gc();
+    Duktape.gc();
+    churn(5000);
+    print(saved.length, count === 2 && saved[0].self === saved[0]);
+}
+
+function testThreads() {
+    var t = new Duktape.Thread(function (v) {
+        var sum = 0, i;
+        for (i = 0; i < 10; i++) {
+            churn(500);
+            sum += Duktape.Thread.yield({ v: i + v }).v;
+        }
+        return sum;
+    });
+    var res, i;
+
+    res = Duktape.Thread.resume(t, 1);
+    for (i = 0; i < 10; i++) {
+        churn(500);
+        res = Duktape.Thread.resume(t, { v: res.v });
+    }
+    print(res);
+}
+
+function testExplicitGc() {
+    var keep = [], i;
+
+    for (i = 0; i < 5000; i++) {
+        keep.push({ v: i, s: 'str' + i });
+        if ((i % 500) === 0) {
+            Duktape.gc();
+        }
+        churn(2);
+    }
+    churn(1000);
+    Duktape.gc();
+    print(keep.length, keep[4999].s === 'str4999' && keep[0].v === 0 ? 'yes' : 'no');
+}
+
+try {
+    print('old to young');
+    testOldToYoung();
+    print('young cycles');
+    testYoungCycles();
+    print('promoted garbage');
+    testPromotedGarbage();
+    print('mixed cycles');
+    testMixedCycles();
+    print('finalizers');
+    testFinalizers();
+    print('rescue');
+    testRescue();
+    print('threads');
+    testThreads();
+    print('explicit gc');
+    testExplicitGc();
+} catch (e) {
+    print(e.stack || e);
+}
+print('done');
@@ -0,0 +1,206 @@
+/*
+ *  Exercise heap mutation patterns which an incremental mark-and-sweep
+ *  (DUK_USE_MARK_AND_SWEEP_INCREMENTAL) must handle while a collection
+ *  cycle is in progress: references moved between objects and value stacks,
+ *  objects created during marking, finalizers, and explicit GC requests in
+ *  the middle of a cycle.  The results must be the same whether or not
+ *  incremental collection is enabled.
+ */
+
+/*===
+moved references
+20000 199990000
+push and apply
+3000 4498500 3000
+catch and with
+99 with 99
+cycles
+99 1999
+finalizers
+true
+explicit gc
+5000 yes
+proxy
+100 true
+threads
+55
+done
+===*/
+
+// Allocate some garbage so that GC slices run in the middle of the tests.
+function churn(n) {
+    var i, t;
+    for (i = 0; i < n; i++) {
+        t = { x: i, y: [ i ], z: 'churn' + (i % 100) };
+        t.self = t;
+    }
+}
+
+function testMoved() {
+    var a = [], b = {}, i, sum = 0;
+
+    // References exist only in a live object, are moved to another object
+    // and the original slot is cleared.
+    for (i = 0; i < 20000; i++) {
+        a[i] = { v: i };
+    }
+    for (i = 0; i < 20000; i++) {
+        b['k' + i] = a[i];
+        a[i] = null;
+        if ((i % 1000) === 0) {
+            churn(200);
+        }
+    }
+    churn(2000);
+    for (i = 0; i < 20000; i++) {
+        sum += b['k' + i].v;
+    }
+    print(i, sum);
+}
+
+function testPushApply() {
+    var src = [], dst = [], i, sum = 0;
+
+    for (i = 0; i < 3000; i++) {
+        src.push({ v: i });
+    }
+    while (src.length > 0) {
+        // Array.prototype.pop() and push() move values between the array
+        // and the value stack without refcount updates.
+        dst.push(src.pop(), src.pop(), src.pop());
+        churn(20);
+    }
+    dst = Array.prototype.concat.apply([], dst.map(function (x) { return [ x ]; }));
+    churn(1000);
+    for (i = 0; i < dst.length; i++) {
+        sum += dst[i].v;
+    }
+    print(dst.length, sum, Math.max.apply(null, dst.map(function (x) { return x.v; })) + 1);
+}
+
+function testCatchWith() {
+    var i, res, obj;
+
+    for (i = 0; i < 100; i++) {
+        try {
+            throw { v: i };
+        } catch (e) {
+            churn(50);
+            res = (function () { return e.v; })();
+        }
+    }
+    print(res, (function () {
+        obj = { w: 'with' };
+        with (obj) {
+            churn(500);
+            return w;
+        }
+    })(), res);
+}
+
+function testCycles() {
+    var head = null, node, i, count = 0;
+
+    for (i = 0; i < 2000; i++) {
+        node = { next: head, id: i };
+        node.self = node;
+        head = node;
+        if ((i % 100) === 0) {
+            // Drop the list so that it becomes cyclic garbage.
+            head = null;
+            churn(100);
+        }
+    }
+    Duktape.gc();
+    for (node = head; node !== null; node = node.next) {
+        count++;
+    }
+    print(count, head.id);
+}
+
+function testFinalizers() {
+    var finalized = 0, i, o;
+
+    for (i = 0; i < 500; i++) {
+        o = { id: i };
+        o.self = o;  // Cycle, needs mark-and-sweep.
+        Duktape.fin(o, function () { finalized++; });
+        churn(10);
+    }
+    o = null;
+    Duktape.gc();
+    Duktape.gc();
+    print(finalized === 500);
+}
+
+function testExplicitGc() {
+    var keep = [], i;
+
+    for (i = 0; i < 5000; i++) {
+        keep.push({ v: i, s: 'str' + i });
+        if ((i % 500) === 0) {
+            // Explicit GC must finish any incremental cycle in progress.
+            Duktape.gc();
+        }
+    }
+    churn(1000);
+    Duktape.gc();
+    print(keep.length, keep[4999].s === 'str4999' && keep[0].v === 0 ? 'yes' : 'no');
+}
+
+function testProxy() {
+    var proxies = [], i, ok = true;
+
+    for (i = 0; i < 100; i++) {
+        proxies.push(new Proxy({ v: i }, { get: function (t, k) { return t[k]; } }));
+        churn(20);
+    }
+    churn(1000);
+    for (i = 0; i < 100; i++) {
+        if (proxies[i].v !== i) {
+            ok = false;
+        }
+    }
+    print(proxies.length, ok);
+}
+
+function testThreads() {
+    var t = new Duktape.Thread(function (v) {
+        var sum = 0, i;
+        for (i = 0; i < 10; i++) {
+            churn(200);
+            sum += Duktape.Thread.yield({ v: i + v }).v;
+        }
+        return sum;
+    });
+    var res, i;
+
+    res = Duktape.Thread.resume(t, 1);
+    for (i = 0; i < 10; i++) {
+        churn(100);
+        res = Duktape.Thread.resume(t, { v: res.v });
+    }
+    print(res);
+}
+
+try {
+    print('moved references');
+    testMoved();
+    print('push and apply');
+    testPushApply();
+    print('catch and with');
+    testCatchWith();
+    print('cycles');
+    testCycles();
+    print('finalizers');
+    testFinalizers();
+    print('explicit gc');
+    testExplicitGc();
+    print('proxy');
+    testProxy();
+    print('threads');
+    testThreads();
+} catch (e) {
+    print(e.stack || e);
+}
+print('done');
@@ -0,0 +1,159 @@
+/*
+ *  Objects with the same property insertion order may share a shape
+ *  (DUK_USE_HOBJECT_SHAPES).  Exercise operations which must convert a
+ *  shaped object into an ordinary one, and check that objects sharing a
+ *  shape don't affect each other.  The results must be the same whether
+ *  or not shapes are enabled.
+ */
+
+/*===
+shared
+0 0 a0
+999 1998 a999
+x,y,z x,y,z
+delete
+{"x":1,"z":3} {"x":1,"y":2,"z":3}
+{"x":1,"z":3,"y":4}
+attributes
+x,y y
+{"x":1,"y":2}
+true false
+freeze
+1 true
+{"x":1,"y":2}
+accessor
+getter 1
+3 false
+many keys
+0 63 64 199 200
+k0,k1,k2 k197,k198,k199
+undefined
+200
+different flags
+true false
+1 2
+array index keys
+{"0":1,"1":3,"x":2}
+enumeration order
+b,a,c b,a,c
+json
+2 b true
+object create
+2 q,w
+define property
+1,2,3
+done
+===*/
+
+function test() {
+    var arr = [];
+    var i, o, o2, k;
+
+    print('shared');
+    for (i = 0; i < 1000; i++) {
+        arr.push({ x: i, y: i * 2, z: 'a' + i });
+    }
+    print(arr[0].x, arr[0].y, arr[0].z);
+    print(arr[999].x, arr[999].y, arr[999].z);
+    print(Object.keys(arr[0]).join(), Object.keys(arr[999]).join());
+
+    print('delete');
+    o = { x: 1, y: 2, z: 3 };
+    o2 = { x: 1, y: 2, z: 3 };
+    delete o.y;
+    print(JSON.stringify(o), JSON.stringify(o2));
+    o.y = 4;
+    print(JSON.stringify(o));
+
+    print('attributes');
+    o = { x: 1, y: 2 };
+    o2 = { x: 1, y: 2 };
+    Object.defineProperty(o, 'x', { enumerable: false });
+    print(Object.getOwnPropertyNames(o).join(), Object.keys(o).join());
+    print(JSON.stringify(o2));
+    print(Object.getOwnPropertyDescriptor(o2, 'x').enumerable,
+          Object.getOwnPropertyDescriptor(o, 'x').enumerable);
+
+    print('freeze');
+    o = { x: 1, y: 2 };
+    o2 = { x: 1, y: 2 };
+    Object.freeze(o);
+    o.x = 10;
+    print(o.x, Object.isFrozen(o));
+    o2.x = 1;
+    print(JSON.stringify(o2));
+
+    print('accessor');
+    o = { x: 1 };
+    Object.defineProperty(o, 'g', { get: function () { return 'getter'; }, configurable: true });
+    print(o.g, o.x);
+    Object.defineProperty(o, 'g', { value: 3 });
+    print(o.g, Object.getOwnPropertyDescriptor(o, 'g').writable);
+
+    print('many keys');
+    o = {};
+    for (i = 0; i < 200; i++) {
+        o['k' + i] = i;
+    }
+    print(o.k0, o.k63, o.k64, o.k199, Object.keys(o).length);
+    print(Object.keys(o).slice(0, 3).join(), Object.keys(o).slice(-3).join());
+    print(o.nonexistent);
+    o2 = {};
+    for (i = 0; i < 200; i++) {
+        o2['k' + i] = i;
+    }
+    k = 0;
+    for (i = 0; i < 200; i++) {
+        k += o2['k' + i] - i;
+    }
+    print(k + 200);
+
+    print('different flags');
+    o = {};
+    o.x = 1;
+    o2 = {};
+    Object.defineProperty(o2, 'x', { value: 2, writable: true, enumerable: false, configurable: true });
+    print(Object.getOwnPropertyDescriptor(o, 'x').enumerable,
+          Object.getOwnPropertyDescriptor(o2, 'x').enumerable);
+    print(o.x, o2.x);
+
+    print('array index keys');
+    o = {};
+    o[0] = 1;
+    o.x = 2;
+    o[1] = 3;
+    print(JSON.stringify(o));
+
+    print('enumeration order');
+    o = { b: 1, a: 2, c: 3 };
+    o2 = { b: 1, a: 2, c: 3 };
+    k = [];
+    for (i in o) {
+        k.push(i);
+    }
+    print(k.join(), Object.keys(o2).join());
+
+    print('json');
+    arr = JSON.parse('[{"id":1,"n":"a"},{"id":2,"n":"b"},{"id":3,"n":"c","extra":true}]');
+    print(arr[1].id, arr[1].n, arr[2].extra);
+
+    print('object create');
+    o = Object.create(null);
+    o.q = 1;
+    o.w = 2;
+    print(o.w, Object.keys(o).join());
+
+    print('define property');
+    o = {};
+    Object.defineProperties(o, { a: { value: 1, enumerable: true },
+                                 b: { value: 2, enumerable: true },
+                                 c: { value: 3, enumerable: true } });
+    print([ o.a, o.b, o.c ].join());
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+}
+print('done');
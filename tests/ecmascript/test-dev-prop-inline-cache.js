@@ -0,0 +1,131 @@
+/*
+ *  Exercise GETPROP/PUTPROP inline caches (DUK_USE_EXEC_INLINE_CACHE).
+ *  The same call site is hit with objects whose property layout changes
+ *  so that cached slots go stale in various ways.
+ */
+
+/*===
+polymorphic
+1 2 3 4 5
+1 2 3 4 5
+delete
+undefined
+re-added
+accessor
+getter
+getter
+proto change
+proto
+own
+length
+9 8 3 3 4
+put
+2
+TypeError
+2
+3
+x new
+proxy
+proxy-x
+arguments
+2 10
+many props
+199 199
+done
+===*/
+
+function getX(o) {
+    return o.x;
+}
+
+function putX(o, v) {
+    'use strict';
+    o.x = v;
+}
+
+function getLength(o) {
+    return o.length;
+}
+
+function test() {
+    var a, b, c, d, e, i, o, p, arr;
+
+    print('polymorphic');
+    a = { x: 1 };
+    b = { y: 0, x: 2 };
+    c = Object.create({ x: 3 });
+    d = Object.create({ z: 0, w: 0, x: 4 });
+    e = Object.create(b);
+    e.x = 5;
+    for (i = 0; i < 2; i++) {
+        print(getX(a), getX(b), getX(c), getX(d), getX(e));
+    }
+
+    print('delete');
+    getX(a);
+    delete a.x;
+    print(getX(a));
+    a.y = 'dummy';
+    a.x = 're-added';
+    print(getX(a));
+
+    print('accessor');
+    getX(b);
+    Object.defineProperty(b, 'x', { get: function () { return 'getter'; } });
+    print(getX(b));
+    print(getX(Object.create(b)));
+
+    print('proto change');
+    o = Object.create({ x: 'proto' });
+    print(getX(o));
+    o.x = 'own';  // shadows the cached prototype slot
+    print(getX(o));
+
+    print('length');
+    arr = [ 1, 2, 3 ];
+    print(getLength({ length: 9 }), getLength(Object.create({ length: 8 })),
+          getLength(arr), getLength('abc'), getLength(new String('abcd')));
+
+    print('put');
+    o = { x: 1 };
+    putX(o, 2);
+    print(o.x);
+    Object.freeze(o);
+    try {
+        putX(o, 3);
+    } catch (err) {
+        print(err.name);
+    }
+    print(o.x);
+    o = { x: 0 };
+    putX(o, 3);
+    print(o.x);
+    o = Object.create({ x: 1 });
+    putX(o, 'new');
+    print(Object.getOwnPropertyNames(o).join(','), o.x);
+
+    print('proxy');
+    p = new Proxy({ x: 'target' }, { get: function (t, k) { return 'proxy-' + k; } });
+    print(getX(p));
+
+    print('arguments');
+    (function (x) {
+        arguments.x = 2;
+        print(getX(arguments), arguments.length * 10);
+    })(1);
+
+    print('many props');
+    o = {};
+    for (i = 0; i < 200; i++) {
+        o['key' + i] = i;
+    }
+    o.x = 199;  // beyond cacheable slot range
+    print(getX(o), getX(o));
+}
+
+try {
+    test();
+    print('done');
+} catch (e) {
+    print(e.stack || e);
+}
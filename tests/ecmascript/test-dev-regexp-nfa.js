@@ -0,0 +1,105 @@
+/*
+ *  Non-backtracking regexp matching (DUK_USE_REGEXP_NFA): patterns with
+ *  nested quantifiers must complete, and matches and captures must be the
+ *  same as with backtracking.
+ */
+
+/*===
+catastrophic
+null true
+null ["aaaab","aaaa"]
+null ["word0 word1 word2 word3 word4 word5 word6 word7","word7"]
+empty loops
+["aab"] ["",null] ["b",null] ["",""]
+captures
+["abab","b",null] ["acb",null,null] ["aaab","","aaa","b"]
+["xaycxbz","c","b","z"] ["xyz",null]
+quantifiers
+["aaa"] ["abab"] ["aaaa","aa"] ["aa","a"]
+["yzz"] 1 ["bbac"] ["aab"]
+long input
+40001 true "ab"
+split and replace
+["a",".","b",".","c"] "<aa>-<b>-<aa>" "[]x[b][]x[]"
+backtracking features
+["aba","a"] ["aaab","aaa"] ["aaa","a"]
+===*/
+
+function pad(n, s) {
+    var res = [];
+    var i;
+    for (i = 0; i < n; i++) {
+        res.push(s);
+    }
+    return res.join('');
+}
+
+function show() {
+    print(Array.prototype.map.call(arguments, function (v) {
+        return JSON.stringify(v);
+    }).join(' '));
+}
+
+function testCatastrophic() {
+    var a = pad(25, 'a');
+    var words = [];
+    var i;
+
+    for (i = 0; i < 8; i++) {
+        words.push('word' + i);
+    }
+
+    show(/(a+)+b/.exec(a), /(a|aa)+$/.test(a));
+    show(/(x+x+)+y/.exec(pad(25, 'x')), /(a*)*b/.exec('aaaab'));
+    show(/^(\w+\s?)*$/.exec(words.join(' ') + '!'), /^(\w+\s?)*$/.exec(words.join(' ')));
+}
+
+function testEmptyLoops() {
+    show(/(?:a|)*b/.exec('aab'), /(a|)*$/.exec('aab'), /(a*)*b/.exec('b'), /(a*)+/.exec('b'));
+}
+
+function testCaptures() {
+    // Captures are reset at the start of each iteration of a quantified group.
+    show(/((a)|b)+/.exec('abab'), /(?:(a)|(c)|b)+/.exec('acb'), /(a*?)(a+)(b?)/.exec('aaab'));
+    show(/x(?:a|b)y(c|)x(b)(z)?/.exec('xaycxbz'), /(?:(x)|y)*z/.exec('xyz'));
+}
+
+function testQuantifiers() {
+    show(/a{2,3}/.exec('xaaaab'), /(?:ab){2,}?c*/.exec('abababd'), /(a{2}){1,2}/.exec('aaaaa'), /(a)+?a/.exec('aaa'));
+    show(/x{0}y?z+/.exec('yzz'), /\d{2,4}?-/.exec('12345-').index, /[ab]{1,3}?c/.exec('abbbac'), /(?:a?){3}b/.exec('aab'));
+}
+
+function testLongInput() {
+    // Deep recursion for the backtracking matcher.
+    var s = pad(20000, 'ab') + 'c';
+
+    show(/(?:ab)*c/.exec(s)[0].length, /(?:ab|a)*c/.test(s), /(ab)*c/.exec(s)[1]);
+}
+
+function testSplitReplace() {
+    show('a.b.c'.split(/(\.)/), 'aa-b-aa'.replace(/(?:a|b)+/g, '<$&>'), 'xaabx'.replace(/(a|b)*/g, '[$1]'));
+}
+
+function testBacktrackingFeatures() {
+    // Backreferences and lookaheads always use the backtracking matcher.
+    show(/(a)b\1/.exec('xaba'), /(?=(a+))a*b/.exec('baaab'), /(?!b)(a)+/.exec('baaa'));
+}
+
+try {
+    print('catastrophic');
+    testCatastrophic();
+    print('empty loops');
+    testEmptyLoops();
+    print('captures');
+    testCaptures();
+    print('quantifiers');
+    testQuantifiers();
+    print('long input');
+    testLongInput();
+    print('split and replace');
+    testSplitReplace();
+    print('backtracking features');
+    testBacktrackingFeatures();
+} catch (e) {
+    print(e.stack || e);
+}
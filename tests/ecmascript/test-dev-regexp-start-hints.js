@@ -0,0 +1,165 @@
+/*
+ *  RegExp start hints (DUK_USE_REGEXP_START_HINTS): anchoring, first
+ *  character sets, and literal prefixes are used to skip input offsets
+ *  which can't start a match.  Results must be the same as without them.
+ */
+
+/*===
+anchored
+0 null 0 null
+true 0
+multiline 4 7
+prefix
+1000 foobar
+1000 null
+2 4
+ab,ab,ab 3
+firstset
+1000 x5
+1001 y 1002
+null
+empty
+0 0 0 a,b
+2 x
+ignorecase
+1000 FooBar
+1001 q
+nonascii
+1001 xay 1001
+2 b
+1 b
+zero-width
+1001 b
+999 abc
+3 7
+lastindex 1002 1005 1008 null 0
+replace
+a-b-c ,b,c
+split
+4 a|b|c|d
+===*/
+
+function pad(n, s) {
+    var res = [];
+    var i;
+    for (i = 0; i < n; i++) {
+        res.push(s);
+    }
+    return res.join('');
+}
+
+function testAnchored() {
+    var s = pad(1000, 'a') + 'b';
+    var re = /^a+b/g;
+    var m;
+
+    m = /^a/.exec(s);
+    print(m.index, /^b/.exec(s), re.exec(s).index, re.exec(s));
+
+    // Global regexp with lastIndex past input start can't match.
+    re.lastIndex = 1;
+    print(re.exec(s) === null, re.lastIndex);
+
+    m = /^b/m.exec('aaa\nbbb');
+    print('multiline', m.index, /^b$/m.exec('aaa\ncc\nb').index);
+}
+
+function testPrefix() {
+    var s = pad(1000, 'x') + 'foobar' + 'foo';
+    var m;
+
+    m = /foo(bar)?/.exec(s);
+    print(m.index, m[0]);
+    print(/foo(bar)?/.exec(s.substring(0, 1003) + 'fo' + 'o').index, /foobar/.exec(s.substring(1003)));
+
+    // Prefix followed by quantified atom, partial prefix candidates.
+    print(/aab*/.exec('abaaab').index, /ab+c/.exec('abababbc').index);
+    print(pad(3, 'ab').match(/ab/g).join(','), 'ab,ab,ab'.split(/,/).length);
+}
+
+function testFirstSet() {
+    var s = pad(1000, '-') + 'x5' + 'y';
+
+    print(/[xyz]\d|y/.exec(s).index, /[xyz]\d|y/.exec(s)[0]);
+    print(/(?:\d+|y)/.exec(s).index, /y/.exec(s)[0], /[^-x5]/.exec(s).index);
+    print(/z|w/.exec(s));
+}
+
+function testEmpty() {
+    // Patterns which may match empty have no first character set.
+    print(/x*/.exec('aaax').index, /(?:a|)/.exec('bbb').index, /$/.exec('').index,
+          'axb'.split(/x*/).join(','));
+    print(/x?$/.exec('aax').index, /x?$/.exec('aax')[0]);
+}
+
+function testIgnoreCase() {
+    var s = pad(1000, 'z') + 'FooBar';
+
+    print(/foobar/i.exec(s).index, /FOOBAR/i.exec(s)[0]);
+    print(/[p-r]/i.exec(pad(1001, 'z') + 'q').index, /[p-r]/i.exec(pad(1001, 'z') + 'q')[0]);
+}
+
+function testNonAscii() {
+    var s = pad(1000, 'ä') + '€xay';
+    var m;
+
+    m = /x.y/.exec(s);
+    print(m.index, m[0], /xay/.exec(s).index);
+    print(/b/.exec('ääb').index, /b/.exec('ääb')[0]);
+    print(/[^ä]/.exec('äb').index, /[^ä]/.exec('äb')[0]);
+}
+
+function testZeroWidth() {
+    var s = pad(1000, 'a') + ' b';
+    var m;
+
+    print(/\bb/.exec(s).index, /\bb/.exec(s)[0]);
+    m = /(?=abc)a../.exec(pad(1000, 'a') + 'bc');
+    print(m.index, m[0]);
+    print(/(a)\1/.exec('xyzaa').index, /(?!a)[a-z]/.exec('aaaaaaab').index);
+}
+
+function testLastIndex() {
+    var re = /ab/g;
+    var s = pad(1000, '.') + '..ab.ab.ab';
+    var res = [];
+    var m;
+
+    while ((m = re.exec(s)) !== null) {
+        res.push(m.index);
+    }
+    print('lastindex', res.join(' '), m, re.lastIndex);
+}
+
+function testReplace() {
+    print('a b c'.replace(/ /g, '-'), 'a,b,c'.replace(/a/, ''));
+}
+
+function testSplit() {
+    var parts = 'a|b|c|d'.split(/\|/);
+    print(parts.length, parts.join('|'));
+}
+
+try {
+    print('anchored');
+    testAnchored();
+    print('prefix');
+    testPrefix();
+    print('firstset');
+    testFirstSet();
+    print('empty');
+    testEmpty();
+    print('ignorecase');
+    testIgnoreCase();
+    print('nonascii');
+    testNonAscii();
+    print('zero-width');
+    testZeroWidth();
+    testLastIndex();
+    print('replace');
+    testReplace();
+    print('split');
+    testSplit();
+} catch (e) {
+    print(e.stack || e);
+}
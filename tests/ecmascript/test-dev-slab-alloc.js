@@ -0,0 +1,147 @@
+/*
+ *  Allocation patterns around the size class boundaries of the slab
+ *  allocator (DUK_USE_ALLOC_SLAB): strings and buffers of every small
+ *  size, reallocations moving between classes and to and from large
+ *  allocations, and pages becoming empty and reused.  The results must be
+ *  the same whether or not the slab allocator is enabled.
+ */
+
+/*===
+strings
+300 44850 true
+buffers
+300 true
+realloc
+0 1 64 65 300 1000 100 10 0
+properties
+1 8 9 33 100 ok
+pages
+20000 199990000
+5000 12497500
+done
+===*/
+
+function testStrings() {
+    var arr = [], i, total = 0, ok = true;
+
+    for (i = 0; i < 300; i++) {
+        arr.push(new Array(i + 1).join('x'));
+    }
+    for (i = 0; i < 300; i++) {
+        total += arr[i].length;
+        if (arr[i].charAt(i - 1) !== (i > 0 ? 'x' : '')) {
+            ok = false;
+        }
+    }
+    print(arr.length, total, ok);
+}
+
+function testBuffers() {
+    var arr = [], i, j, ok = true;
+
+    for (i = 0; i < 300; i++) {
+        arr.push(new Uint8Array(i));
+        for (j = 0; j < i; j++) {
+            arr[i][j] = (i + j) & 0xff;
+        }
+    }
+    for (i = 0; i < 300; i++) {
+        for (j = 0; j < i; j++) {
+            if (arr[i][j] !== ((i + j) & 0xff)) {
+                ok = false;
+            }
+        }
+    }
+    print(arr.length, ok);
+}
+
+function testRealloc() {
+    var arr = [], res = [], i;
+
+    // Array part grows through small classes into a large allocation and
+    // shrinks back, contents must be preserved each time.
+    function check() {
+        for (var k = 0; k < arr.length; k++) {
+            if (arr[k] !== k) {
+                throw new Error('mismatch at ' + k);
+            }
+        }
+        res.push(arr.length);
+    }
+    check();
+    [ 1, 64, 65, 300, 1000, 100, 10, 0 ].forEach(function (n) {
+        if (n > arr.length) {
+            for (i = arr.length; i < n; i++) {
+                arr.push(i);
+            }
+        } else {
+            arr.length = n;
+        }
+        Duktape.compact(arr);
+        check();
+    });
+    print(res.join(' '));
+}
+
+function testProperties() {
+    var res = [], counts = [ 1, 8, 9, 33, 100 ];
+
+    counts.forEach(function (n) {
+        var o = {}, i;
+        for (i = 0; i < n; i++) {
+            o['p' + i] = i;
+        }
+        for (i = 0; i < n; i++) {
+            if (o['p' + i] !== i) {
+                throw new Error('mismatch');
+            }
+        }
+        res.push(Object.keys(o).length);
+    });
+    print(res.join(' '), 'ok');
+}
+
+function testPages() {
+    var arr = [], i, sum = 0;
+
+    // Fill many pages, free every other object so pages become partially
+    // used, then free everything and allocate again.
+    for (i = 0; i < 20000; i++) {
+        arr.push({ v: i });
+    }
+    for (i = 0; i < 20000; i++) {
+        sum += arr[i].v;
+    }
+    print(arr.length, sum);
+    for (i = 0; i < 20000; i += 2) {
+        arr[i] = null;
+    }
+    arr = null;
+    Duktape.gc();
+
+    arr = [];
+    sum = 0;
+    for (i = 0; i < 5000; i++) {
+        arr.push([ i, 'str' + i ]);
+    }
+    for (i = 0; i < 5000; i++) {
+        sum += arr[i][0];
+    }
+    print(arr.length, sum);
+}
+
+try {
+    print('strings');
+    testStrings();
+    print('buffers');
+    testBuffers();
+    print('realloc');
+    testRealloc();
+    print('properties');
+    testProperties();
+    print('pages');
+    testPages();
+} catch (e) {
+    print(e.stack || e);
+}
+print('done');
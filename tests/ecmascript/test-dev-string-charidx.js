@@ -0,0 +1,97 @@
+/*
+ *  Char offset to byte offset conversion for long non-ASCII strings, which
+ *  use a sparse per-string index (DUK_USE_HSTRING_CHARIDX) in addition to
+ *  the heap-wide string cache.  Results are compared against a plain array
+ *  of the same characters, covering index step boundaries, the string end,
+ *  non-BMP characters (surrogate pairs) and interleaved access to more
+ *  strings than there are string cache entries.
+ */
+
+/*===
+build
+4096 true
+8191 true
+1024 true
+access
+true
+true
+true
+true
+methods
+true
+true
+true
+true
+===*/
+
+var chars = [ 'a', 'ä', '€', '\ud83d', '\ude00', 'z', '߿', 'ࠀ' ];
+
+function makeString(len, seed) {
+    var arr = [], i;
+    for (i = 0; i < len; i++) {
+        arr.push(chars[(i * 7 + seed + (i >> 5)) % chars.length]);
+    }
+    return { str: arr.join(''), arr: arr };
+}
+
+function checkAll(t) {
+    var i;
+    for (i = 0; i <= t.arr.length; i++) {
+        if (t.str.charAt(i) !== (i < t.arr.length ? t.arr[i] : '')) {
+            throw new Error('charAt mismatch at ' + i);
+        }
+    }
+    return true;
+}
+
+function checkRandom(list, count) {
+    var i, j, t, idx = 12345;
+    for (i = 0; i < count; i++) {
+        for (j = 0; j < list.length; j++) {
+            t = list[j];
+            idx = (idx * 1103515245 + 12345) & 0x7fffffff;
+            var k = idx % (t.arr.length + 1);
+            var c = t.str.charCodeAt(k);
+            var e = k < t.arr.length ? t.arr[k].charCodeAt(0) : NaN;
+            if (c !== e && !(c !== c && e !== e)) {
+                throw new Error('charCodeAt mismatch at ' + k);
+            }
+        }
+    }
+    return true;
+}
+
+var list = [];
+
+try {
+    print('build');
+    list.push(makeString(4096, 0));
+    list.push(makeString(8191, 1));
+    list.push(makeString(1024, 2));
+    for (var i = 3; i < 12; i++) {
+        list.push(makeString(1500 + i * 77, i));
+    }
+    print(list[0].str.length, list[0].str.length === list[0].arr.length);
+    print(list[1].str.length, list[1].str.length === list[1].arr.length);
+    print(list[2].str.length, list[2].str.length === list[2].arr.length);
+
+    print('access');
+    print(checkAll(list[0]));
+    print(checkAll(list[1]));
+    print(checkAll(list[2]));
+    print(checkRandom(list, 2000));
+
+    print('methods');
+    var t = list[1];
+    print(t.str.substring(63, 130) === t.arr.slice(63, 130).join(''));
+    print(t.str.slice(-65) === t.arr.slice(-65).join(''));
+    var sub = t.arr.slice(4000, 4010).join('');
+    var pos = t.str.indexOf(sub, 3990);
+    print(pos >= 3990 && pos <= 4000 && t.str.substr(pos, 10) === sub);
+    var re = /€/g;
+    re.lastIndex = 5000;
+    var m = re.exec(t.str);
+    print(m.index === t.arr.indexOf('€', 5000));
+} catch (e) {
+    print(e.stack || e);
+}
@@ -0,0 +1,281 @@
+/*
+ *  Long string concatenation results and other long strings are uninterned
+ *  strings, and concatenation results may be appended to in place
+ *  (DUK_USE_HSTRING_UNINTERNED).  None of this must be visible: values,
+ *  lengths, equality and property key behavior must be the same as for
+ *  interned strings.
+ */
+
+/*===
+build
+100000 true true
+2700 900 true
+self
+4096 true
+alias
+300 301 false true
+rhs
+307 true 300 true
+equality
+true true false true true
+case
+0 1 true
+keys
+1 1 true true
+true 1 true
+true false 0
+key-literal 2
+symbol true
+charidx
+2300 26 0 48 98 57
+closure
+1000 true
+global
+20000 true
+large
+true true true 1 1
+true 0 true
+ident 302
+ownkeys 1 true
+done
+===*/
+
+function repeat(s, n) {
+    var res = [];
+    var i;
+    for (i = 0; i < n; i++) {
+        res.push(s);
+    }
+    return res.join('');
+}
+
+function testBuild() {
+    var s = '';
+    var u = '';
+    var i;
+
+    for (i = 0; i < 100000; i++) {
+        s += 'x';
+    }
+    print(s.length, s === repeat('x', 100000), s.substring(50000, 50003) === 'xxx');
+
+    // Non-ASCII chunks keep the character length up to date.
+    for (i = 0; i < 900; i++) {
+        u += 'ä€' + String.fromCharCode(0x41 + (i % 26));
+    }
+    print(u.length, u.length / 3, u.charCodeAt(2699) === 0x41 + (899 % 26));
+}
+
+function testSelf() {
+    var s = repeat('ab', 150);
+    var i;
+
+    s += '';  // uninterned now
+    for (i = 0; i < 4; i++) {
+        s = s.substring(0, 256);
+        s += s;
+        s += s;
+        s += s;
+        s += s;
+    }
+    print(s.length, s === repeat('ab', 2048));
+}
+
+function testAlias() {
+    var s = repeat('y', 299);
+    var t;
+
+    s += 'z';
+    t = s;
+    s += 'w';
+    print(t.length, s.length, t === s, t === repeat('y', 299) + 'z');
+}
+
+function testRhs() {
+    var s = repeat('r', 300);
+    var t;
+    var u;
+    var i;
+
+    // Right side with code: the pre-op value of 's' must be used even
+    // when the right side reassigns 's' or keeps a copy of it.
+    s += '';
+    for (i = 0; i < 1000; i++) {
+        s += 'a' + (i & 0);
+    }
+    s = s.substring(0, 300);
+    s += '';
+    u = s;
+    s += (t = s, 'x' + 'y'.charAt(0));
+    s += (s = 'zz', 'q' + i);
+    print(s.length, s === repeat('r', 300) + 'xyq1000', t.length, t === u);
+}
+
+function testEquality() {
+    var a = '';
+    var b = repeat('q', 500);
+    var c;
+    var i;
+
+    for (i = 0; i < 500; i++) {
+        a += 'q';
+    }
+    c = a + 'r';
+    print(a === b, a == b, a === c, [ 1, b ].indexOf(a) === 1, Object.is(a, b));
+}
+
+function testCase() {
+    var a = '';
+    var i;
+    var res = [];
+
+    for (i = 0; i < 400; i++) {
+        a += 'k';
+    }
+    switch (a) {
+    case repeat('k', 399):
+        res.push(-1);
+        break;
+    case repeat('k', 400):
+        res.push(0);
+        break;
+    }
+    switch (a + 'x') {
+    case repeat('k', 400) + 'x':
+        res.push(1);
+        break;
+    }
+    res.push(a > repeat('k', 399));
+    print(res.join(' '));
+}
+
+function testKeys() {
+    var k = '';
+    var k2 = repeat('p', 300);
+    var o = {};
+    var o2 = {};
+    var desc;
+    var i;
+
+    for (i = 0; i < 300; i++) {
+        k += 'p';
+    }
+
+    o[k] = 1;
+    print(o[k2], Object.keys(o).length, k in o, o.hasOwnProperty(k2));
+
+    o[k2] = 1;  // same key, no duplicate
+    Object.defineProperty(o2, k, { value: 1, enumerable: true });
+    desc = Object.getOwnPropertyDescriptor(o2, k2);
+    print(desc.value === 1, Object.keys(o).length, Reflect.get(o2, k2) === 1);
+
+    print(delete o[k], k2 in o, Object.keys(o).length);
+
+    o = { [k + 'x']: 1, [k2 + 'x']: 2 };
+    print('key-literal', o[k2 + 'x']);
+
+    print('symbol', Symbol.for(k) === Symbol.for(k2));
+}
+
+function testCharidx() {
+    var s = '';
+    var i;
+    var res = [];
+
+    // Long non-ASCII string gets a char-to-byte index on random access;
+    // appending must invalidate it.
+    for (i = 0; i < 1100; i++) {
+        s += String.fromCharCode(0x100 + (i % 64));
+    }
+    res.push(s.charCodeAt(1050) - 0x100);
+    for (i = 0; i < 1200; i++) {
+        s += String.fromCharCode(0x30 + (i % 70));
+    }
+    res.unshift(s.length);
+    res.push(s.charCodeAt(1024) - 0x100);
+    res.push(s.charCodeAt(1100));
+    res.push(s.charCodeAt(2200));
+    res.push(s.charCodeAt(2299));
+    print(res.join(' '));
+}
+
+function testClosure() {
+    var s = '';
+    var i;
+    function add(x) {
+        s += x;
+    }
+
+    for (i = 0; i < 1000; i++) {
+        add('c');
+    }
+    print(s.length, s === repeat('c', 1000));
+}
+
+function testLarge() {
+    var body = repeat('{"k":"v"},', 100);
+    var bytes = new TextEncoder().encode(body);
+    var a = new TextDecoder().decode(bytes);
+    var b = String.fromCharCode.apply(null, Array.prototype.slice.call(bytes));
+    var c = repeat('{"k":"v"},', 50) + repeat('{"k":"v"},', 50);
+    var o = {};
+    var name;
+    var t;
+    var p;
+
+    // Strings decoded from buffers, equal contents from different sources.
+    print(a === body, b === body, c === a, JSON.parse('[' + a.slice(0, -1) + ']').length / 100,
+          a.indexOf('"v"') === 5 ? 1 : 0);
+
+    o[a] = 1;
+    o[b] = 2;
+    o[body.substring(0, 1000)] = 3;
+    print(o[c] === 3, Object.keys(o).length - 1, JSON.parse(JSON.stringify(o))[b] === 3);
+
+    // Long identifiers and string literals in source code.
+    name = repeat('v', 300);
+    print('ident', eval('var ' + name + ' = 2; ' + name + ' + 300'));
+
+    // Proxy ownKeys trap returning a long key, enumerability is checked
+    // from the target.
+    t = {};
+    t[repeat('x', 300)] = 1;
+    p = new Proxy(t, {
+        ownKeys: function () { return [ repeat('x', 100) + repeat('x', 200) ]; }
+    });
+    print('ownkeys', Object.keys(p).length, Object.keys(p)[0] === repeat('x', 300));
+}
+
+var g = '';
+var gi;
+
+try {
+    print('build');
+    testBuild();
+    print('self');
+    testSelf();
+    print('alias');
+    testAlias();
+    print('rhs');
+    testRhs();
+    print('equality');
+    testEquality();
+    print('case');
+    testCase();
+    print('keys');
+    testKeys();
+    print('charidx');
+    testCharidx();
+    print('closure');
+    testClosure();
+    print('global');
+    for (gi = 0; gi < 20000; gi++) {
+        g += 'g';
+    }
+    print(g.length, g === repeat('g', 20000));
+    print('large');
+    testLarge();
+} catch (e) {
+    print(e.stack || e);
+}
+print('done');
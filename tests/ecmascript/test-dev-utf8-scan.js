@@ -0,0 +1,123 @@
+/*
+ *  Codepoint counting and ASCII detection for interned strings, and UTF-8
+ *  decoding of buffers, use vectorized scanning when available (e.g.
+ *  DUK_USE_SIMD_SSE2).  Check results for non-ASCII bytes placed at every
+ *  offset around vector block boundaries, in strings of various lengths.
+ */
+
+/*===
+length
+true
+decode
+true
+true
+invalid
+true
+done
+===*/
+
+function asciiString(n) {
+    var res = [], i;
+    for (i = 0; i < n; i++) {
+        res.push(String.fromCharCode(0x20 + (i % 90)));
+    }
+    return res.join('');
+}
+
+function utf8Bytes(str) {
+    return new TextEncoder().encode(str);
+}
+
+// Insert 'ins' at position 'pos' of an ASCII string of length 'n' and check
+// the resulting length and contents against a value built independently.
+function testLength() {
+    var lengths = [ 0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 300, 4100, 9000 ];
+    var inserts = [ 'ä', '€', '😀', '߿ࠀ' ];
+    var ok = true;
+
+    lengths.forEach(function (n) {
+        var base = asciiString(n);
+        inserts.forEach(function (ins) {
+            var pos, s, arr;
+            for (pos = 0; pos <= n; pos += (n > 100 ? 37 : 1)) {
+                s = base.substring(0, pos) + ins + base.substring(pos);
+                if (s.length !== n + ins.length) {
+                    print('length mismatch', n, pos, s.length);
+                    ok = false;
+                }
+                if (s.charAt(pos) !== ins.charAt(0) || s.charAt(s.length - 1) !== (n > pos ? base.charAt(n - 1) : ins.charAt(ins.length - 1))) {
+                    print('content mismatch', n, pos);
+                    ok = false;
+                }
+            }
+        });
+        if (base.length !== n) {
+            print('ascii length mismatch', n);
+            ok = false;
+        }
+    });
+
+    // Long string made of 255+ vector blocks of continuation bytes, to
+    // exercise per-lane counter overflow handling.
+    var big = new Array(20001).join('€');
+    if (big.length !== 20000) {
+        print('big length mismatch', big.length);
+        ok = false;
+    }
+    print(ok);
+}
+
+function testDecode() {
+    var ok = true;
+    var dec = new TextDecoder();
+    var lengths = [ 0, 1, 15, 16, 17, 31, 32, 33, 64, 65, 1000 ];
+
+    lengths.forEach(function (n) {
+        var base = asciiString(n);
+        var pos, s, b;
+        for (pos = 0; pos <= n; pos += (n > 100 ? 13 : 1)) {
+            s = base.substring(0, pos) + 'ä😀x' + base.substring(pos);
+            b = utf8Bytes(s);
+            if (dec.decode(b) !== s) {
+                print('decode mismatch', n, pos);
+                ok = false;
+            }
+        }
+    });
+    print(ok);
+
+    // BOM handling: leading BOM is skipped unless preceded by ASCII.
+    var bom = new Uint8Array([ 0xef, 0xbb, 0xbf, 0x61, 0x62 ]);
+    var nobom = new Uint8Array([ 0x61, 0xef, 0xbb, 0xbf, 0x62 ]);
+    print(dec.decode(bom) === 'ab' && dec.decode(nobom) === 'a﻿b');
+}
+
+function testInvalid() {
+    var dec = new TextDecoder();
+    var arr = [], i;
+
+    // Invalid and truncated sequences around ASCII runs are replaced.
+    for (i = 0; i < 40; i++) {
+        arr.push(0x61);
+    }
+    arr.push(0xc3);  // truncated 2-byte sequence followed by ASCII
+    for (i = 0; i < 40; i++) {
+        arr.push(0x62);
+    }
+    arr.push(0xff);
+    arr.push(0xe2, 0x82);  // truncated at end
+    var res = dec.decode(new Uint8Array(arr));
+    print(res === new Array(41).join('a') + '�' + new Array(41).join('b') + '��');
+}
+
+try {
+    print('length');
+    testLength();
+    print('decode');
+    testDecode();
+    print('invalid');
+    testInvalid();
+} catch (e) {
+    print(e.stack || e);
+}
+print('done');
@@ -0,0 +1,25 @@
+/*
+ *  Allocation heavy code: short lived small objects, arrays, closures,
+ *  and strings, the typical case for the slab allocator.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var i;
+    var o, a, f, s;
+
+    for (i = 0; i < 2e6; i++) {
+        o = { x: i, y: i + 1 };
+        a = [ o, i ];
+        f = function () { return o; };
+        s = 'k' + (i & 0xff);
+    }
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
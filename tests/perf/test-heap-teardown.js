@@ -0,0 +1,26 @@
+/*
+ *  Build a large live object graph and leave it for heap destruction to
+ *  free, the typical shape of a short-lived per-request heap.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var root = [];
+    var i;
+
+    for (i = 0; i < 3e5; i++) {
+        root.push({ id: i, name: 'item-' + i, tags: [ i & 7, i & 15 ], next: null });
+    }
+    for (i = 1; i < root.length; i++) {
+        root[i - 1].next = root[i];
+    }
+    globalThis.root = root;
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
@@ -0,0 +1,30 @@
+/*
+ *  Create and read a large number of structurally identical records,
+ *  the typical case for shared object shapes.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var recs;
+    var i, j;
+    var ign;
+
+    for (i = 0; i < 20; i++) {
+        recs = [];
+        for (j = 0; j < 1e5; j++) {
+            recs.push({ id: j, name: 'foo', value: j * 2, flag: true, tag: null });
+        }
+        for (j = 0; j < 1e5; j++) {
+            ign = recs[j].value;
+            ign = recs[j].tag;
+        }
+    }
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
@@ -0,0 +1,36 @@
+/*
+ *  Property read performance when the same read site sees objects
+ *  with two different property layouts.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var obj1 = { xxx1: 1, xxx2: 2, xxx3: 3, xxx4: 4, foo: 123 };
+    var obj2 = { yyy1: 1, foo: 321 };
+    var objs = [ obj1, obj2 ];
+    var obj;
+    var i;
+    var ign;
+
+    for (i = 0; i < 1e7; i++) {
+        obj = objs[i & 1];
+        ign = obj.foo;
+        ign = obj.foo;
+        ign = obj.foo;
+        ign = obj.foo;
+        ign = obj.foo;
+        ign = obj.foo;
+        ign = obj.foo;
+        ign = obj.foo;
+        ign = obj.foo;
+        ign = obj.foo;
+    }
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
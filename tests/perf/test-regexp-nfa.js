@@ -0,0 +1,33 @@
+/*
+ *  Patterns with nested or overlapping quantifiers which fail to match,
+ *  exponential or polynomial for a plain backtracking matcher.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var words = [];
+    var text;
+    var i;
+    var count = 0;
+
+    for (i = 0; i < 3; i++) {
+        words.push('word' + i);
+    }
+    text = words.join(' ') + '!';
+
+    for (i = 0; i < 100; i++) {
+        count += /^(\w+\s?)*$/.test(text) ? 1 : 0;
+        count += /(a+)+b/.test('aaaaaaaaaaaaaaaa') ? 1 : 0;
+        count += /(x+x+)+y/.test('xxxxxxxxxxxxxx') ? 1 : 0;
+        count += /\s*#?\s*$/.test('#' + text.replace(/!/g, ' ').repeat(10) + '#x') ? 1 : 0;
+    }
+    print(count);
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
@@ -0,0 +1,43 @@
+/*
+ *  Search a large log text with simple unanchored patterns which fail at
+ *  most input offsets.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var lines = [];
+    var text;
+    var i;
+    var m;
+    var count;
+    var re;
+
+    for (i = 0; i < 20000; i++) {
+        lines.push('2024-01-01 12:00:' + (i % 60) + ' INFO request ' + i + ' served in ' + (i % 97) + 'ms');
+        if ((i % 1000) === 999) {
+            lines.push('2024-01-01 12:00:00 ERROR timeout in worker ' + i);
+        }
+    }
+    text = lines.join('\n');
+
+    for (i = 0; i < 10; i++) {
+        count = 0;
+        re = /ERROR (\w+)/g;
+        while ((m = re.exec(text)) !== null) {
+            count++;
+        }
+        count += /worker 19999/.test(text) ? 1 : 0;
+        count += /[#@]/.test(text) ? 1 : 0;
+        count += /^2024/.test(text) ? 1 : 0;
+        count += /warn|fatal/i.test(text) ? 1 : 0;
+    }
+    print(count);
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
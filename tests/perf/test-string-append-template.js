@@ -0,0 +1,45 @@
+/*
+ *  Build a large response string with '+=' in template rendering style:
+ *  many small literal and interpolated chunks appended to a local.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function render(rows) {
+    var out = '';
+    var i;
+    var row;
+
+    out += '<html><body><table>\n';
+    for (i = 0; i < rows.length; i++) {
+        row = rows[i];
+        out += '<tr class="' + (i & 1 ? 'odd' : 'even') + '">';
+        out += '<td>' + row.id + '</td>';
+        out += '<td>' + row.name + '</td>';
+        out += '<td>' + row.value + '</td>';
+        out += '</tr>\n';
+    }
+    out += '</table></body></html>\n';
+    return out;
+}
+
+function test() {
+    var rows = [];
+    var i;
+    var res;
+
+    for (i = 0; i < 5000; i++) {
+        rows.push({ id: i, name: 'item-' + i, value: (i * 7) % 1000 });
+    }
+    for (i = 0; i < 20; i++) {
+        res = render(rows);
+    }
+    print(res.length);
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
@@ -0,0 +1,37 @@
+/*
+ *  Random access into several long non-ASCII strings at once.  With only
+ *  the heap-wide string cache each access scans a large part of the string.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var strs = [];
+    var i, j, n, str, idx, sum;
+
+    for (i = 0; i < 8; i++) {
+        str = 'ä' + String.fromCharCode(0x1000 + i) + 'abc';
+        while (str.length < 65536) {
+            str = str + str;
+        }
+        strs.push(str);
+    }
+    n = strs[0].length;
+
+    sum = 0;
+    idx = 1;
+    for (i = 0; i < 2e5; i++) {
+        idx = (idx * 1103515245 + 12345) & 0x7fffffff;
+        for (j = 0; j < strs.length; j++) {
+            sum += strs[j].charCodeAt((idx + j * 7919) % n);
+        }
+    }
+    print(sum);
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
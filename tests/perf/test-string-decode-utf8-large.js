@@ -0,0 +1,35 @@
+/*
+ *  Decode large, mostly ASCII UTF-8 buffers into strings and compute their
+ *  length, as when interning network data.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var parts = [];
+    var i, buf, str, dec, n;
+
+    for (i = 0; i < 20000; i++) {
+        parts.push('{"id":' + i + ',"name":"item ' + i + '","tag":"' + (i % 10 === 0 ? 'päivää €' : 'plain') + '"}');
+    }
+    buf = new TextEncoder().encode(parts.join('\n'));
+    print(buf.length);
+
+    dec = new TextDecoder();
+    n = 0;
+    for (i = 0; i < 2000; i++) {
+        // Vary the input slightly so the result isn't found in the string
+        // table and needs to be interned again.
+        buf[0] = 0x20 + (i % 64);
+        str = dec.decode(buf);
+        n += str.length;
+    }
+    print(n);
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
@@ -0,0 +1,31 @@
+/*
+ *  Decode a large request body from a buffer over and over, as when
+ *  passing HTTP payloads through a script.
+ */
+
+if (typeof print !== 'function') { print = console.log; }
+
+function test() {
+    var buf = new Uint8Array(1024 * 1024);
+    var dec = new TextDecoder();
+    var i;
+    var s;
+    var total = 0;
+
+    for (i = 0; i < buf.length; i++) {
+        buf[i] = 0x61 + (i % 26);
+    }
+    for (i = 0; i < 500; i++) {
+        buf[i] = 0x41 + (i % 26);  // different content each round
+        s = dec.decode(buf);
+        total += s.length;
+    }
+    print(total);
+}
+
+try {
+    test();
+} catch (e) {
+    print(e.stack || e);
+    throw e;
+}
@@ -392,6 +392,7 @@ def main():
         'duk_api_memory.c',
         'duk_api_object.c',
         'duk_api_random.c',
+        'duk_api_snapshot.c',
         'duk_api_string.c',
         'duk_api_time.c',
         'duk_api_debug.c',
@@ -447,6 +448,7 @@ def main():
         'duk_hbufobj_misc.c',
         'duk_hcompfunc.h',
         'duk_heap_alloc.c',
+        'duk_heap_arena.c',
         'duk_heap.h',
         'duk_heap_hashstring.c',
         'duk_heaphdr.h',
@@ -456,6 +458,7 @@ def main():
         'duk_heap_memory.c',
         'duk_heap_misc.c',
         'duk_heap_refcount.c',
+        'duk_heap_slab.c',
         'duk_heap_stringcache.c',
         'duk_heap_stringtable.c',
         'duk_hnatfunc.h',
@@ -468,6 +471,8 @@ def main():
         'duk_hobject_pc2line.c',
         'duk_hobject_props.c',
         'duk_hproxy.h',
+        'duk_hshape.c',
+        'duk_hshape.h',
         'duk_hstring.h',
         'duk_hstring_assert.c',
         'duk_hstring_misc.c',